@@ -91,6 +91,25 @@ public:
         return standAlone_;
     }
 
+    /**
+     * Creates a key which identifies the source code generated for the
+     * models which use this atomic function (e.g. it should depend on its
+     * sparsity patterns).
+     * It is used by ModelCSourceGen::getFingerprint() to find previously
+     * compiled models in the compiler cache.
+     *
+     * @warning The default implementation returns an empty key and the
+     *          atomic function is only identified by its name.
+     *          An atomic function whose behaviour changes must then be
+     *          renamed, otherwise outdated object files and libraries can
+     *          be reused from the compiler cache.
+     *
+     * @return the key (empty if not available)
+     */
+    virtual std::string getFingerprint() {
+        return std::string();
+    }
+
     bool forward(size_t q,
                  size_t p,
                  const CppAD::vector<bool>& vx,
@@ -31,69 +31,62 @@ template<class Base>
 class Argument {
 private:
     OperationNode<Base>* operation_;
-    std::unique_ptr<Base> parameter_;
+    /**
+     * The constant value (only meaningful when hasParameter_ is true).
+     * It is stored inline (instead of in the heap) since arguments are
+     * created and copied for every operation node.
+     */
+    Base parameter_;
+    /**
+     * Whether or not this argument is a constant value
+     */
+    bool hasParameter_;
 public:
 
     inline Argument() :
-        operation_(nullptr) {
+        operation_(nullptr),
+        parameter_(),
+        hasParameter_(false) {
     }
 
     inline Argument(OperationNode<Base>& operation) :
-        operation_(&operation) {
+        operation_(&operation),
+        parameter_(),
+        hasParameter_(false) {
     }
 
     inline Argument(const Base& parameter) :
         operation_(nullptr),
-        parameter_(new Base(parameter)) {
-    }
-
-    inline Argument(const Argument& orig) :
-        operation_(orig.operation_),
-        parameter_(orig.parameter_ != nullptr ? new Base(*orig.parameter_) : nullptr) {
-    }
-
-    inline Argument(Argument&& orig) :
-            operation_(orig.operation_),
-            parameter_(std::move(orig.parameter_)) {
+        parameter_(parameter),
+        hasParameter_(true) {
     }
 
-    inline Argument& operator=(const Argument& rhs) {
-        if (&rhs == this) {
-            return *this;
-        }
-        if (rhs.operation_ != nullptr) {
-            operation_ = rhs.operation_;
-            parameter_.reset();
-        } else {
-            operation_ = nullptr;
-            if (parameter_ != nullptr) {
-                *parameter_ = *rhs.parameter_;
-            } else {
-                parameter_.reset(new Base(*rhs.parameter_)); // to replace with parameter_ = std::make_unique once c++14 is used
-            }
-        }
-        return *this;
-    }
-
-    inline Argument& operator=(Argument&& rhs) {
-        assert(this != &rhs);
+    inline Argument(const Argument& orig) = default;
 
-        operation_ = rhs.operation_;
+    inline Argument(Argument&& orig) = default;
 
-        // steal the parameter
-        parameter_ = std::move(rhs.parameter_);
+    inline Argument& operator=(const Argument& rhs) = default;
 
-        return *this;
-    }
+    inline Argument& operator=(Argument&& rhs) = default;
 
-    virtual ~Argument() = default;
+    ~Argument() = default;
 
     inline OperationNode<Base>* getOperation() const {
         return operation_;
     }
 
-    inline Base* getParameter() const {
-        return parameter_.get();
+    /**
+     * @return the constant value or null if this argument is not a constant
+     */
+    inline const Base* getParameter() const {
+        return hasParameter_ ? &parameter_ : nullptr;
+    }
+
+    /**
+     * @return the constant value or null if this argument is not a constant
+     */
+    inline Base* getParameter() {
+        return hasParameter_ ? &parameter_ : nullptr;
     }
 
 };
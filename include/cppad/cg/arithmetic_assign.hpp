@@ -21,7 +21,7 @@ namespace cg {
 template<class Base>
 inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ += *right.value_;
+        value_ += right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -45,12 +45,13 @@ inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
-        if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() + right.getValue()));
+        Base value(0.0);
+        bool valueDefined = isValueDefined() && right.isValueDefined();
+        if (valueDefined) {
+            value = getValue() + right.getValue();
         }
 
-        makeVariable(*handler->makeNode(CGOpCode::Add,{argument(), right.argument()}), value);
+        makeVariable(*handler->makeNode(CGOpCode::Add,{argument(), right.argument()}), valueDefined ? &value : nullptr);
     }
 
     return *this;
@@ -59,7 +60,7 @@ inline CG<Base>& CG<Base>::operator+=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ -= *right.value_;
+        value_ -= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -78,12 +79,13 @@ inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
-        if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() - right.getValue()));
+        Base value(0.0);
+        bool valueDefined = isValueDefined() && right.isValueDefined();
+        if (valueDefined) {
+            value = getValue() - right.getValue();
         }
 
-        makeVariable(*handler->makeNode(CGOpCode::Sub,{argument(), right.argument()}), value);
+        makeVariable(*handler->makeNode(CGOpCode::Sub,{argument(), right.argument()}), valueDefined ? &value : nullptr);
     }
 
     return *this;
@@ -92,7 +94,7 @@ inline CG<Base>& CG<Base>::operator-=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ *= *right.value_;
+        value_ *= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -121,12 +123,13 @@ inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
-        if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() * right.getValue()));
+        Base value(0.0);
+        bool valueDefined = isValueDefined() && right.isValueDefined();
+        if (valueDefined) {
+            value = getValue() * right.getValue();
         }
 
-        makeVariable(*handler->makeNode(CGOpCode::Mul,{argument(), right.argument()}), value);
+        makeVariable(*handler->makeNode(CGOpCode::Mul,{argument(), right.argument()}), valueDefined ? &value : nullptr);
     }
 
     return *this;
@@ -135,7 +138,7 @@ inline CG<Base>& CG<Base>::operator*=(const CG<Base> &right) {
 template<class Base>
 inline CG<Base>& CG<Base>::operator/=(const CG<Base> &right) {
     if (isParameter() && right.isParameter()) {
-        *value_ /= *right.value_;
+        value_ /= right.value_;
 
     } else {
         CodeHandler<Base>* handler;
@@ -158,12 +161,13 @@ inline CG<Base>& CG<Base>::operator/=(const CG<Base> &right) {
             handler = node_->getCodeHandler();
         }
 
-        std::unique_ptr<Base> value;
-        if (isValueDefined() && right.isValueDefined()) {
-            value.reset(new Base(getValue() / right.getValue()));
+        Base value(0.0);
+        bool valueDefined = isValueDefined() && right.isValueDefined();
+        if (valueDefined) {
+            value = getValue() / right.getValue();
         }
 
-        makeVariable(*handler->makeNode(CGOpCode::Div,{argument(), right.argument()}), value);
+        makeVariable(*handler->makeNode(CGOpCode::Div,{argument(), right.argument()}), valueDefined ? &value : nullptr);
     }
 
     return *this;
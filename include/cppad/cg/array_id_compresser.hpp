@@ -102,7 +102,7 @@ public:
             return 0; // nothing to do (no space required)
 
         std::set<size_t> blackList;
-        const std::vector<Argument<Base> >& args = newArray.getArguments();
+        const ArenaVector<Argument<Base> >& args = newArray.getArguments();
         for (size_t i = 0; i < args.size(); i++) {
             const OperationNode<Base>* argOp = args[i].getOperation();
             if (argOp != nullptr && argOp->getOperationType() == CGOpCode::ArrayElement) {
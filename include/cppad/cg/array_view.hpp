@@ -78,7 +78,8 @@ public:
      *
      * @param vector the vector to wrap
      */
-    inline ArrayView(std::vector<value_type>& vector) :
+    template<class Alloc>
+    inline ArrayView(std::vector<value_type, Alloc>& vector) :
             _data(vector.data()),
             _length(vector.size()) {
     }
@@ -138,8 +139,8 @@ public:
      *
      * @param vector the vector to wrap with a non-const data type
      */
-    template<class TT = Type>
-    inline ArrayView(const std::vector<typename std::remove_const<value_type>::type>& vector,
+    template<class Alloc, class TT = Type>
+    inline ArrayView(const std::vector<typename std::remove_const<value_type>::type, Alloc>& vector,
                      typename std::enable_if<std::is_const<TT>::value>::type* = 0) :
             _data(vector.data()),
             _length(vector.size()) {
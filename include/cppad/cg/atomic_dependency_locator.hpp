@@ -111,7 +111,7 @@ private:
         handler_.markVisited(*node);
 
         std::set<size_t> indeps;
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         for (size_t a = 0; a < args.size(); a++) {
             std::set<size_t> aindeps = findAtomicsUsage(args[a].getOperation());
             indeps.insert(aindeps.begin(), aindeps.end());
@@ -25,6 +25,10 @@ namespace cg {
  * This class can be useful when a CppAD::ADFun<CppAD::cg::CG> is going to
  * be used to create a compiled model library but has not been compiled yet.
  *
+ * It can be evaluated by several threads while CppAD is in parallel mode
+ * (e.g. see ModelCSourceGen::setSourceGenerationThreadNumber()): each
+ * thread then evaluates its own copy of the wrapped ADFun.
+ *
  * @author Joao Leal
  */
 template <class Base>
@@ -38,6 +42,15 @@ protected:
     CustomPosition custom_jac_;
     CustomPosition custom_hess_;
     std::map<size_t, CppAD::vector<std::set<size_t> > > hess_;
+    /**
+     * copies of fun_ used by each CppAD thread in parallel mode
+     */
+    std::vector<std::unique_ptr<ADFun<CGB> > > threadFun_;
+    std::atomic<bool> hasThreadFun_;
+    /**
+     * protects the cached sparsities
+     */
+    std::mutex mutex_;
 public:
 
     /**
@@ -58,7 +71,9 @@ public:
                       bool cacheSparsities = true) :
         CGAbstractAtomicFun<Base>(name, standAlone),
         fun_(fun),
-        cacheSparsities_(cacheSparsities) {
+        cacheSparsities_(cacheSparsities),
+        threadFun_(CPPAD_MAX_NUM_THREADS),
+        hasThreadFun_(false) {
         this->option(CppAD::atomic_base<CGB>::set_sparsity_enum);
     }
 
@@ -96,6 +111,46 @@ public:
         custom_hess_ = CustomPosition(n, n, elements);
     }
 
+    /**
+     * Creates a key from the dimensions and the (custom) sparsity patterns
+     * of the wrapped model.
+     */
+    std::string getFingerprint() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ADFun<CGB>& fun = getFun();
+
+        std::vector<std::set<size_t> > jac;
+        if (custom_jac_.isFullDefined()) {
+            jac = custom_jac_.getFullElements();
+        } else {
+            jac = jacobianSparsitySet<std::vector<std::set<size_t> > >(fun);
+            custom_jac_.filter(jac);
+        }
+
+        std::vector<std::set<size_t> > hess;
+        if (custom_hess_.isFullDefined()) {
+            hess = custom_hess_.getFullElements();
+        } else {
+            hess = hessianSparsitySet<std::vector<std::set<size_t> > >(fun);
+            custom_hess_.filter(hess);
+        }
+
+        ContentHash h;
+        h.add(fun.Domain());
+        h.add(fun.Range());
+        h.add(this->standAlone_);
+        for (const auto* sparsity : {&jac, &hess}) {
+            h.add(sparsity->size());
+            for (const std::set<size_t>& row : *sparsity) {
+                h.add(row.size());
+                for (size_t j : row)
+                    h.add(j);
+            }
+        }
+
+        return h.str();
+    }
+
     bool for_sparse_jac(size_t q,
                         const CppAD::vector<std::set<size_t> >& r,
                         CppAD::vector<std::set<size_t> >& s,
@@ -108,12 +163,15 @@ public:
                         CppAD::vector<std::set<size_t> >& s) override {
         using CppAD::vector;
 
+        std::lock_guard<std::mutex> lock(mutex_);
+        ADFun<CGB>& fun = getFun();
+
         if (cacheSparsities_ || custom_jac_.isFilterDefined()) {
-            size_t n = fun_.Domain();
-            size_t m = fun_.Range();
+            size_t n = fun.Domain();
+            size_t m = fun.Range();
             if (!custom_jac_.isFullDefined()) {
-                custom_jac_.setFullElements(jacobianForwardSparsitySet<std::vector<std::set<size_t> > >(fun_));
-                fun_.size_forward_set(0);
+                custom_jac_.setFullElements(jacobianForwardSparsitySet<std::vector<std::set<size_t> > >(fun));
+                fun.size_forward_set(0);
             }
 
             for (size_t i = 0; i < s.size(); i++) {
@@ -121,8 +179,8 @@ public:
             }
             CppAD::cg::multMatrixMatrixSparsity(custom_jac_.getFullElements(), r, s, m, n, q);
         } else {
-            s = fun_.ForSparseJac(q, r);
-            fun_.size_forward_set(0);
+            s = fun.ForSparseJac(q, r);
+            fun.size_forward_set(0);
         }
 
         return true;
@@ -140,11 +198,14 @@ public:
                         CppAD::vector<std::set<size_t> >& st) override {
         using CppAD::vector;
 
+        std::lock_guard<std::mutex> lock(mutex_);
+        ADFun<CGB>& fun = getFun();
+
         if (cacheSparsities_ || custom_jac_.isFilterDefined()) {
-            size_t n = fun_.Domain();
-            size_t m = fun_.Range();
+            size_t n = fun.Domain();
+            size_t m = fun.Range();
             if (!custom_jac_.isFullDefined()) {
-                custom_jac_.setFullElements(jacobianReverseSparsitySet<std::vector<std::set<size_t> > >(fun_));
+                custom_jac_.setFullElements(jacobianReverseSparsitySet<std::vector<std::set<size_t> > >(fun));
             }
 
             for (size_t i = 0; i < st.size(); i++) {
@@ -152,7 +213,7 @@ public:
             }
             CppAD::cg::multMatrixMatrixSparsityTrans(rt, custom_jac_.getFullElements(), st, m, n, q);
         } else {
-            st = fun_.RevSparseJac(q, rt, true);
+            st = fun.RevSparseJac(q, rt, true);
         }
 
         return true;
@@ -178,16 +239,19 @@ public:
                         CppAD::vector<std::set<size_t> >& v) override {
         using CppAD::vector;
 
+        std::lock_guard<std::mutex> lock(mutex_);
+        ADFun<CGB>& fun = getFun();
+
         if (cacheSparsities_ || custom_jac_.isFilterDefined() || custom_hess_.isFilterDefined()) {
-            size_t n = fun_.Domain();
-            size_t m = fun_.Range();
+            size_t n = fun.Domain();
+            size_t m = fun.Range();
 
             for (size_t i = 0; i < n; i++) {
                 v[i].clear();
             }
 
             if (!custom_jac_.isFullDefined()) {
-                custom_jac_.setFullElements(jacobianSparsitySet<std::vector<std::set<size_t> > >(fun_));
+                custom_jac_.setFullElements(jacobianSparsitySet<std::vector<std::set<size_t> > >(fun));
             }
             const std::vector<std::set<size_t> >& jacSparsity = custom_jac_.getFullElements();
 
@@ -208,7 +272,7 @@ public:
 
             if (allSelected) {
                 if (!custom_hess_.isFullDefined()) {
-                    custom_hess_.setFullElements(hessianSparsitySet<std::vector<std::set<size_t> > >(fun_)); // f''(x)
+                    custom_hess_.setFullElements(hessianSparsitySet<std::vector<std::set<size_t> > >(fun)); // f''(x)
                 }
                 const std::vector<std::set<size_t> >& sF2 = custom_hess_.getFullElements();
                 CppAD::cg::multMatrixTransMatrixSparsity(sF2, r, v, n, n, q); // f''^T * R
@@ -219,7 +283,7 @@ public:
                         const auto itH = hess_.find(i);
                         const vector<std::set<size_t> >* spari;
                         if (itH == hess_.end()) {
-                            vector<std::set<size_t> >& hi = hess_[i] = hessianSparsitySet<vector<std::set<size_t> > >(fun_, i); // f''_i(x)
+                            vector<std::set<size_t> >& hi = hess_[i] = hessianSparsitySet<vector<std::set<size_t> > >(fun, i); // f''_i(x)
                             spari = &hi;
                             custom_hess_.filter(hi);
                         } else {
@@ -242,11 +306,11 @@ public:
                 }
             }
         } else {
-            size_t m = fun_.Range();
-            size_t n = fun_.Domain();
+            size_t m = fun.Range();
+            size_t n = fun.Domain();
 
-            t = fun_.RevSparseJac(1, s);
-            vector<std::set<size_t> > a = fun_.RevSparseJac(q, u, true);
+            t = fun.RevSparseJac(1, s);
+            vector<std::set<size_t> > a = fun.RevSparseJac(q, u, true);
 
             // set version of s
             vector<std::set<size_t> > set_s(1);
@@ -255,8 +319,8 @@ public:
                     set_s[0].insert(i);
             }
 
-            fun_.ForSparseJac(q, r);
-            v = fun_.RevSparseHes(q, set_s, true);
+            fun.ForSparseJac(q, r);
+            v = fun.RevSparseHes(q, set_s, true);
 
             for (size_t i = 0; i < n; i++) {
                 for (size_t j : a[i]) {
@@ -265,7 +329,7 @@ public:
                 }
             }
 
-            fun_.size_forward_set(0);
+            fun.size_forward_set(0);
         }
 
         return true;
@@ -276,7 +340,8 @@ protected:
     void zeroOrderDependency(const CppAD::vector<bool>& vx,
                              CppAD::vector<bool>& vy,
                              const CppAD::vector<CGB>& x) override {
-        CppAD::cg::zeroOrderDependency(fun_, vx, vy);
+        std::lock_guard<std::mutex> lock(mutex_);
+        CppAD::cg::zeroOrderDependency(getFun(), vx, vy);
     }
 
     bool atomicForward(size_t q,
@@ -285,13 +350,15 @@ protected:
                        CppAD::vector<Base>& ty) override {
         using CppAD::vector;
 
+        ADFun<CGB>& fun = getFun();
+
         vector<CGB> txcg(tx.size());
         toCG(tx, txcg);
 
-        vector<CGB> tycg = fun_.Forward(p, txcg);
+        vector<CGB> tycg = fun.Forward(p, txcg);
         fromCG(tycg, ty);
 
-        fun_.capacity_order(0);
+        fun.capacity_order(0);
 
         return true;
     }
@@ -306,18 +373,49 @@ protected:
         vector<CGB> txcg(tx.size());
         vector<CGB> pycg(py.size());
 
+        ADFun<CGB>& fun = getFun();
+
         toCG(tx, txcg);
         toCG(py, pycg);
 
-        fun_.Forward(p, txcg);
+        fun.Forward(p, txcg);
 
-        vector<CGB> pxcg = fun_.Reverse(p + 1, pycg);
+        vector<CGB> pxcg = fun.Reverse(p + 1, pycg);
         fromCG(pxcg, px);
 
-        fun_.capacity_order(0);
+        fun.capacity_order(0);
         return true;
     }
 
+    /**
+     * Provides the ADFun to be used by the current thread.
+     * The original ADFun must not be evaluated by several threads
+     * simultaneously, and its memory can only be released by the thread
+     * which allocated it while CppAD is in parallel mode.
+     */
+    inline ADFun<CGB>& getFun() {
+        if (!thread_alloc::in_parallel()) {
+            if (hasThreadFun_) {
+                // copies created in a previous parallel section might be outdated
+                for (auto& f : threadFun_)
+                    f.reset();
+                hasThreadFun_ = false;
+            }
+            return fun_;
+        }
+
+        size_t thread = thread_alloc::thread_num();
+        CPPADCG_ASSERT_KNOWN(thread < threadFun_.size(), "Invalid CppAD thread number")
+
+        std::unique_ptr<ADFun<CGB> >& f = threadFun_[thread];
+        if (f == nullptr) {
+            f.reset(new ADFun<CGB>());
+            *f = fun_; // fun_ is not modified while in parallel mode
+            hasThreadFun_ = true;
+        }
+        return *f;
+    }
+
 private:
 
     static void toCG(const CppAD::vector<Base>& from,
@@ -36,8 +36,15 @@ private:
     /**
      * A constant value which must be defined for parameters.
      * Its definition is optional for variables.
+     * It is stored inline (instead of in the heap) since these objects are
+     * constantly created and copied while taping; it is only meaningful
+     * when valueDefined_ is true.
      */
-    std::unique_ptr<Base> value_;
+    Base value_;
+    /**
+     * Whether or not value_ is defined.
+     */
+    bool valueDefined_;
 
 public:
     /**
@@ -178,7 +185,7 @@ protected:
     inline void makeVariable(OperationNode<Base>& operation);
 
     inline void makeVariable(OperationNode<Base>& operation,
-                             std::unique_ptr<Base>& value);
+                             const Base* value);
 
     // creating an argument out of this node
     inline Argument<Base> argument() const;
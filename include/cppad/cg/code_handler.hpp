@@ -27,6 +27,7 @@ namespace cg {
 template<class Base>
 class CodeHandler {
     friend class CodeHandlerVectorSync<Base>;
+    friend class OperationNode<Base>;
 public:
     using PathNode = OperationPathNode<Base>;
     using SourceCodePath = std::vector<PathNode>;
@@ -141,6 +142,17 @@ protected:
     bool _used;
     // a flag indicating whether or not to reuse the IDs of destroyed variables
     bool _reuseIDs;
+    // a flag indicating whether or not to reuse nodes for identical operations
+    bool _reuseIdenticalNodes;
+    // a flag indicating whether or not to reorder operations to reduce the number of live temporary variables
+    bool _minimizeLiveVariables;
+    // the highest number of temporary variables alive at the same time in the last generated source
+    size_t _maxLiveTemporaries;
+    /**
+     * nodes created with makeNode() which can be returned again for
+     * identical operations (indexed by a structural hash)
+     */
+    std::unordered_multimap<size_t, Node*> _identicalNodes;
     // scope color/index counter
     ScopeIDType _scopeColorCount;
     // the current scope color/index counter
@@ -172,6 +184,15 @@ protected:
      * Auxiliary index (might not be used)
      */
     IndexOperationNode<Base>* _auxIterationIndexOp;
+    /**
+     * provides the memory for the operation nodes created by this handler
+     * (released all at once when the handler is reset)
+     */
+    MemoryArena _nodeArena;
+    /**
+     * whether or not new operation nodes are placed in the memory arena
+     */
+    bool _useNodeArena;
 public:
 
     CodeHandler(size_t varCount = 50);
@@ -197,6 +218,75 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not makeNode() should return a previously created
+     * node when a new operation is identical to it (same operation type,
+     * information, and arguments), also known as hash-consing.
+     * Arguments of additions and multiplications are compared regardless
+     * of their order.
+     * This eliminates common subexpressions while the operation graph is
+     * created, which reduces the memory used by the graph and the size of
+     * the generated source code.
+     * Only mathematical operations without side effects are reused.
+     * It is disabled by default.
+     *
+     * @param reuse whether or not to reuse identical nodes
+     */
+    inline void setReuseIdenticalNodes(bool reuse);
+
+    /**
+     * Whether or not makeNode() returns previously created nodes for
+     * identical operations.
+     */
+    inline bool isReuseIdenticalNodes() const;
+
+    /**
+     * Defines whether or not to reorder the evaluation of independent
+     * subexpressions in order to reduce the number of temporary variables
+     * alive at the same time (Sethi-Ullman ordering).
+     * Operations are only moved within blocks without scope changes,
+     * atomic functions, or other operations with side effects.
+     * It is only used when variable IDs are reused and it is disabled by
+     * default.
+     *
+     * @param minimize whether or not to reorder operations
+     */
+    inline void setMinimizeLiveVariables(bool minimize);
+
+    /**
+     * Whether or not operations are reordered to reduce the number of
+     * temporary variables alive at the same time.
+     */
+    inline bool isMinimizeLiveVariables() const;
+
+    /**
+     * Defines whether or not the operation nodes created by this handler
+     * (including their arguments and information arrays) are placed in a
+     * memory arena owned by the handler instead of being individually
+     * allocated in the heap.
+     * The arena reduces the number of memory allocations, the memory
+     * overhead of each node, and the time required to reset/destroy large
+     * operation graphs; however, the memory of deleted nodes is only
+     * released when the handler is reset or destroyed.
+     * It only affects nodes created afterwards and it is enabled by
+     * default.
+     *
+     * @param useArena whether or not to use the memory arena
+     */
+    inline void setUseNodeArena(bool useArena);
+
+    /**
+     * Whether or not new operation nodes are placed in a memory arena
+     * owned by this handler.
+     */
+    inline bool isUseNodeArena() const;
+
+    /**
+     * Provides the number of bytes currently reserved by the memory arena
+     * used for operation nodes.
+     */
+    inline size_t getNodeArenaCapacity() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -419,6 +509,13 @@ public:
 
     size_t getTemporaryVariableCount() const;
 
+    /**
+     * Provides the highest number of temporary variables (excluding arrays)
+     * alive at the same time in the last generated source code.
+     * It is only determined when variable IDs are reused.
+     */
+    size_t getMaxLiveTemporaryVariables() const;
+
     size_t getTemporaryArraySize() const;
 
     size_t getTemporarySparseArraySize() const;
@@ -453,6 +550,9 @@ public:
     inline Node* makeNode(CGOpCode op,
                           const Arg& arg);
 
+    inline Node* makeNode(CGOpCode op,
+                          std::initializer_list<Arg> args);
+
     inline Node* makeNode(CGOpCode op,
                           std::vector<Arg>&& args);
 
@@ -464,6 +564,15 @@ public:
                           const std::vector<size_t>& info,
                           const std::vector<Arg>& args);
 
+    /**
+     * Creates a node using the information and/or the arguments of other
+     * operation nodes.
+     */
+    template<class InfoAlloc, class ArgAlloc>
+    inline Node* makeNode(CGOpCode op,
+                          const std::vector<size_t, InfoAlloc>& info,
+                          const std::vector<Arg, ArgAlloc>& args);
+
     inline LoopStartOperationNode<Base>* makeLoopStartNode(Node& indexDcl,
                                                            size_t iterationCount);
 
@@ -618,6 +727,62 @@ protected:
 
     virtual Node* manageOperationNode(Node* code);
 
+    /**
+     * Creates a new operation node (not yet managed by this handler) either
+     * in the memory arena or in the heap.
+     */
+    template<class T, class... Args>
+    inline T* createNode(Args&&... args);
+
+    /**
+     * Destroys an operation node created by createNode() or provided to
+     * manageOperationNodeMemory().
+     */
+    inline void deleteNode(Node* n);
+
+    /**
+     * Provides the memory arena for the information and arguments of new
+     * operation nodes.
+     *
+     * @return the memory arena or null if nodes are not placed in the arena
+     */
+    inline MemoryArena* getNodeArena();
+
+    /**
+     * Determines whether or not an operation type can be represented by
+     * the same node for identical arguments.
+     */
+    static inline bool isReusableOperation(CGOpCode op);
+
+    static inline size_t hashOperation(CGOpCode op,
+                                       ArrayView<const size_t> info,
+                                       ArrayView<const Arg> args);
+
+    /**
+     * Determines whether or not two parameters have the same
+     * representation (not only the same value).
+     */
+    static inline bool isIdenticalParameter(const Base& p1,
+                                            const Base& p2);
+
+    static inline bool compareParameterBits(const Base& p1,
+                                            const Base& p2,
+                                            std::true_type);
+
+    static inline bool compareParameterBits(const Base& p1,
+                                            const Base& p2,
+                                            std::false_type);
+
+    /**
+     * Searches for a previously created node for an identical operation.
+     *
+     * @return the identical node or null if there is none
+     */
+    inline Node* findIdenticalNode(size_t hash,
+                                   CGOpCode op,
+                                   ArrayView<const size_t> info,
+                                   ArrayView<const Arg> args) const;
+
     inline void addVector(CodeHandlerVectorSync<Base>* v);
 
     inline void removeVector(CodeHandlerVectorSync<Base>* v);
@@ -697,6 +862,26 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Reorders the evaluation queue inside blocks of mathematical
+     * operations so that the subexpressions requiring more temporary
+     * variables are evaluated first (Sethi-Ullman ordering).
+     */
+    inline void scheduleOperations();
+
+    /**
+     * Reorders the operations in the evaluation queue between the
+     * positions begin (inclusive) and end (exclusive).
+     */
+    inline void scheduleOperations(size_t begin,
+                                   size_t end);
+
+    /**
+     * Whether or not an operation in the evaluation queue can change its
+     * location (only mathematical operations without side effects).
+     */
+    inline static bool isSchedulable(const Node& node);
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -38,13 +38,17 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _atomicFunctionsOrder(nullptr),
         _used(false),
         _reuseIDs(true),
+        _reuseIdenticalNodes(false),
+        _minimizeLiveVariables(false),
+        _maxLiveTemporaries(0),
         _scopeColorCount(0),
         _currentScopeColor(0),
         _lang(nullptr),
         _minTemporaryVarID(0),
         _zeroDependents(false),
         _verbose(false),
-        _jobTimer(nullptr) {
+        _jobTimer(nullptr),
+        _useNodeArena(true) {
     _codeBlocks.reserve(varCount);
     //_variableOrder.reserve(1 + varCount / 3);
     _scopedVariableOrder[0].reserve(1 + varCount / 3);
@@ -72,6 +76,43 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setReuseIdenticalNodes(bool reuse) {
+    _reuseIdenticalNodes = reuse;
+    if (!reuse)
+        _identicalNodes.clear();
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isReuseIdenticalNodes() const {
+    return _reuseIdenticalNodes;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setMinimizeLiveVariables(bool minimize) {
+    _minimizeLiveVariables = minimize;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isMinimizeLiveVariables() const {
+    return _minimizeLiveVariables;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setUseNodeArena(bool useArena) {
+    _useNodeArena = useArena;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isUseNodeArena() const {
+    return _useNodeArena;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::getNodeArenaCapacity() const {
+    return _nodeArena.getCapacity();
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -285,6 +326,7 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     _idArrayCount = 1;
     _idSparseArrayCount = 1;
     _idAtomicCount = 1;
+    _maxLiveTemporaries = 0;
     _dependents = &dependent;
     _atomicFunctionsOrder = &atomicFunctions;
     _atomicFunctionsMaxForward.resize(atomicFunctions.size());
@@ -479,6 +521,11 @@ size_t CodeHandler<Base>::getTemporaryVariableCount() const {
         return _idCount - _minTemporaryVarID;
 }
 
+template<class Base>
+size_t CodeHandler<Base>::getMaxLiveTemporaryVariables() const {
+    return _maxLiveTemporaries;
+}
+
 template<class Base>
 size_t CodeHandler<Base>::getTemporaryArraySize() const {
     return _idArrayCount - 1;
@@ -492,9 +539,11 @@ size_t CodeHandler<Base>::getTemporarySparseArraySize() const {
 template<class Base>
 void CodeHandler<Base>::reset() {
     for (Node* n : _codeBlocks) {
-        delete n;
+        deleteNode(n);
     }
     _codeBlocks.clear();
+    _nodeArena.clear();
+    _identicalNodes.clear();
     _independentVariables.clear();
     _idCount = 1;
     _idArrayCount = 1;
@@ -522,44 +571,115 @@ inline void CodeHandler<Base>::resetNodes() {
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::cloneNode(const Node& n) {
-    return manageOperationNode(new Node(n));
+    return manageOperationNode(createNode<Node>(n));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op) {
-    return manageOperationNode(new Node(this, op));
+    return manageOperationNode(createNode<Node>(this, op));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         const Arg& arg) {
-    return manageOperationNode(new Node(this, op, arg));
+    if (_reuseIdenticalNodes && isReusableOperation(op)) {
+        ArrayView<const Arg> args(&arg, 1);
+        size_t h = hashOperation(op, ArrayView<const size_t>(), args);
+        Node* n = findIdenticalNode(h, op, ArrayView<const size_t>(), args);
+        if (n == nullptr) {
+            n = manageOperationNode(createNode<Node>(this, op, arg));
+            _identicalNodes.emplace(h, n);
+            n->identical_ = true;
+        }
+        return n;
+    }
+
+    return manageOperationNode(createNode<Node>(this, op, arg));
+}
+
+template<class Base>
+inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
+                                                        std::initializer_list<Arg> args) {
+    if (_reuseIdenticalNodes && isReusableOperation(op)) {
+        ArrayView<const Arg> argsView(args.begin(), args.size());
+        size_t h = hashOperation(op, ArrayView<const size_t>(), argsView);
+        Node* n = findIdenticalNode(h, op, ArrayView<const size_t>(), argsView);
+        if (n == nullptr) {
+            n = manageOperationNode(createNode<Node>(this, op, args));
+            _identicalNodes.emplace(h, n);
+            n->identical_ = true;
+        }
+        return n;
+    }
+
+    return manageOperationNode(createNode<Node>(this, op, args));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         std::vector<Arg>&& args) {
-    return manageOperationNode(new Node(this, op, std::move(args)));
+    if (_reuseIdenticalNodes && isReusableOperation(op)) {
+        size_t h = hashOperation(op, ArrayView<const size_t>(), args);
+        Node* n = findIdenticalNode(h, op, ArrayView<const size_t>(), args);
+        if (n == nullptr) {
+            n = manageOperationNode(createNode<Node>(this, op, std::move(args)));
+            _identicalNodes.emplace(h, n);
+            n->identical_ = true;
+        }
+        return n;
+    }
+
+    return manageOperationNode(createNode<Node>(this, op, std::move(args)));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         std::vector<size_t>&& info,
                                                         std::vector<Arg>&& args) {
-    return manageOperationNode(new Node(this, op, std::move(info), std::move(args)));
+    if (_reuseIdenticalNodes && isReusableOperation(op)) {
+        size_t h = hashOperation(op, info, args);
+        Node* n = findIdenticalNode(h, op, info, args);
+        if (n == nullptr) {
+            n = manageOperationNode(createNode<Node>(this, op, std::move(info), std::move(args)));
+            _identicalNodes.emplace(h, n);
+            n->identical_ = true;
+        }
+        return n;
+    }
+
+    return manageOperationNode(createNode<Node>(this, op, std::move(info), std::move(args)));
 }
 
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
                                                         const std::vector<size_t>& info,
                                                         const std::vector<Arg>& args) {
-    return manageOperationNode(new Node(this, op, info, args));
+    return makeNode<std::allocator<size_t>, std::allocator<Arg> >(op, info, args);
+}
+
+template<class Base>
+template<class InfoAlloc, class ArgAlloc>
+inline OperationNode<Base>* CodeHandler<Base>::makeNode(CGOpCode op,
+                                                        const std::vector<size_t, InfoAlloc>& info,
+                                                        const std::vector<Arg, ArgAlloc>& args) {
+    if (_reuseIdenticalNodes && isReusableOperation(op)) {
+        size_t h = hashOperation(op, info, args);
+        Node* n = findIdenticalNode(h, op, info, args);
+        if (n == nullptr) {
+            n = manageOperationNode(createNode<Node>(this, op, info, args));
+            _identicalNodes.emplace(h, n);
+            n->identical_ = true;
+        }
+        return n;
+    }
+
+    return manageOperationNode(createNode<Node>(this, op, info, args));
 }
 
 template<class Base>
 inline LoopStartOperationNode<Base>* CodeHandler<Base>::makeLoopStartNode(Node& indexDcl,
                                                                           size_t iterationCount) {
-    auto* n = new LoopStartOperationNode<Base>(this, indexDcl, iterationCount);
+    auto* n = createNode<LoopStartOperationNode<Base>>(this, indexDcl, iterationCount);
     manageOperationNode(n);
     return n;
 }
@@ -567,7 +687,7 @@ inline LoopStartOperationNode<Base>* CodeHandler<Base>::makeLoopStartNode(Node&
 template<class Base>
 inline LoopStartOperationNode<Base>* CodeHandler<Base>::makeLoopStartNode(Node& indexDcl,
                                                                           IndexOperationNode<Base>& iterCount) {
-    auto* n = new LoopStartOperationNode<Base>(this, indexDcl, iterCount);
+    auto* n = createNode<LoopStartOperationNode<Base>>(this, indexDcl, iterCount);
     manageOperationNode(n);
     return n;
 }
@@ -575,7 +695,7 @@ inline LoopStartOperationNode<Base>* CodeHandler<Base>::makeLoopStartNode(Node&
 template<class Base>
 inline LoopEndOperationNode<Base>* CodeHandler<Base>::makeLoopEndNode(LoopStartOperationNode<Base>& loopStart,
                                                                       const std::vector<Arg>& endArgs) {
-    auto* n = new LoopEndOperationNode<Base>(this, loopStart, endArgs);
+    auto* n = createNode<LoopEndOperationNode<Base>>(this, loopStart, endArgs);
     manageOperationNode(n);
     return n;
 }
@@ -584,28 +704,28 @@ template<class Base>
 inline PrintOperationNode<Base>* CodeHandler<Base>::makePrintNode(const std::string& before,
                                                                   const Arg& arg,
                                                                   const std::string& after) {
-    auto* n = new PrintOperationNode<Base>(this, before, arg, after);
+    auto* n = createNode<PrintOperationNode<Base>>(this, before, arg, after);
     manageOperationNode(n);
     return n;
 }
 
 template<class Base>
 inline IndexOperationNode<Base>* CodeHandler<Base>::makeIndexNode(Node& indexDcl) {
-    auto* n = new IndexOperationNode<Base>(this, indexDcl);
+    auto* n = createNode<IndexOperationNode<Base>>(this, indexDcl);
     manageOperationNode(n);
     return n;
 }
 
 template<class Base>
 inline IndexOperationNode<Base>* CodeHandler<Base>::makeIndexNode(LoopStartOperationNode<Base>& loopStart) {
-    auto* n = new IndexOperationNode<Base>(this, loopStart);
+    auto* n = createNode<IndexOperationNode<Base>>(this, loopStart);
     manageOperationNode(n);
     return n;
 }
 
 template<class Base>
 inline IndexOperationNode<Base>* CodeHandler<Base>::makeIndexNode(IndexAssignOperationNode<Base>& indexAssign) {
-    auto* n = new IndexOperationNode<Base>(this, indexAssign);
+    auto* n = createNode<IndexOperationNode<Base>>(this, indexAssign);
     manageOperationNode(n);
     return n;
 }
@@ -614,7 +734,7 @@ template<class Base>
 inline IndexAssignOperationNode<Base>* CodeHandler<Base>::makeIndexAssignNode(Node& index,
                                                                               IndexPattern& indexPattern,
                                                                               IndexOperationNode<Base>& index1) {
-    auto* n = new IndexAssignOperationNode<Base>(this, index, indexPattern, index1);
+    auto* n = createNode<IndexAssignOperationNode<Base>>(this, index, indexPattern, index1);
     manageOperationNode(n);
     return n;
 }
@@ -624,7 +744,7 @@ inline IndexAssignOperationNode<Base>* CodeHandler<Base>::makeIndexAssignNode(No
                                                                               IndexPattern& indexPattern,
                                                                               IndexOperationNode<Base>* index1,
                                                                               IndexOperationNode<Base>* index2) {
-    auto* n = new IndexAssignOperationNode<Base>(this, index, indexPattern, index1, index2);
+    auto* n = createNode<IndexAssignOperationNode<Base>>(this, index, indexPattern, index1, index2);
     manageOperationNode(n);
     return n;
 }
@@ -632,7 +752,7 @@ inline IndexAssignOperationNode<Base>* CodeHandler<Base>::makeIndexAssignNode(No
 template<class Base>
 inline OperationNode<Base>* CodeHandler<Base>::makeIndexDclrNode(const std::string& name) {
     CPPADCG_ASSERT_KNOWN(!name.empty(), "index name cannot be empty")
-    auto* n = manageOperationNode(new Node(this, CGOpCode::IndexDeclaration));
+    auto* n = manageOperationNode(createNode<Node>(this, CGOpCode::IndexDeclaration));
     n->setName(name);
     return n;
 }
@@ -655,8 +775,42 @@ inline void CodeHandler<Base>::deleteManagedNodes(size_t start, size_t end) {
     start = std::min<size_t>(start, _codeBlocks.size());
     end = std::min<size_t>(end, _codeBlocks.size());
 
+    if (start == 0 && end == _codeBlocks.size()) {
+        _identicalNodes.clear();
+    } else if (!_identicalNodes.empty()) {
+        bool scan = false;
+        for (size_t i = start; i < end; ++i) {
+            Node* n = _codeBlocks[i];
+            if (!n->identical_)
+                continue;
+
+            size_t h = hashOperation(n->getOperationType(), n->getInfo(), n->getArguments());
+            auto range = _identicalNodes.equal_range(h);
+            auto it = range.first;
+            while (it != range.second && it->second != n)
+                ++it;
+
+            if (it == range.second) {
+                // the node was modified after being registered
+                scan = true;
+                break;
+            }
+            _identicalNodes.erase(it);
+        }
+
+        if (scan) {
+            for (auto it = _identicalNodes.begin(); it != _identicalNodes.end();) {
+                size_t pos = it->second->getHandlerPosition();
+                if (pos >= start && pos < end)
+                    it = _identicalNodes.erase(it);
+                else
+                    ++it;
+            }
+        }
+    }
+
     for (size_t i = start; i < end; ++i) {
-        delete _codeBlocks[i];
+        deleteNode(_codeBlocks[i]);
     }
     _codeBlocks.erase(_codeBlocks.begin() + start, _codeBlocks.begin() + end);
 
@@ -712,6 +866,32 @@ inline bool CodeHandler<Base>::manageOperationNodeMemory(Node* code) {
     return true;
 }
 
+template<class Base>
+template<class T, class... Args>
+inline T* CodeHandler<Base>::createNode(Args&&... args) {
+    if (!_useNodeArena)
+        return new T(std::forward<Args>(args)...);
+
+    void* mem = _nodeArena.allocate(sizeof(T), alignof(T));
+    T* n = new(mem) T(std::forward<Args>(args)...);
+    static_cast<Node*>(n)->inArena_ = true;
+    return n;
+}
+
+template<class Base>
+inline MemoryArena* CodeHandler<Base>::getNodeArena() {
+    return _useNodeArena ? &_nodeArena : nullptr;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::deleteNode(Node* n) {
+    if (n->inArena_) {
+        n->~Node(); // the memory is only released when the arena is cleared
+    } else {
+        delete n;
+    }
+}
+
 template<class Base>
 OperationNode<Base>* CodeHandler<Base>::manageOperationNode(Node* code) {
     //CPPADCG_ASSERT_UNKNOWN(std::find(_codeBlocks.begin(), _codeBlocks.end(), code) == _codeBlocks.end()); // <<< too great of an impact in performance
@@ -724,6 +904,150 @@ OperationNode<Base>* CodeHandler<Base>::manageOperationNode(Node* code) {
     return code;
 }
 
+template<class Base>
+inline bool CodeHandler<Base>::isReusableOperation(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Erfc:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::hashOperation(CGOpCode op,
+                                               ArrayView<const size_t> info,
+                                               ArrayView<const Arg> args) {
+    auto combine = [](size_t& h, size_t v) {
+        h ^= v + 0x9e3779b9 + (h << 6u) + (h >> 2u);
+    };
+
+    // parameters only contribute with their position (Base might not be hashable)
+    auto hashArg = [](const Arg& a) {
+        return a.getOperation() != nullptr ? std::hash<const Node*>()(a.getOperation()) : size_t(0x51ed27);
+    };
+
+    size_t h = size_t(op);
+    for (size_t i : info)
+        combine(h, i);
+
+    if (args.size() == 2 && (op == CGOpCode::Add || op == CGOpCode::Mul)) {
+        // commutative: the order of the arguments must not change the hash
+        combine(h, hashArg(args[0]) + hashArg(args[1]));
+    } else {
+        for (const Arg& a : args)
+            combine(h, hashArg(a));
+    }
+
+    return h;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isIdenticalParameter(const Base& p1,
+                                                   const Base& p2) {
+    /**
+     * the representations are compared so that the result cannot change
+     * (e.g. -0.0 == 0.0 but 1/-0.0 != 1/0.0) and so that NaN constants can
+     * be reused
+     */
+    return compareParameterBits(p1, p2, std::is_trivially_copyable<Base>());
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::compareParameterBits(const Base& p1,
+                                                   const Base& p2,
+                                                   std::true_type) {
+    return std::memcmp(&p1, &p2, sizeof(Base)) == 0;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::compareParameterBits(const Base& p1,
+                                                   const Base& p2,
+                                                   std::false_type) {
+    return p1 == p2;
+}
+
+template<class Base>
+inline OperationNode<Base>* CodeHandler<Base>::findIdenticalNode(size_t hash,
+                                                                 CGOpCode op,
+                                                                 ArrayView<const size_t> info,
+                                                                 ArrayView<const Arg> args) const {
+    auto isSame = [](const Arg& a1, const Arg& a2) {
+        if (a1.getOperation() != nullptr || a2.getOperation() != nullptr)
+            return a1.getOperation() == a2.getOperation();
+        if (a1.getParameter() == nullptr || a2.getParameter() == nullptr)
+            return a1.getParameter() == a2.getParameter();
+        return isIdenticalParameter(*a1.getParameter(), *a2.getParameter());
+    };
+
+    bool commutative = args.size() == 2 && (op == CGOpCode::Add || op == CGOpCode::Mul);
+
+    auto range = _identicalNodes.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        Node* n = it->second;
+        // nodes might have been modified after being created
+        if (n->getOperationType() != op)
+            continue;
+
+        const ArenaVector<size_t>& nInfo = n->getInfo();
+        if (nInfo.size() != info.size() || !std::equal(nInfo.begin(), nInfo.end(), info.begin()))
+            continue;
+
+        const ArenaVector<Arg>& nArgs = n->getArguments();
+        if (nArgs.size() != args.size())
+            continue;
+
+        bool same = true;
+        for (size_t a = 0; a < args.size(); ++a) {
+            if (!isSame(nArgs[a], args[a])) {
+                same = false;
+                break;
+            }
+        }
+
+        if (!same && commutative) {
+            same = isSame(nArgs[0], args[1]) && isSame(nArgs[1], args[0]);
+        }
+
+        if (same)
+            return n;
+    }
+
+    return nullptr;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::addVector(CodeHandlerVectorSync<Base>* v) {
     _managedVectors.insert(v);
@@ -855,7 +1179,7 @@ void CodeHandler<Base>::markCodeBlockUsed(Node& root) {
                         /**
                          * Must also update the scope of the arguments used by this operation
                          */
-                        const std::vector<Arg>& args = code.getArguments();
+                        const ArenaVector<Arg>& args = code.getArguments();
                         size_t aSize = args.size();
                         for (size_t a = 0; a < aSize; a++) {
                             updateVarScopeUsage(args[a].getOperation(), newScope, oldScope);
@@ -1055,7 +1379,7 @@ inline void CodeHandler<Base>::replaceWithConditionalTempVar(Node& tmp,
     /**
      * Must also update the scope of the arguments used by this operation
      */
-    const std::vector<Arg>& cargs = opClone->getArguments();
+    const ArenaVector<Arg>& cargs = opClone->getArguments();
     size_t aSize = cargs.size();
     for (size_t a = 0; a < aSize; a++) {
         updateVarScopeUsage(cargs[a].getOperation(), newScopeColor, oldScope);
@@ -1128,7 +1452,7 @@ inline void CodeHandler<Base>::updateTemporaryVarInDiffScopes(Node& code) {
         } else if (oldIterRegions != iterationRegions) {
             Node* cond = bScopeOld->getArguments()[0].getOperation();
             CPPADCG_ASSERT_UNKNOWN(cond->getOperationType() == CGOpCode::IndexCondExpr)
-            cond->getInfo() = iterationRegions;
+            cond->getInfo().assign(iterationRegions.begin(), iterationRegions.end());
         }
 
     }
@@ -1138,7 +1462,7 @@ inline void CodeHandler<Base>::updateTemporaryVarInDiffScopes(Node& code) {
         /**
          * Must also update the scope of the arguments used by this operation
          */
-        const std::vector<Arg>& cargs = code.getArguments();
+        const ArenaVector<Arg>& cargs = code.getArguments();
         size_t aSize = cargs.size();
         for (size_t a = 0; a < aSize; a++) {
             updateVarScopeUsage(cargs[a].getOperation(), newScope, oldScope);
@@ -1163,7 +1487,7 @@ inline void CodeHandler<Base>::restoreTemporaryVar(Node& tmp) {
     /**
      * Must also update the scope of the arguments used by this operation
      */
-    const std::vector<Arg>& args = tmp.getArguments();
+    const ArenaVector<Arg>& args = tmp.getArguments();
     size_t aSize = args.size();
     for (size_t a = 0; a < aSize; a++) {
         updateVarScopeUsage(args[a].getOperation(), _currentScopeColor, _scope[*opClone]);
@@ -1183,7 +1507,7 @@ inline void CodeHandler<Base>::restoreTemporaryVar(Node* tmp,
     /**
      * Must also update the scope of the arguments used by this operation
      */
-    const std::vector<Arg>& args = tmp->getArguments();
+    const ArenaVector<Arg>& args = tmp->getArguments();
     size_t aSize = args.size();
     for (size_t a = 0; a < aSize; a++) {
         updateVarScopeUsage(args[a].getOperation(), _currentScopeColor, _scope[*opClone]);
@@ -1214,7 +1538,7 @@ inline void CodeHandler<Base>::updateVarScopeUsage(Node* node,
 
     _scope[*node] = newScope;
 
-    const std::vector<Arg>& args = node->getArguments();
+    const ArenaVector<Arg>& args = node->getArguments();
     size_t aSize = args.size();
     for (size_t a = 0; a < aSize; a++) {
         updateVarScopeUsage(args[a].getOperation(), newScope, oldScope);
@@ -1305,8 +1629,8 @@ inline void CodeHandler<Base>::optimizeIfs() {
                 /**
                  * same condition -> combine the contents into a single if
                  */
-                const std::vector<Arg>& eArgs = endIf->getArguments();
-                std::vector<Arg>& eArgs1 = endIf1->getArguments();
+                const ArenaVector<Arg>& eArgs = endIf->getArguments();
+                ArenaVector<Arg>& eArgs1 = endIf1->getArguments();
 
                 ScopeIDType ifScope = _scope[*startIf];
                 ScopeIDType ifScope1 = _scope[*startIf1];
@@ -1360,7 +1684,7 @@ inline void CodeHandler<Base>::replaceScope(Node* node,
 
     _scope[*node] = newScope;
 
-    const std::vector<Arg>& args = node->getArguments();
+    const ArenaVector<Arg>& args = node->getArguments();
     for (size_t a = 0; a < args.size(); a++) {
         replaceScope(args[a].getOperation(), oldScope, newScope);
     }
@@ -1376,7 +1700,7 @@ inline void CodeHandler<Base>::breakCyclicDependency(Node* node,
     markVisited(*node);
 
     CGOpCode op = node->getOperationType();
-    std::vector<Arg>& args = node->getArguments();
+    ArenaVector<Arg>& args = node->getArguments();
 
     if (op == CGOpCode::Tmp && args.size() > 1) {
         Node* arg = args[1].getOperation();
@@ -1418,7 +1742,7 @@ inline bool CodeHandler<Base>::containedInScope(const Node& node,
 template<class Base>
 inline bool CodeHandler<Base>::containsArgument(const Node& node,
                                                 const Node& arg) {
-    const std::vector<Arg>& args = node.getArguments();
+    const ArenaVector<Arg>& args = node.getArguments();
     for (size_t a = 0; a < args.size(); a++) {
         if (args[a].getOperation() == &arg) {
             return true;
@@ -1635,6 +1959,10 @@ inline void CodeHandler<Base>::addToEvaluationQueue(Node& arg) {
 template<class Base>
 inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependent) {
 
+    if (_minimizeLiveVariables) {
+        scheduleOperations();
+    }
+
     reorderOperations(dependent);
 
     /**
@@ -1668,6 +1996,7 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
      * Redefine temporary variable IDs
      */
     std::vector<size_t> freedVariables; // variable IDs no longer in use
+    size_t live = 0; // number of temporary variables in use
     _idCount = _minTemporaryVarID;
     ArrayIdCompresser<Base> arrayComp(_varId, _idArrayCount);
     ArrayIdCompresser<Base> sparseArrayComp(_varId, _idSparseArrayCount);
@@ -1679,6 +2008,7 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
         for (size_t r = 0; r < released.size(); r++) {
             if (isTemporary(*released[r])) {
                 freedVariables.push_back(_varId[*released[r]]);
+                live--;
             } else if (isTemporaryArray(*released[r])) {
                 arrayComp.addFreeArraySpace(*released[r]);
             } else if (isTemporarySparseArray(*released[r])) {
@@ -1688,6 +2018,8 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
 
         if (isTemporary(var)) {
             // a single temporary variable
+            live++;
+            _maxLiveTemporaries = std::max(_maxLiveTemporaries, live);
             if (freedVariables.empty()) {
                 _varId[var] = _idCount;
                 _idCount++;
@@ -1712,6 +2044,174 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
     _idSparseArrayCount = sparseArrayComp.getIdCount();
 }
 
+template<class Base>
+inline void CodeHandler<Base>::scheduleOperations() {
+    /**
+     * reorder each block of operations which can be moved
+     */
+    size_t begin = 0;
+    for (size_t i = 0; i <= _variableOrder.size(); ++i) {
+        if (i == _variableOrder.size() || !isSchedulable(*_variableOrder[i])) {
+            if (i > begin + 2) {
+                scheduleOperations(begin, i);
+            }
+            begin = i + 1;
+        }
+    }
+
+    /**
+     * update the evaluation order
+     */
+    _evaluationOrder.fill(0);
+    for (size_t p = 0; p < _variableOrder.size(); p++) {
+        Node& arg = *_variableOrder[p];
+        setEvaluationOrder(arg, p + 1);
+        dependentAdded2EvaluationQueue(arg);
+    }
+}
+
+template<class Base>
+inline void CodeHandler<Base>::scheduleOperations(size_t begin,
+                                                  size_t end) {
+    const size_t size = end - begin;
+
+    // the location of a node in this block (size if it is not in the block)
+    auto blockLocation = [&](const Node& node) {
+        size_t order = getEvaluationOrder(node);
+        if (order > begin && order <= end && _variableOrder[order - 1] == &node)
+            return order - 1 - begin;
+        return size;
+    };
+
+    /**
+     * determine the dependencies between the variables in this block
+     * (the operations without a variable are part of their parent's expression)
+     */
+    std::vector<std::vector<size_t>> children(size);
+    std::vector<size_t> nParents(size, 0);
+    std::vector<Node*> stack;
+
+    for (size_t k = 0; k < size; ++k) {
+        startNewOperationTreeVisit();
+
+        for (const Arg& a : *_variableOrder[begin + k]) {
+            if (a.getOperation() != nullptr)
+                stack.push_back(a.getOperation());
+        }
+
+        while (!stack.empty()) {
+            Node& node = *stack.back();
+            stack.pop_back();
+            if (isVisited(node))
+                continue;
+            markVisited(node);
+
+            size_t c = blockLocation(node);
+            if (c < size) {
+                children[k].push_back(c);
+                nParents[c]++;
+            } else if (_varId[node] == 0) {
+                for (const Arg& a : node) {
+                    if (a.getOperation() != nullptr)
+                        stack.push_back(a.getOperation());
+                }
+            }
+        }
+    }
+
+    /**
+     * determine the number of temporary variables required to evaluate
+     * each variable (Sethi-Ullman numbers) and the order of its children
+     */
+    std::vector<size_t> label(size, 1);
+    for (size_t k = 0; k < size; ++k) {
+        std::vector<size_t>& ch = children[k];
+        // children requiring more temporary variables first (keep the original order otherwise)
+        std::sort(ch.begin(), ch.end(), [&](size_t c1, size_t c2) {
+            return label[c1] > label[c2] || (label[c1] == label[c2] && c1 < c2);
+        });
+        for (size_t i = 0; i < ch.size(); ++i) {
+            label[k] = std::max(label[k], label[ch[i]] + i);
+        }
+    }
+
+    /**
+     * new evaluation order (depth-first from the variables not used inside this block)
+     */
+    std::vector<Node*> order;
+    order.reserve(size);
+    std::vector<bool> added(size, false);
+    std::vector<std::pair<size_t, size_t>> dfs; // variable location and the next child to visit
+
+    for (size_t r = 0; r < size; ++r) {
+        if (nParents[r] != 0)
+            continue;
+
+        dfs.emplace_back(r, 0);
+        while (!dfs.empty()) {
+            size_t k = dfs.back().first;
+            size_t& next = dfs.back().second;
+            if (next < children[k].size()) {
+                size_t c = children[k][next];
+                next++;
+                if (!added[c])
+                    dfs.emplace_back(c, 0);
+            } else {
+                added[k] = true;
+                order.push_back(_variableOrder[begin + k]);
+                dfs.pop_back();
+            }
+        }
+    }
+
+    CPPADCG_ASSERT_UNKNOWN(order.size() == size)
+
+    std::copy(order.begin(), order.end(), _variableOrder.begin() + begin);
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isSchedulable(const Node& node) {
+    switch (node.getOperationType()) {
+        case CGOpCode::Assign:
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Erfc:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
 template<class Base>
 inline void CodeHandler<Base>::reorderOperations(ArrayView<CGB>& dependent) {
     // determine the location of the last temporary variable used for each dependent
@@ -1727,7 +2227,7 @@ inline void CodeHandler<Base>::reorderOperations(ArrayView<CGB>& dependent) {
 
     // dependent nodes defined inside loops
     for (const LoopEndOperationNode<Base>* endNode : _loops.endNodes) {
-        const std::vector<Arg>& args = endNode->getArguments();
+        const ArenaVector<Arg>& args = endNode->getArguments();
         for (size_t i = 1; i < args.size(); ++i) {
             CPPADCG_ASSERT_UNKNOWN(args[i].getOperation() != nullptr)
             // TODO: also consider CGOpCode::LoopIndexedDep inside a CGOpCode::endIf
@@ -0,0 +1,92 @@
+#ifndef CPPAD_CG_CONTENT_HASH_INCLUDED
+#define CPPAD_CG_CONTENT_HASH_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Incremental (non-cryptographic) 128 bit hash used to create keys which
+ * identify the content of files and other data (e.g. for caching).
+ * Each added value is prefixed with its size so that the concatenation
+ * of different values cannot produce the same key.
+ *
+ * @author Joao Leal
+ */
+class ContentHash {
+private:
+    uint64_t _h1;
+    uint64_t _h2;
+public:
+
+    inline ContentHash() :
+        _h1(0xcbf29ce484222325ull), // FNV-1a offset basis
+        _h2(0x84222325cbf29ce4ull) {
+    }
+
+    inline ContentHash& add(const char* data,
+                            size_t size) {
+        mix(size);
+        for (size_t i = 0; i < size; ++i) {
+            auto b = static_cast<unsigned char>(data[i]);
+            _h1 = (_h1 ^ b) * 0x100000001b3ull; // FNV-1a
+            _h2 = (_h2 + b) * 0x9e3779b97f4a7c15ull;
+            _h2 ^= _h2 >> 29u;
+        }
+        return *this;
+    }
+
+    inline ContentHash& add(const std::string& text) {
+        return add(text.data(), text.size());
+    }
+
+    inline ContentHash& add(const std::vector<std::string>& texts) {
+        mix(texts.size());
+        for (const std::string& t: texts)
+            add(t);
+        return *this;
+    }
+
+    inline ContentHash& add(unsigned long long value) {
+        mix(value);
+        return *this;
+    }
+
+    /**
+     * @return a hexadecimal representation of the current hash value
+     */
+    inline std::string str() const {
+        std::ostringstream os;
+        os << std::hex << std::setfill('0') << std::setw(16) << _h1 << std::setw(16) << _h2;
+        return os.str();
+    }
+
+private:
+
+    inline void mix(uint64_t value) {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            auto b = static_cast<unsigned char>(value >> (8u * i));
+            _h1 = (_h1 ^ b) * 0x100000001b3ull;
+            _h2 = (_h2 + b) * 0x9e3779b97f4a7c15ull;
+            _h2 ^= _h2 >> 29u;
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
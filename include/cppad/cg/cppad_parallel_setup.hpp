@@ -0,0 +1,229 @@
+#ifndef CPPAD_CG_CPPAD_PARALLEL_SETUP_INCLUDED
+#define CPPAD_CG_CPPAD_PARALLEL_SETUP_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Prepares CppAD to be used by several threads (thread_alloc and the
+ * static data of AD<Base> and AD<CG<Base> >) while an object of this class
+ * exists.
+ * The thread which creates the object is CppAD's thread zero and any other
+ * thread gets an available thread number when it first uses CppAD (the
+ * number is released when the thread ends).
+ * CppAD is placed back in sequential mode when the object is destroyed,
+ * after all the other threads have finished.
+ *
+ * The first object must be created in sequential mode (CppAD cannot be
+ * used by other threads at the same time).
+ * Objects created while another object exists (by any thread) reuse the
+ * existing setup and do not change the mode of CppAD when they are
+ * destroyed; they must be destroyed before the first object.
+ * This allows, for instance, the main thread to keep using CppAD while a
+ * model library is created in another thread which generates sources with
+ * several threads:
+ * @code
+ * CppADParallelSetup<double> parallel(CppADParallelSetup<double>::getMaxThreads());
+ * auto future = processor.createDynamicLibraryAsync(compiler);
+ * // ... CppAD can be used here ...
+ * auto lib = future.get();
+ * @endcode
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class CppADParallelSetup {
+private:
+    /**
+     * the maximum number of threads (only used by the first object)
+     */
+    size_t _threads;
+    /**
+     * whether or not this object placed CppAD in parallel mode
+     */
+    bool _owner;
+public:
+
+    /**
+     * @param threads the maximum number of threads which will use CppAD
+     *                (including the current thread)
+     */
+    inline explicit CppADParallelSetup(size_t threads) :
+        _threads(threads),
+        _owner(false) {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        if (s.users > 0) {
+            // reuse the existing setup
+            CPPADCG_ASSERT_KNOWN(threads <= s.maxThreads - s.assigned + 1,
+                                 "Not enough threads available in the existing CppADParallelSetup")
+            s.users++;
+            return;
+        }
+
+        CPPADCG_ASSERT_KNOWN(!thread_alloc::in_parallel(), "CppAD is already in parallel mode")
+        CPPADCG_ASSERT_KNOWN(threads <= CPPAD_MAX_NUM_THREADS, "Too many threads for CppAD (see CPPAD_MAX_NUM_THREADS)")
+
+        _owner = true;
+        s.mainThread = std::this_thread::get_id();
+        s.maxThreads = threads;
+        s.assigned = 1; // the main thread
+        s.available.clear();
+        s.nextThread = 1;
+        s.generation++;
+        s.users = 1;
+
+        thread_alloc::parallel_setup(threads, &isInParallel, &getThreadNumber);
+        parallel_ad<Base>();
+        parallel_ad<CG<Base> >();
+
+        s.inParallel = true;
+    }
+
+    CppADParallelSetup(const CppADParallelSetup&) = delete;
+    CppADParallelSetup& operator=(const CppADParallelSetup&) = delete;
+
+    inline ~CppADParallelSetup() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        s.users--;
+        if (!_owner)
+            return;
+
+        CPPADCG_ASSERT_KNOWN(s.users == 0, "A CppADParallelSetup was destroyed before the ones created afterwards")
+
+        s.inParallel = false;
+
+        // memory kept by the other threads
+        for (size_t t = 1; t < _threads; ++t) {
+            thread_alloc::free_available(t);
+        }
+
+        thread_alloc::parallel_setup(1, nullptr, nullptr);
+        parallel_ad<Base>();
+        parallel_ad<CG<Base> >();
+    }
+
+    /**
+     * Provides the maximum number of threads which can be requested by a
+     * new object of this class (including the current thread).
+     * When another object already exists, it is the number of thread
+     * numbers which were not yet assigned to a thread.
+     *
+     * @return the maximum number of threads which can be used with CppAD
+     *         (including the current thread)
+     */
+    static inline size_t getMaxThreads() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.users == 0)
+            return CPPAD_MAX_NUM_THREADS;
+        return std::max<size_t>(s.maxThreads - s.assigned + 1, 1);
+    }
+
+private:
+
+    struct State {
+        std::mutex mutex;
+        std::thread::id mainThread;
+        /**
+         * the number of existing CppADParallelSetup objects
+         */
+        size_t users;
+        size_t maxThreads;
+        /**
+         * the number of thread numbers currently assigned to threads
+         */
+        size_t assigned;
+        /**
+         * thread numbers released by threads which have ended
+         */
+        std::vector<size_t> available;
+        size_t nextThread;
+        std::atomic<bool> inParallel;
+        std::atomic<size_t> generation;
+
+        inline State() :
+            users(0),
+            maxThreads(1),
+            assigned(0),
+            nextThread(1),
+            inParallel(false),
+            generation(0) {
+        }
+    };
+
+    /**
+     * The thread number of a thread (other than the main thread) which is
+     * released when the thread ends
+     */
+    struct ThreadNumber {
+        size_t number;
+        size_t generation;
+
+        inline ThreadNumber() :
+            number(0),
+            generation(0) {
+        }
+
+        inline ~ThreadNumber() {
+            State& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (generation != 0 && generation == s.generation) {
+                s.available.push_back(number);
+                s.assigned--;
+            }
+        }
+    };
+
+    static inline State& state() {
+        static State s;
+        return s;
+    }
+
+    static bool isInParallel() {
+        return state().inParallel;
+    }
+
+    static size_t getThreadNumber() {
+        State& s = state();
+        if (std::this_thread::get_id() == s.mainThread)
+            return 0;
+
+        // thread numbers from a previous setup are not used
+        thread_local ThreadNumber tn;
+        if (tn.generation != s.generation) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (!s.available.empty()) {
+                tn.number = s.available.back();
+                s.available.pop_back();
+            } else {
+                tn.number = s.nextThread++;
+            }
+            s.assigned++;
+            tn.generation = s.generation;
+        }
+        return tn.number;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
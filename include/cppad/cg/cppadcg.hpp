@@ -31,7 +31,9 @@ static_assert(false,
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cstddef>
+#include <cstdint>
 #include <cerrno>
 #include <fstream>
 #include <iomanip>
@@ -40,6 +42,8 @@ static_assert(false,
 #include <limits>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <valarray>
 #include <vector>
@@ -56,6 +60,11 @@ static_assert(false,
 #include <chrono>
 #include <thread>
 #include <functional>
+#include <type_traits>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <exception>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -96,6 +105,8 @@ static_assert(false,
 #include <cppad/cg/smart_containers.hpp>
 #include <cppad/cg/ostream_config_restore.hpp>
 #include <cppad/cg/array_view.hpp>
+#include <cppad/cg/content_hash.hpp>
+#include <cppad/cg/memory_arena.hpp>
 
 // ---------------------------------------------------------------------------
 // indexes
@@ -127,6 +138,8 @@ static_assert(false,
 #include <cppad/cg/atomic_dependency_locator.hpp>
 #include <cppad/cg/variable_name_generator.hpp>
 #include <cppad/cg/job_timer.hpp>
+#include <cppad/cg/cppad_parallel_setup.hpp>
+#include <cppad/cg/source_sink.hpp>
 #include <cppad/cg/lang/language.hpp>
 #include <cppad/cg/lang/lang_stream_stack.hpp>
 #include <cppad/cg/scope_path_element.hpp>
@@ -204,11 +217,13 @@ static_assert(false,
 #include <cppad/cg/lang/c/language_c_index_patterns.hpp>
 #include <cppad/cg/lang/c/language_c_double.hpp>
 #include <cppad/cg/lang/c/language_c_float.hpp>
+#include <cppad/cg/lang/c/language_c_vector.hpp>
 #include <cppad/cg/lang/c/language_c_loops.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_batch_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
 //
@@ -219,6 +234,7 @@ static_assert(false,
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
 #include <cppad/cg/model/model_library.hpp>
+#include <cppad/cg/model/compressed_sparsity.hpp>
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
@@ -229,8 +245,10 @@ static_assert(false,
 #include <cppad/cg/model/dynamic_lib/ar_archiver.hpp>
 
 // compiler
+#include <cppad/cg/model/compiler/compiler_cache.hpp>
 #include <cppad/cg/model/compiler/c_compiler.hpp>
 #include <cppad/cg/model/compiler/abstract_c_compiler.hpp>
+#include <cppad/cg/model/compiler/compiler_source_sink.hpp>
 #include <cppad/cg/model/compiler/gcc_compiler.hpp>
 #include <cppad/cg/model/compiler/clang_compiler.hpp>
 
@@ -250,6 +268,9 @@ static_assert(false,
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
+#include <cppad/cg/model/model_c_source_gen_batch.hpp>
+#include <cppad/cg/model/model_c_source_gen_multi.hpp>
+#include <cppad/cg/model/model_c_source_gen_color.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for0.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for1.hpp>
@@ -58,6 +58,9 @@ class HessianRowGroup;
 
 class ArrayGroup;
 
+template<class Base>
+class ForRevUsagePrinter;
+
 template<class Base>
 inline std::vector<CG<Base> > createIndexedIndependents(CodeHandler<Base>& handler,
                                                         LoopModel<Base>& loop,
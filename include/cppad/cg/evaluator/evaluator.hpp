@@ -222,7 +222,7 @@ protected:
         }
     }
 
-    inline ActiveOut evalArg(const std::vector<Argument<ScalarIn> >& args,
+    inline ActiveOut evalArg(const ArenaVector<Argument<ScalarIn> >& args,
                              size_t pos) {
         return evalArg(args[pos], pos);
     }
@@ -289,7 +289,7 @@ protected:
             return *it->second;
         }
 
-        const std::vector<Argument<ScalarIn> >& args = node.getArguments();
+        const ArenaVector<Argument<ScalarIn> >& args = node.getArguments();
         auto* resultArray = new std::vector<ActiveOut>(args.size());
 
         // save it for reuse
@@ -314,7 +314,7 @@ protected:
             return *it->second;
         }
 
-        const std::vector<Argument<ScalarIn> >& args = node.getArguments();
+        const ArenaVector<Argument<ScalarIn> >& args = node.getArguments();
         auto* resultArray = new std::vector<ActiveOut>(args.size());
 
         // save it for reuse
@@ -479,38 +479,38 @@ protected:
     }
 
     inline ActiveOut evalAssign(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for assign()")
         return evalArg(args, 0);
     }
 
     inline ActiveOut evalAbs(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for abs()")
         return abs(evalArg(args, 0));
     }
 
     inline ActiveOut evalAcos(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for acos()")
         return acos(evalArg(args, 0));
     }
 
     inline ActiveOut evalAdd(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for addition")
         return evalArg(args, 0) + evalArg(args, 1);
     }
 
     inline ActiveOut evalAlias(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for alias")
         return evalArg(args, 0);
     }
 
     inline ActiveOut evalArrayElement(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
-        const std::vector<size_t>& info = node.getInfo();
+        const ArenaVector<ArgIn>& args = node.getArguments();
+        const ArenaVector<size_t>& info = node.getInfo();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for array element")
         CPPADCG_ASSERT_KNOWN(args[0].getOperation() != nullptr, "Invalid argument for array element");
         CPPADCG_ASSERT_KNOWN(args[1].getOperation() != nullptr, "Invalid argument for array element");
@@ -525,73 +525,73 @@ protected:
     }
 
     inline ActiveOut evalAsin(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for asin()")
         return asin(evalArg(args, 0));
     }
 
     inline ActiveOut evalAtan(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for atan()")
         return atan(evalArg(args, 0));
     }
 
     inline ActiveOut evalCompareLt(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareLt, )")
         return CondExpOp(CompareLt, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCompareLe(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareLe, )")
         return CondExpOp(CompareLe, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCompareEq(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareEq, )")
         return CondExpOp(CompareEq, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCompareGe(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareGe, )")
         return CondExpOp(CompareGe, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCompareGt(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareGt, )")
         return CondExpOp(CompareGt, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCompareNe(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 4, "Invalid number of arguments for CondExpOp(CompareNe, )")
         return CondExpOp(CompareNe, evalArg(args, 0), evalArg(args, 1), evalArg(args, 2), evalArg(args, 3));
     }
 
     inline ActiveOut evalCosh(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for cosh()")
         return cosh(evalArg(args, 0));
     }
 
     inline ActiveOut evalCos(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for cos()")
         return cos(evalArg(args, 0));
     }
 
     inline ActiveOut evalDiv(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for division")
         return evalArg(args, 0) / evalArg(args, 1);
     }
 
     inline ActiveOut evalExp(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for exp()")
         return exp(evalArg(args, 0));
     }
@@ -602,19 +602,19 @@ protected:
     }
 
     inline ActiveOut evalLog(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for log()")
         return log(evalArg(args, 0));
     }
 
     inline ActiveOut evalMul(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for multiplication")
         return evalArg(args, 0) * evalArg(args, 1);
     }
 
     inline ActiveOut evalPow(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for pow()")
         return pow(evalArg(args, 0), evalArg(args, 1));
     }
@@ -626,49 +626,49 @@ protected:
 
     //case PriOp: //  PrintFor(text, parameter or variable, parameter or variable)
     inline ActiveOut evalSign(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for sign()")
         return sign(evalArg(args, 0));
     }
 
     inline ActiveOut evalSinh(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for sinh()")
         return sinh(evalArg(args, 0));
     }
 
     inline ActiveOut evalSin(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for sin()")
         return sin(evalArg(args, 0));
     }
 
     inline ActiveOut evalSqrt(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for sqrt()")
         return sqrt(evalArg(args, 0));
     }
 
     inline ActiveOut evalSub(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for subtraction")
         return evalArg(args, 0) - evalArg(args, 1);
     }
 
     inline ActiveOut evalTanh(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for tanh()")
         return tanh(evalArg(args, 0));
     }
 
     inline ActiveOut evalTan(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for tan()")
         return tan(evalArg(args, 0));
     }
 
     inline ActiveOut evalMinus(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for unary minus")
         return -evalArg(args, 0);
     }
@@ -138,8 +138,8 @@ protected:
             throw CGException("Evaluator can only handle zero forward mode for atomic functions");
         }
 
-        const std::vector<size_t>& info = node.getInfo();
-        const std::vector<Argument<ScalarIn> >& args = node.getArguments();
+        const ArenaVector<size_t>& info = node.getInfo();
+        const ArenaVector<Argument<ScalarIn> >& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for atomic forward mode")
         CPPADCG_ASSERT_KNOWN(info.size() == 3, "Invalid number of information data for atomic forward mode")
 
@@ -179,7 +179,7 @@ protected:
      *        is not virtual (hides a method in EvaluatorOperations)
      */
     inline ActiveOut evalPrint(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for print()")
         ActiveOut out(this->evalArg(args, 0));
 
@@ -125,7 +125,7 @@ protected:
      *        is not virtual (hides a method in EvaluatorOperations)
      */
     inline ActiveOut evalPrint(const NodeIn& node) {
-        const std::vector<ArgIn>& args = node.getArguments();
+        const ArenaVector<ArgIn>& args = node.getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() == 1, "Invalid number of arguments for print()")
         ActiveOut out(this->evalArg(args, 0));
 
@@ -159,8 +159,8 @@ protected:
             return; // *evals_[node];
         }
 
-        const std::vector<size_t>& info = node.getInfo();
-        const std::vector<Argument<ScalarIn> >& inArgs = node.getArguments();
+        const ArenaVector<size_t>& info = node.getInfo();
+        const ArenaVector<Argument<ScalarIn> >& inArgs = node.getArguments();
 
         CPPADCG_ASSERT_KNOWN(info.size() == 3, "Invalid number of information data for atomic operation")
         size_t p = info[2];
@@ -232,8 +232,8 @@ protected:
             return *evals_[node];
         }
 
-        const std::vector<ArgIn>& args = node.getArguments();
-        const std::vector<size_t>& info = node.getInfo();
+        const ArenaVector<ArgIn>& args = node.getArguments();
+        const ArenaVector<size_t>& info = node.getInfo();
         CPPADCG_ASSERT_KNOWN(args.size() == 2, "Invalid number of arguments for array element")
         CPPADCG_ASSERT_KNOWN(args[0].getOperation() != nullptr, "Invalid argument for array element")
         CPPADCG_ASSERT_KNOWN(args[1].getOperation() != nullptr, "Invalid argument for array element")
@@ -68,6 +68,21 @@ private:
 
 };
 
+/**
+ * The exception thrown when a job is started after the cancellation of
+ * the running jobs was requested
+ *
+ * @see JobTimer::cancel()
+ */
+class CGCancelledException : public CGException {
+public:
+
+    template<typename... Ts>
+    explicit CGCancelledException(const Ts&... ts) noexcept :
+        CGException(ts...) {
+    }
+};
+
 inline std::ostream& operator<<(std::ostream& out, const CGException& rhs) {
     out << rhs.what();
     return out;
@@ -73,6 +73,7 @@ public:
     static const JobType COMPILING_FOR_MODEL;
     static const JobType COMPILING;
     static const JobType COMPILING_DYNAMIC_LIBRARY;
+    static const JobType REUSING_CACHED;
     static const JobType DYNAMIC_MODEL_LIBRARY;
     static const JobType STATIC_MODEL_LIBRARY;
     static const JobType ASSEMBLE_STATIC_LIBRARY;
@@ -103,6 +104,9 @@ const JobType JobTypeHolder<T>::COMPILING("compiling", "compiled");
 template<int T>
 const JobType JobTypeHolder<T>::COMPILING_DYNAMIC_LIBRARY("compiling dynamic library", "compiled library");
 
+template<int T>
+const JobType JobTypeHolder<T>::REUSING_CACHED("reusing cached", "reused cached");
+
 template<int T>
 const JobType JobTypeHolder<T>::DYNAMIC_MODEL_LIBRARY("creating library", "created library");
 
@@ -140,9 +144,15 @@ public:
 
     inline Job(const JobType& type,
                const std::string& name) :
+        Job(type, name, std::chrono::steady_clock::now()) {
+    }
+
+    inline Job(const JobType& type,
+               const std::string& name,
+               std::chrono::steady_clock::time_point beginTime) :
         _type(&type),
         _name(name),
-        _beginTime(std::chrono::steady_clock::now()),
+        _beginTime(beginTime),
         _nestedJobs(false) {
     }
 
@@ -177,6 +187,43 @@ public:
                              duration elapsed) = 0;
 };
 
+/**
+ * A listener which records the start and end of jobs so that they can be
+ * reported later by another JobTimer (e.g. the jobs executed by a
+ * JobTimer used in a worker thread).
+ */
+class JobRecorder : public JobListener {
+public:
+    /**
+     * The start or the end of a job
+     */
+    struct Event {
+        Job job;
+        bool ended;
+        duration elapsed;
+    };
+private:
+    std::vector<Event> _events;
+public:
+
+    inline const std::vector<Event>& getEvents() const {
+        return _events;
+    }
+
+    inline void clear() {
+        _events.clear();
+    }
+
+    void jobStarted(const std::vector<Job>& job) override {
+        _events.push_back(Event{job.back(), false, duration::zero()});
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        _events.push_back(Event{job.back(), true, elapsed});
+    }
+};
+
 /**
  * Utility class used to print elapsed times of jobs
  */
@@ -216,12 +263,17 @@ private:
      *
      */
     std::set<JobListener*> _listeners;
+    /**
+     * Whether or not the cancellation of the jobs was requested
+     */
+    std::atomic<bool> _cancelled;
 public:
 
     JobTimer() :
         _verbose(false),
         _maxLineWidth(80),
-        _indent(2) {
+        _indent(2),
+        _cancelled(false) {
     }
 
     inline bool isVerbose() const {
@@ -257,52 +309,90 @@ public:
         return _listeners.erase(&l) > 0;
     }
 
+    /**
+     * Requests the cancellation of the running jobs.
+     * It can be called from any thread.
+     * The next job to start (in the thread running the jobs) throws a
+     * CGCancelledException and all the running jobs are discarded.
+     * If there are no running jobs, the next job to start is cancelled.
+     */
+    inline void cancel() {
+        _cancelled = true;
+    }
+
+    /**
+     * Whether or not the cancellation was requested and no job was
+     * cancelled yet.
+     */
+    inline bool isCancelled() const {
+        return _cancelled;
+    }
+
+    /**
+     * Discards a previous cancellation request which did not cancel any
+     * job yet.
+     */
+    inline void clearCancellation() {
+        _cancelled = false;
+    }
+
     inline void startingJob(const std::string& jobName,
                             const JobType& type = JobTypeHolder<>::DEFAULT,
                             const std::string& prefix = "") {
+        startingJob(jobName, type, prefix, std::chrono::steady_clock::now());
+    }
 
-        _jobs.push_back(Job(type, jobName));
-
-        if (_verbose) {
-            OStreamConfigRestore osr(std::cout);
-
-            Job& job = _jobs.back();
+    /**
+     * Reports a job which was executed concurrently with other jobs
+     * (e.g. in a worker thread) and which has already completed.
+     * It is registered as a nested job of the currently running job which
+     * started at the provided time and finished now.
+     *
+     * @param jobName the job name
+     * @param type the job type
+     * @param prefix text to print before the job description
+     * @param beginTime the time when the job actually started
+     */
+    inline void completedJob(const std::string& jobName,
+                             const JobType& type,
+                             const std::string& prefix,
+                             std::chrono::steady_clock::time_point beginTime) {
+        startingJob(jobName, type, prefix, beginTime);
+        finishedJob();
+    }
 
-            size_t indent = 0;
-            if (_jobs.size() > 1) {
-                Job& parent = _jobs[_jobs.size() - 2]; // must be after adding job
-                if (!parent._nestedJobs) {
-                    parent._nestedJobs = true;
-                    std::cout << "\n";
-                }
-                indent = _indent * (_jobs.size() - 1);
+    /**
+     * Reports the jobs recorded by a JobRecorder (e.g. executed in a worker
+     * thread) as nested jobs of the currently running job, with their
+     * original starting times and durations.
+     *
+     * @param recorder the recorded jobs (all recorded jobs must have ended)
+     */
+    inline void replayJobs(const JobRecorder& recorder) {
+        for (const JobRecorder::Event& e : recorder.getEvents()) {
+            const Job& job = e.job;
+            if (!e.ended) {
+                startingJob(job.name(), job.getType(), "", job.beginTime());
+            } else {
+                finishedJob(job.beginTime() + e.elapsed);
             }
-
-            _os.str("");
-            if (indent > 0) _os << std::string(indent, ' ');
-            if (!prefix.empty()) _os << prefix << " ";
-            _os << type.getActionName() << " " << job.name() << " ...";
-
-            char f = std::cout.fill();
-            std::cout << std::setw(_maxLineWidth) << std::setfill('.') << std::left << _os.str();
-            std::cout.flush();
-            std::cout.fill(f); // restore fill character
-        }
-
-        // notify listeners
-        for (JobListener* l : _listeners) {
-            l->jobStarted(_jobs);
         }
     }
 
     inline void finishedJob() {
+        finishedJob(std::chrono::steady_clock::now());
+    }
+
+private:
+
+    inline void finishedJob(std::chrono::steady_clock::time_point endTime) {
         using namespace std::chrono;
 
         CPPADCG_ASSERT_UNKNOWN(_jobs.size() > 0);
 
         Job& job = _jobs.back();
 
-        std::chrono::steady_clock::duration elapsed = steady_clock::now() - job.beginTime();
+        std::chrono::steady_clock::duration elapsed = endTime - job.beginTime();
 
         if (_verbose) {
             OStreamConfigRestore osr(std::cout);
@@ -329,6 +419,50 @@ public:
         _jobs.pop_back();
     }
 
+    inline void startingJob(const std::string& jobName,
+                            const JobType& type,
+                            const std::string& prefix,
+                            std::chrono::steady_clock::time_point beginTime) {
+
+        if (_cancelled.exchange(false)) {
+            _jobs.clear();
+            throw CGCancelledException("Cancelled before ", type.getActionName(), " ", jobName);
+        }
+
+        _jobs.push_back(Job(type, jobName, beginTime));
+
+        if (_verbose) {
+            OStreamConfigRestore osr(std::cout);
+
+            Job& job = _jobs.back();
+
+            size_t indent = 0;
+            if (_jobs.size() > 1) {
+                Job& parent = _jobs[_jobs.size() - 2]; // must be after adding job
+                if (!parent._nestedJobs) {
+                    parent._nestedJobs = true;
+                    std::cout << "\n";
+                }
+                indent = _indent * (_jobs.size() - 1);
+            }
+
+            _os.str("");
+            if (indent > 0) _os << std::string(indent, ' ');
+            if (!prefix.empty()) _os << prefix << " ";
+            _os << type.getActionName() << " " << job.name() << " ...";
+
+            char f = std::cout.fill();
+            std::cout << std::setw(_maxLineWidth) << std::setfill('.') << std::left << _os.str();
+            std::cout.flush();
+            std::cout.fill(f); // restore fill character
+        }
+
+        // notify listeners
+        for (JobListener* l : _listeners) {
+            l->jobStarted(_jobs);
+        }
+    }
+
 };
 
 } // END cg namespace
@@ -0,0 +1,187 @@
+#ifndef CPPAD_CG_LANG_C_BATCH_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_BATCH_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for source code which evaluates the same
+ * operations at several points.
+ * The operations are placed inside a loop over the points and the
+ * independent and dependent arrays use a structure-of-arrays layout
+ * (e.g. x[j * nPoints + p] is the independent variable j at point p).
+ * Temporary variables are scalars so that the C compiler can keep them in
+ * registers and vectorize the loop.
+ *
+ * Loops and atomic functions are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCBatchVariableNameGenerator : public LangCDefaultVariableNameGenerator<Base> {
+protected:
+    // the name of the function argument with the number of points
+    std::string _nPointsName;
+    // the name of the index of the current point
+    std::string _pointName;
+    // array name of the equation multipliers (Hessians only)
+    std::string _multName;
+    // the lowest variable ID used for the equation multipliers
+    size_t _minMultiplierID;
+public:
+
+    /**
+     * @param nPointsName the name of the function argument with the number
+     *                    of points (it must be declared as a function index
+     *                    argument in the language)
+     * @param depName array name of the dependent variables
+     * @param indepName array name of the independent variables
+     * @param tmpName name prefix of the temporary variables
+     * @param pointName the name of the index of the current point
+     */
+    inline explicit LangCBatchVariableNameGenerator(std::string nPointsName = "nPoints",
+                                                    std::string depName = "y",
+                                                    std::string indepName = "x",
+                                                    std::string tmpName = "v",
+                                                    std::string pointName = "p") :
+        LangCDefaultVariableNameGenerator<Base>(std::move(depName), std::move(indepName), std::move(tmpName)),
+        _nPointsName(std::move(nPointsName)),
+        _pointName(std::move(pointName)),
+        _minMultiplierID((std::numeric_limits<size_t>::max)()) {
+        this->_temporary[0].array = false;
+    }
+
+    inline virtual ~LangCBatchVariableNameGenerator() = default;
+
+    /**
+     * Defines that the independent variables registered after the first n
+     * are equation multipliers (used for Hessians) provided by a second
+     * input array.
+     *
+     * @param multName array name of the equation multipliers
+     * @param n the number of independent variables (excluding multipliers)
+     */
+    inline void setMultipliers(const std::string& multName,
+                               size_t n) {
+        CPPADCG_ASSERT_KNOWN(!multName.empty(), "The name for the multipliers must not be empty")
+        CPPADCG_ASSERT_KNOWN(this->_independent.size() == 1, "Multipliers already defined")
+
+        _multName = multName;
+        _minMultiplierID = n + 1;
+        this->_independent.push_back(FuncArgument(_multName));
+    }
+
+    inline const std::string& getNumberOfPointsName() const {
+        return _nPointsName;
+    }
+
+    inline const std::string& getPointName() const {
+        return _pointName;
+    }
+
+    inline std::string generateDependent(size_t index) override {
+        return generateElement(this->_depName, index);
+    }
+
+    inline std::string generateIndependent(const OperationNode<Base>& independent,
+                                           size_t id) override {
+        if (id < _minMultiplierID) {
+            return generateElement(this->_indepName, id - 1);
+        } else {
+            return generateElement(_multName, id - _minMultiplierID);
+        }
+    }
+
+    std::string generateIndexedDependent(const OperationNode<Base>& var,
+                                         size_t id,
+                                         const IndexPattern& ip) override {
+        throw CGException("Loops are not supported in source code for the evaluation of multiple points");
+    }
+
+    std::string generateIndexedIndependent(const OperationNode<Base>& independent,
+                                           size_t id,
+                                           const IndexPattern& ip) override {
+        throw CGException("Loops are not supported in source code for the evaluation of multiple points");
+    }
+
+    const std::string& getIndependentArrayName(const OperationNode<Base>& indep,
+                                               size_t id) override {
+        if (id < _minMultiplierID)
+            return this->_indepName;
+        else
+            return _multName;
+    }
+
+    size_t getIndependentArrayIndex(const OperationNode<Base>& indep,
+                                    size_t id) override {
+        if (id < _minMultiplierID)
+            return id - 1;
+        else
+            return id - _minMultiplierID;
+    }
+
+    bool isConsecutiveInIndepArray(const OperationNode<Base>& indepFirst,
+                                   size_t idFirst,
+                                   const OperationNode<Base>& indepSecond,
+                                   size_t idSecond) override {
+        return false; // values from the same point are not contiguous
+    }
+
+    bool isInSameIndependentArray(const OperationNode<Base>& indep1,
+                                  size_t id1,
+                                  const OperationNode<Base>& indep2,
+                                  size_t id2) override {
+        return (id1 < _minMultiplierID) == (id2 < _minMultiplierID);
+    }
+
+    void customFunctionVariableDeclarations(std::ostream& out) override {
+        out << "   " << LanguageC<Base>::U_INDEX_TYPE << " " << _pointName << ";\n";
+    }
+
+    void prepareCustomFunctionVariables(std::ostream& out) override {
+        // there is no aliasing between iterations
+        out << "#if defined(__GNUC__) && !defined(__clang__)\n"
+               "#pragma GCC ivdep\n"
+               "#endif\n";
+        out << "   for(" << _pointName << " = 0; " << _pointName << " < " << _nPointsName << "; " << _pointName << "++) {\n";
+    }
+
+    void finalizeCustomFunctionVariables(std::ostream& out) override {
+        out << "   }\n";
+    }
+
+protected:
+
+    inline std::string generateElement(const std::string& array,
+                                       size_t index) {
+        this->_ss.clear();
+        this->_ss.str("");
+
+        this->_ss << array << "[";
+        if (index > 0)
+            this->_ss << index << " * " << _nPointsName << " + ";
+        this->_ss << _pointName << "]";
+
+        return this->_ss.str();
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -97,8 +97,10 @@ protected:
     size_t _maxAssignmentsPerFunction;
     // the maximum number of operations per variable assignment
     size_t _maxOperationsPerAssignment;
-    //  maps file names to with their contents
-    std::map<std::string, std::string>* _sources;
+    // receives the generated files (file names and their contents)
+    SourceSink* _sources;
+    // used when the files are placed in a map
+    std::unique_ptr<SourceMapSink> _sourcesMap;
     // the values in the temporary array
     std::vector<const Arg*> _tmpArrayValues;
     // the values in the temporary sparse array
@@ -110,6 +112,10 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // whether or not the temporary arrays are placed in a per-thread workspace instead of the stack
+    bool _temporariesInWorkspace;
+    // the number of bytes required by the temporary arrays of the last generated function
+    size_t _workspaceSize;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -142,7 +148,9 @@ public:
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _temporariesInWorkspace(false),
+        _workspaceSize(0) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -238,6 +246,46 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Whether or not the temporary arrays are declared as static thread
+     * local variables (a per-thread workspace) instead of being
+     * allocated in the stack.
+     *
+     * @return true if the temporary arrays are placed in a per-thread
+     *         workspace
+     */
+    inline bool isTemporariesInWorkspace() const {
+        return _temporariesInWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays should be declared as
+     * static thread local variables (a per-thread workspace) instead of
+     * being allocated in the stack.
+     * This avoids stack overflows for very large models which require
+     * many temporary variables but a generated function cannot be called
+     * recursively from the same thread (e.g. through an atomic function).
+     * The generated code requires a C11 compiler (_Thread_local).
+     *
+     * @param inWorkspace true to place the temporary arrays in a per-thread
+     *                    workspace
+     */
+    inline void setTemporariesInWorkspace(bool inWorkspace) {
+        _temporariesInWorkspace = inWorkspace;
+    }
+
+    /**
+     * Provides the number of bytes used by the temporary arrays in the last
+     * generated function (either in the stack or in the per-thread
+     * workspace).
+     * Temporary variables which are not saved in arrays are not included.
+     *
+     * @return the size of the workspace in bytes
+     */
+    inline size_t getWorkspaceSize() const {
+        return _workspaceSize;
+    }
+
     /**
      * Defines the maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -251,6 +299,22 @@ public:
      */
     virtual void setMaxAssignmentsPerFunction(size_t maxAssignmentsPerFunction,
                                               std::map<std::string, std::string>* sources) {
+        _sourcesMap.reset(sources != nullptr ? new SourceMapSink(*sources) : nullptr);
+        setMaxAssignmentsPerFunction(maxAssignmentsPerFunction, _sourcesMap.get());
+    }
+
+    /**
+     * Defines the maximum number of assignment per generated function.
+     * Zero means it is disabled (no limit).
+     * Each file is provided to the sink as soon as it is complete.
+     *
+     * @param maxAssignmentsPerFunction the maximum number of assignments per file/function
+     * @param sources Receives the generated files.
+     */
+    virtual void setMaxAssignmentsPerFunction(size_t maxAssignmentsPerFunction,
+                                              SourceSink* sources) {
+        if (_sourcesMap != nullptr && sources != _sourcesMap.get())
+            _sourcesMap.reset();
         _maxAssignmentsPerFunction = maxAssignmentsPerFunction;
         _sources = sources;
     }
@@ -317,6 +381,9 @@ public:
         CPPADCG_ASSERT_KNOWN(tmpArg.size() == 3,
                              "There must be two temporary variables")
 
+        // storage of the temporary arrays
+        const char* storage = _temporariesInWorkspace ? "static _Thread_local " : "";
+
         _ss << _spaces << "// auxiliary variables\n";
         /**
          * temporary variables
@@ -324,7 +391,7 @@ public:
         if (tmpArg[0].array) {
             size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
             if (size > 0 || isWrapperFunction) {
-                _ss << _spaces << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
+                _ss << _spaces << storage << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
             }
         } else if (_temporary.size() > 0) {
             for (const std::pair<size_t, Node*>& p : _temporary) {
@@ -350,7 +417,7 @@ public:
          */
         size_t arraySize = _nameGen->getMaxTemporaryArrayVariableID();
         if (arraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[1].name << "[" << arraySize << "];\n";
+            _ss << _spaces << storage << _baseTypeName << " " << tmpArg[1].name << "[" << arraySize << "];\n";
         }
 
         /**
@@ -358,8 +425,8 @@ public:
          */
         size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
         if (sArraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[2].name << "[" << sArraySize << "];\n";
-            _ss << _spaces << U_INDEX_TYPE << " " << _C_SPARSE_INDEX_ARRAY << "[" << sArraySize << "];\n";
+            _ss << _spaces << storage << _baseTypeName << " " << tmpArg[2].name << "[" << sArraySize << "];\n";
+            _ss << _spaces << storage << U_INDEX_TYPE << " " << _C_SPARSE_INDEX_ARRAY << "[" << sArraySize << "];\n";
         }
 
         if (!isWrapperFunction) {
@@ -386,6 +453,37 @@ public:
         return code;
     }
 
+    /**
+     * Determines the number of bytes required by the temporary arrays
+     * declared by generateTemporaryVariableDeclaration().
+     *
+     * @return the size of the workspace in bytes
+     */
+    virtual size_t determineWorkspaceSize() const {
+        CPPADCG_ASSERT_UNKNOWN(_nameGen != nullptr);
+
+        const std::vector<FuncArgument>& tmpArg = _nameGen->getTemporary();
+
+        size_t size = 0;
+        if (tmpArg[0].array) {
+            size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
+        }
+        size += _nameGen->getMaxTemporaryArrayVariableID();
+
+        size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
+        size += sArraySize;
+
+        return size * getBaseTypeSize() + sArraySize * sizeof(unsigned long);
+    }
+
+    /**
+     * @return the number of bytes of a variable with the base type used in
+     *         the generated source code
+     */
+    virtual size_t getBaseTypeSize() const {
+        return sizeof(Base);
+    }
+
     inline void generateArrayContainersDeclaration(std::ostringstream& ss,
                                                    const std::vector<int>& atomicMaxForward,
                                                    const std::vector<int>& atomicMaxReverse) {
@@ -561,7 +659,7 @@ public:
     }
 
     static inline void printIndexCondExpr(std::ostringstream& out,
-                                          const std::vector<size_t>& info,
+                                          ArrayView<const size_t> info,
                                           const std::string& index) {
         CPPADCG_ASSERT_KNOWN(info.size() > 1 && info.size() % 2 == 0, "Invalid number of information elements for an index condition expression operation")
 
@@ -736,6 +834,8 @@ protected:
         CPPADCG_ASSERT_KNOWN(tmpArg.size() == 3,
                              "There must be three temporary variables")
 
+        _workspaceSize = determineWorkspaceSize();
+
         if (createFunction) {
             funcArgDcl_ = generateFunctionArgumentsDcl2();
 
@@ -864,7 +964,7 @@ protected:
             CPPADCG_ASSERT_KNOWN(tmpArg[0].array,
                                  "The temporary variables must be saved in an array in order to generate multiple functions")
 
-            _code << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+            printSourceFileHeader(_code);
             // forward declarations
             std::string localFuncArgDcl2 = implode(localFuncArgDcl_, ", ");
             for (auto & localFuncName : localFuncNames) {
@@ -927,9 +1027,7 @@ protected:
          */
         if (createFunction) {
             if (localFuncNames.empty()) {
-                _ss << "#include <math.h>\n"
-                        "#include <stdio.h>\n\n"
-                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                printSourceFileHeader(_ss);
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -946,13 +1044,13 @@ protected:
                 out << _ss.str();
 
                 if (_sources != nullptr) {
-                    (*_sources)[_functionName + ".c"] = _ss.str();
+                    _sources->addSource(_functionName + ".c", _ss.str());
                 }
             } else {
                 _nameGen->finalizeCustomFunctionVariables(_code);
                 _code << "}\n\n";
 
-                (*_sources)[_functionName + ".c"] = _code.str();
+                _sources->addSource(_functionName + ".c", _code.str());
             }
         } else {
             out << _code.str();
@@ -1037,6 +1135,16 @@ protected:
         _streamStack << ";\n";
     }
 
+    /**
+     * Writes the source code placed at the beginning of each generated
+     * source file (includes and type definitions).
+     */
+    virtual void printSourceFileHeader(std::ostream& out) {
+        out << "#include <math.h>\n"
+               "#include <stdio.h>\n\n"
+            << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    }
+
     virtual std::string argumentDeclaration(const FuncArgument& funcArg) const {
         std::string dcl = _baseTypeName;
         if (funcArg.array) {
@@ -1051,9 +1159,7 @@ protected:
         std::string funcName = _ss.str();
         _ss.str("");
 
-        _ss << "#include <math.h>\n"
-                "#include <stdio.h>\n\n"
-                << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+        printSourceFileHeader(_ss);
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1081,7 +1187,7 @@ protected:
         _nameGen->finalizeCustomFunctionVariables(_ss);
         _ss << "}\n\n";
 
-        (*_sources)[funcName + ".c"] = _ss.str();
+        _sources->addSource(funcName + ".c", _ss.str());
         localFuncNames.push_back(funcName);
 
         _code.str("");
@@ -1706,7 +1812,7 @@ protected:
         replaceString(after, "\"", "\\\"");
 
         _streamStack <<_indentation << "fprintf(stderr, \"" << before << getPrintfBaseFormat() << after << "\"";
-        const std::vector<Arg>& args = pnode.getArguments();
+        const ArenaVector<Arg>& args = pnode.getArguments();
         for (size_t a = 0; a < args.size(); a++) {
             _streamStack << ", ";
             push(args[a]);
@@ -1717,7 +1823,7 @@ protected:
     virtual void pushConditionalAssignment(Node& node) {
         CPPADCG_ASSERT_UNKNOWN(getVariableID(node) > 0)
 
-        const std::vector<Arg>& args = node.getArguments();
+        const ArenaVector<Arg>& args = node.getArguments();
         const Arg &left = args[0];
         const Arg &right = args[1];
         const Arg &trueCase = args[2];
@@ -1793,7 +1899,7 @@ protected:
         int q = atomicFor.getInfo()[1];
         int p = atomicFor.getInfo()[2];
         size_t p1 = p + 1;
-        const std::vector<Arg>& opArgs = atomicFor.getArguments();
+        const ArenaVector<Arg>& opArgs = atomicFor.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 2, "Invalid number of arguments for atomic forward operation")
 
         size_t id = atomicFor.getInfo()[0];
@@ -1834,7 +1940,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(atomicRev.getInfo().size() == 2, "Invalid number of information elements for atomic reverse operation")
         int p = atomicRev.getInfo()[1];
         size_t p1 = p + 1;
-        const std::vector<Arg>& opArgs = atomicRev.getArguments();
+        const ArenaVector<Arg>& opArgs = atomicRev.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 4, "Invalid number of arguments for atomic reverse operation")
 
         size_t id = atomicRev.getInfo()[0];
@@ -1882,7 +1988,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::DependentMultiAssign, "Invalid node type")
         CPPADCG_ASSERT_KNOWN(node.getArguments().size() > 0, "Invalid number of arguments")
 
-        const std::vector<Arg>& args = node.getArguments();
+        const ArenaVector<Arg>& args = node.getArguments();
         for (size_t a = 0; a < args.size(); a++) {
             bool useArg;
             const Arg& arg = args[a];
@@ -1988,7 +2094,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation() != nullptr, "Invalid argument for an index condition expression operation")
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation()->getOperationType() == CGOpCode::Index, "Invalid argument for an index condition expression operation")
 
-        const std::vector<size_t>& info = node.getInfo();
+        const ArenaVector<size_t>& info = node.getInfo();
 
         auto& iterationIndexOp = static_cast<IndexOperationNode<Base>&> (*node.getArguments()[0].getOperation());
         const std::string& index = *iterationIndexOp.getIndex().getName();
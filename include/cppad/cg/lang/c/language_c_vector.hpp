@@ -0,0 +1,353 @@
+#ifndef CPPAD_CG_LANGUAGE_C_VECTOR_INCLUDED
+#define CPPAD_CG_LANGUAGE_C_VECTOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Generates C source code where every value is a fixed-width vector
+ * (GCC/clang vector extensions) so that a single call evaluates the model
+ * at several independent points (one per vector element/lane).
+ *
+ * The arrays of independent and dependent variables contain one vector per
+ * variable: the value of variable j at the lane k is x[j * width + k] when
+ * the arrays are seen as arrays of scalars.
+ * Conditional expressions are converted into blend operations and
+ * mathematical functions are applied to each lane.
+ *
+ * Atomic functions, print operations and branches (if/else) are not
+ * supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LanguageCVector : public LanguageC<Base> {
+public:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    // the type name of each element (e.g. "double")
+    const std::string _scalarTypeName;
+    // the number of elements in the vector type
+    const size_t _width;
+    // a signed integer type with the same size as the scalar type
+    const std::string _maskElementTypeName;
+    // the type name used for comparison results
+    const std::string _maskTypeName;
+public:
+
+    /**
+     * Creates a C language source code generator for vector types
+     *
+     * @param scalarTypeName the data type of each element (e.g. double)
+     * @param width the number of elements in each vector (e.g. 4 for AVX2
+     *              and doubles)
+     * @param spaces number of spaces for indentations
+     */
+    explicit LanguageCVector(const std::string& scalarTypeName,
+                             size_t width,
+                             size_t spaces = 3) :
+        LanguageC<Base>(createVectorTypeName(scalarTypeName, width), spaces),
+        _scalarTypeName(scalarTypeName),
+        _width(width),
+        _maskElementTypeName(sizeof(Base) == 8 ? "long long" : "int"),
+        _maskTypeName(this->_baseTypeName + "_mask") {
+        CPPADCG_ASSERT_KNOWN(width > 0 && (width & (width - 1)) == 0, "The vector width must be a power of 2")
+        CPPADCG_ASSERT_KNOWN(sizeof(Base) == 8 || sizeof(Base) == 4, "Unsupported scalar type size for vectors")
+    }
+
+    inline virtual ~LanguageCVector() = default;
+
+    /**
+     * Provides the name of the vector type (e.g. "double_v4")
+     */
+    inline const std::string& getVectorTypeName() const {
+        return this->_baseTypeName;
+    }
+
+    inline const std::string& getScalarTypeName() const {
+        return _scalarTypeName;
+    }
+
+    /**
+     * Provides the number of elements (points) in each vector
+     */
+    inline size_t getVectorWidth() const {
+        return _width;
+    }
+
+    size_t getBaseTypeSize() const override {
+        return _width * sizeof(Base);
+    }
+
+    /**
+     * Generates the definition of the vector types and of the helper
+     * functions used by the generated source code.
+     */
+    virtual std::string generateVectorTypeDefinitions() {
+        const std::string& vt = this->_baseTypeName;
+        const std::string& st = _scalarTypeName;
+        std::string guard = "CPPADCG_" + vt + "_DEFINED";
+        for (char& c : guard)
+            c = char(std::toupper(c));
+
+        std::ostringstream out;
+        out << "#ifndef " << guard << "\n"
+               "#define " << guard << "\n"
+               "#if defined(__GNUC__) && !defined(__clang__)\n"
+               "#pragma GCC diagnostic ignored \"-Wpsabi\"\n" // vectors are passed to static functions only
+               "#endif\n"
+               "typedef " << st << " " << vt << " __attribute__((vector_size(" << (_width * sizeof(Base)) << "), aligned(" << sizeof(Base) << ")));\n"
+               "typedef " << _maskElementTypeName << " " << _maskTypeName << " __attribute__((vector_size(" << (_width * sizeof(Base)) << ")));\n\n";
+
+        // broadcast
+        out << "static inline " << vt << " " << vt << "_set(" << st << " a) {\n"
+               "   " << vt << " r = {";
+        for (size_t k = 0; k < _width; ++k) {
+            if (k > 0) out << ", ";
+            out << "a";
+        }
+        out << "};\n"
+               "   return r;\n"
+               "}\n\n";
+
+        // select
+        out << "static inline " << vt << " " << vt << "_blend(" << _maskTypeName << " m, " << vt << " t, " << vt << " f) {\n"
+               "   return (" << vt << ") (((" << _maskTypeName << ") t & m) | ((" << _maskTypeName << ") f & ~m));\n"
+               "}\n\n";
+
+        // functions applied to each element
+        for (const std::string& fn : getElementFunctionNames()) {
+            out << "static inline " << vt << " " << vt << "_" << fn << "(" << vt << " a) {\n"
+                   "   " << vt << " r;\n"
+                   "   int k;\n"
+                   "   for(k = 0; k < " << _width << "; k++) r[k] = " << fn << "(a[k]);\n"
+                   "   return r;\n"
+                   "}\n\n";
+        }
+
+        const std::string& pow = LanguageC<Base>::powFuncName();
+        out << "static inline " << vt << " " << vt << "_" << pow << "(" << vt << " a, " << vt << " b) {\n"
+               "   " << vt << " r;\n"
+               "   int k;\n"
+               "   for(k = 0; k < " << _width << "; k++) r[k] = " << pow << "(a[k], b[k]);\n"
+               "   return r;\n"
+               "}\n\n";
+
+        out << "static inline " << vt << " " << vt << "_sign(" << vt << " a) {\n"
+               "   " << vt << " zero = " << vt << "_set(0);\n"
+               "   return " << vt << "_blend((" << _maskTypeName << ") (a > zero), " << vt << "_set(1),\n"
+               "          " << vt << "_blend((" << _maskTypeName << ") (a < zero), " << vt << "_set(-1), zero));\n"
+               "}\n"
+               "#endif\n\n";
+
+        return out.str();
+    }
+
+protected:
+
+    void printSourceFileHeader(std::ostream& out) override {
+        out << "#include <math.h>\n"
+               "#include <stdio.h>\n\n"
+            << generateVectorTypeDefinitions()
+            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    }
+
+    void pushUnaryFunction(Node& op) override {
+        CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for unary function")
+
+        this->_streamStack << this->_baseTypeName << "_" << getElementFunctionName(op.getOperationType()) << "(";
+        this->push(op.getArguments()[0]);
+        this->_streamStack << ")";
+    }
+
+    void pushPowFunction(Node& op) override {
+        CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for pow() function")
+
+        this->_streamStack << this->_baseTypeName << "_" << LanguageC<Base>::powFuncName() << "(";
+        this->push(op.getArguments()[0]);
+        this->_streamStack << ", ";
+        this->push(op.getArguments()[1]);
+        this->_streamStack << ")";
+    }
+
+    void pushSignFunction(Node& op) override {
+        CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for sign() function")
+
+        this->_streamStack << this->_baseTypeName << "_sign(";
+        this->push(op.getArguments()[0]);
+        this->_streamStack << ")";
+    }
+
+    void pushConditionalAssignment(Node& node) override {
+        const ArenaVector<Arg>& args = node.getArguments();
+        const Arg &left = args[0];
+        const Arg &right = args[1];
+        const Arg &trueCase = args[2];
+        const Arg &falseCase = args[3];
+
+        if (this->isSameArgument(trueCase, &falseCase)) {
+            // true and false cases are the same
+            LanguageC<Base>::pushConditionalAssignment(node);
+            return;
+        }
+
+        bool isDep = this->isDependent(node);
+        const std::string& varName = this->createVariableName(node);
+
+        // all lanes are evaluated and the results selected with a mask
+        this->pushAssignmentStart(node, varName, isDep);
+        this->_streamStack << this->_baseTypeName << "_blend((" << _maskTypeName << ") (";
+        this->push(left);
+        this->_streamStack << " " << this->getComparison(node.getOperationType()) << " ";
+        this->push(right);
+        this->_streamStack << "), ";
+        this->push(trueCase);
+        this->_streamStack << ", ";
+        this->push(falseCase);
+        this->_streamStack << ")";
+        this->pushAssignmentEnd(node);
+    }
+
+    void pushPrintOperation(const Node& node) override {
+        throw CGException("Print operations are not supported for vector types");
+    }
+
+    void pushIndexCondExprOp(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushStartIf(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushElseIf(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushElse(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushEndIf(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushCondResult(Node& node) override {
+        throw CGException("Branches are not supported for vector types");
+    }
+
+    void pushAtomicForwardOp(Node& atomicFor) override {
+        throw CGException("Atomic functions are not supported for vector types");
+    }
+
+    void pushAtomicReverseOp(Node& atomicRev) override {
+        throw CGException("Atomic functions are not supported for vector types");
+    }
+
+    void printParameter(const Base& value) override {
+        this->_code << this->_baseTypeName << "_set(";
+        this->writeParameter(value, this->_code);
+        this->_code << ")";
+    }
+
+    void pushParameter(const Base& value) override {
+        this->_streamStack << this->_baseTypeName << "_set(";
+        this->writeParameter(value, this->_streamStack);
+        this->_streamStack << ")";
+    }
+
+    /**
+     * Provides the name of the scalar C function applied to each element
+     * for an unary operation.
+     */
+    virtual const std::string& getElementFunctionName(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::Abs:
+                return LanguageC<Base>::absFuncName();
+            case CGOpCode::Acos:
+                return LanguageC<Base>::acosFuncName();
+            case CGOpCode::Asin:
+                return LanguageC<Base>::asinFuncName();
+            case CGOpCode::Atan:
+                return LanguageC<Base>::atanFuncName();
+            case CGOpCode::Cosh:
+                return LanguageC<Base>::coshFuncName();
+            case CGOpCode::Cos:
+                return LanguageC<Base>::cosFuncName();
+            case CGOpCode::Exp:
+                return LanguageC<Base>::expFuncName();
+            case CGOpCode::Log:
+                return LanguageC<Base>::logFuncName();
+            case CGOpCode::Sinh:
+                return LanguageC<Base>::sinhFuncName();
+            case CGOpCode::Sin:
+                return LanguageC<Base>::sinFuncName();
+            case CGOpCode::Sqrt:
+                return LanguageC<Base>::sqrtFuncName();
+            case CGOpCode::Tanh:
+                return LanguageC<Base>::tanhFuncName();
+            case CGOpCode::Tan:
+                return LanguageC<Base>::tanFuncName();
+#if CPPAD_USE_CPLUSPLUS_2011
+            case CGOpCode::Erf:
+                return LanguageC<Base>::erfFuncName();
+            case CGOpCode::Erfc:
+                return LanguageC<Base>::erfcFuncName();
+            case CGOpCode::Asinh:
+                return LanguageC<Base>::asinhFuncName();
+            case CGOpCode::Acosh:
+                return LanguageC<Base>::acoshFuncName();
+            case CGOpCode::Atanh:
+                return LanguageC<Base>::atanhFuncName();
+            case CGOpCode::Expm1:
+                return LanguageC<Base>::expm1FuncName();
+            case CGOpCode::Log1p:
+                return LanguageC<Base>::log1pFuncName();
+#endif
+            default:
+                throw CGException("Unknown function name for operation code '", op, "'.");
+        }
+    }
+
+    inline std::vector<std::string> getElementFunctionNames() {
+        std::vector<CGOpCode> ops{CGOpCode::Abs, CGOpCode::Acos, CGOpCode::Asin, CGOpCode::Atan,
+                                  CGOpCode::Cosh, CGOpCode::Cos, CGOpCode::Exp, CGOpCode::Log,
+                                  CGOpCode::Sinh, CGOpCode::Sin, CGOpCode::Sqrt, CGOpCode::Tanh,
+                                  CGOpCode::Tan};
+#if CPPAD_USE_CPLUSPLUS_2011
+        ops.insert(ops.end(), {CGOpCode::Erf, CGOpCode::Erfc, CGOpCode::Asinh, CGOpCode::Acosh,
+                               CGOpCode::Atanh, CGOpCode::Expm1, CGOpCode::Log1p});
+#endif
+        std::vector<std::string> names;
+        names.reserve(ops.size());
+        for (CGOpCode op : ops)
+            names.push_back(getElementFunctionName(op));
+        return names;
+    }
+
+    static inline std::string createVectorTypeName(const std::string& scalarTypeName,
+                                                   size_t width) {
+        return scalarTypeName + "_v" + std::to_string(width);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
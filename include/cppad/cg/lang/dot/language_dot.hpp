@@ -166,7 +166,7 @@ public:
      *                               STATIC
      **************************************************************************/
     static inline void printIndexCondExpr(std::ostringstream& out,
-                                          const std::vector<size_t>& info,
+                                          ArrayView<const size_t> info,
                                           const std::string& index) {
         CPPADCG_ASSERT_KNOWN(info.size() > 1 && info.size() % 2 == 0, "Invalid number of information elements for an index condition expression operation")
 
@@ -997,7 +997,7 @@ protected:
     virtual std::string printConditionalAssignment(OperationNode<Base>& node) {
         CPPADCG_ASSERT_UNKNOWN(getVariableID(node) > 0)
 
-        const std::vector<Argument<Base> >& args = node.getArguments();
+        const ArenaVector<Argument<Base> >& args = node.getArguments();
         const Argument<Base>& left = args[0];
         const Argument<Base>& right = args[1];
         const Argument<Base>& trueCase = args[2];
@@ -1035,7 +1035,7 @@ protected:
         int q = atomicFor.getInfo()[1];
         int p = atomicFor.getInfo()[2];
         size_t p1 = p + 1;
-        const std::vector<Argument<Base> >& opArgs = atomicFor.getArguments();
+        const ArenaVector<Argument<Base> >& opArgs = atomicFor.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 2, "Invalid number of arguments for atomic forward operation")
 
         size_t id = atomicFor.getInfo()[0];
@@ -1076,7 +1076,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(atomicRev.getInfo().size() == 2, "Invalid number of information elements for atomic reverse operation")
         int p = atomicRev.getInfo()[1];
         size_t p1 = p + 1;
-        const std::vector<Argument<Base> >& opArgs = atomicRev.getArguments();
+        const ArenaVector<Argument<Base> >& opArgs = atomicRev.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 4, "Invalid number of arguments for atomic reverse operation")
 
         size_t id = atomicRev.getInfo()[0];
@@ -1132,7 +1132,7 @@ protected:
 
         std::string name = printNodeDeclaration(node, "+=");
 
-        const std::vector<Argument<Base> >& args = node.getArguments();
+        const ArenaVector<Argument<Base> >& args = node.getArguments();
         for (size_t a = 0; a < args.size(); a++) {
             bool useArg = false;
             const Argument<Base>& arg = args[a];
@@ -1286,7 +1286,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation() != nullptr, "Invalid argument for an index condition expression operation")
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation()->getOperationType() == CGOpCode::Index, "Invalid argument for an index condition expression operation")
 
-        const std::vector<size_t>& info = node.getInfo();
+        const ArenaVector<size_t>& info = node.getInfo();
 
         auto& iterationIndexOp = static_cast<IndexOperationNode<Base>&> (*node.getArguments()[0].getOperation());
         const std::string& index = *iterationIndexOp.getIndex().getName();
@@ -22,7 +22,7 @@ namespace cg {
 template<class Base>
 std::string LanguageDot<Base>::printArrayCreationOp(OperationNode<Base>& array) {
     CPPADCG_ASSERT_KNOWN(array.getArguments().size() > 0, "Invalid number of arguments for array creation operation")
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
 
     _ss.str("");
@@ -52,10 +52,10 @@ std::string LanguageDot<Base>::printArrayCreationOp(OperationNode<Base>& array)
 template<class Base>
 std::string LanguageDot<Base>::printSparseArrayCreationOp(OperationNode<Base>& array) {
 
-    const std::vector<size_t>& info = array.getInfo();
+    const ArenaVector<size_t>& info = array.getInfo();
     CPPADCG_ASSERT_KNOWN(!info.empty(), "Invalid number of information elements for sparse array creation operation")
 
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
 
     CPPADCG_ASSERT_KNOWN(info.size() == argSize + 1, "Invalid number of arguments for sparse array creation operation")
@@ -93,7 +93,7 @@ inline size_t LanguageDot<Base>::printArrayCreationUsingLoop(const std::string&
                                                              size_t starti,
                                                              const size_t* indexes) {
 
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
     size_t i = starti + 1;
 
@@ -268,7 +268,7 @@ protected:
 
     static inline std::vector<const OperationNode<Base>*> getIndexes(const OperationNode<Base>& var,
                                                                      size_t offset = 0) {
-        const std::vector<Argument<Base> >& args = var.getArguments();
+        const ArenaVector<Argument<Base> >& args = var.getArguments();
         std::vector<const OperationNode<Base>*> indexes(args.size() - offset);
 
         for (size_t a = offset; a < args.size(); a++) {
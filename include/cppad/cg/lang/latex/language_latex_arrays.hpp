@@ -23,7 +23,7 @@ template<class Base>
 void LanguageLatex<Base>::printArrayCreationOp(OperationNode<Base>& array) {
     CPPADCG_ASSERT_KNOWN(array.getArguments().size() > 0, "Invalid number of arguments for array creation operation")
     const size_t id = getVariableID(array);
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
 
     size_t startPos = id - 1;
@@ -63,10 +63,10 @@ void LanguageLatex<Base>::printArrayCreationOp(OperationNode<Base>& array) {
 
 template<class Base>
 void LanguageLatex<Base>::printSparseArrayCreationOp(OperationNode<Base>& array) {
-    const std::vector<size_t>& info = array.getInfo();
+    const ArenaVector<size_t>& info = array.getInfo();
     CPPADCG_ASSERT_KNOWN(!info.empty(), "Invalid number of information elements for sparse array creation operation")
 
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
 
     CPPADCG_ASSERT_KNOWN(info.size() == argSize + 1, "Invalid number of arguments for sparse array creation operation")
@@ -141,7 +141,7 @@ inline size_t LanguageLatex<Base>::printArrayCreationUsingLoop(size_t startPos,
                                                                OperationNode<Base>& array,
                                                                size_t starti,
                                                                std::vector<const Argument<Base>*>& tmpArrayValues) {
-    const std::vector<Argument<Base> >& args = array.getArguments();
+    const ArenaVector<Argument<Base> >& args = array.getArguments();
     const size_t argSize = args.size();
     size_t i = starti + 1;
 
@@ -462,7 +462,7 @@ public:
      *                               STATIC
      **************************************************************************/
     static inline void printIndexCondExpr(std::ostringstream& out,
-                                          const std::vector<size_t>& info,
+                                          ArrayView<const size_t> info,
                                           const std::string& index) {
         CPPADCG_ASSERT_KNOWN(info.size() > 1 && info.size() % 2 == 0, "Invalid number of information elements for an index condition expression operation")
 
@@ -1635,7 +1635,7 @@ protected:
     virtual void printConditionalAssignment(Node& node) {
         CPPADCG_ASSERT_UNKNOWN(getVariableID(node) > 0)
 
-        const std::vector<Arg>& args = node.getArguments();
+        const ArenaVector<Arg>& args = node.getArguments();
         const Arg &left = args[0];
         const Arg &right = args[1];
         const Arg &trueCase = args[2];
@@ -1721,7 +1721,7 @@ protected:
         int q = atomicFor.getInfo()[1];
         int p = atomicFor.getInfo()[2];
         size_t p1 = p + 1;
-        const std::vector<Arg>& opArgs = atomicFor.getArguments();
+        const ArenaVector<Arg>& opArgs = atomicFor.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 2, "Invalid number of arguments for atomic forward operation")
 
         size_t id = atomicFor.getInfo()[0];
@@ -1763,7 +1763,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(atomicRev.getInfo().size() == 2, "Invalid number of information elements for atomic reverse operation")
         int p = atomicRev.getInfo()[1];
         size_t p1 = p + 1;
-        const std::vector<Arg>& opArgs = atomicRev.getArguments();
+        const ArenaVector<Arg>& opArgs = atomicRev.getArguments();
         CPPADCG_ASSERT_KNOWN(opArgs.size() == p1 * 4, "Invalid number of arguments for atomic reverse operation")
 
         size_t id = atomicRev.getInfo()[0];
@@ -1814,7 +1814,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getOperationType() == CGOpCode::DependentMultiAssign, "Invalid node type")
         CPPADCG_ASSERT_KNOWN(node.getArguments().size() > 0, "Invalid number of arguments")
 
-        const std::vector<Arg>& args = node.getArguments();
+        const ArenaVector<Arg>& args = node.getArguments();
         for (size_t a = 0; a < args.size(); a++) {
             bool useArg;
             const Arg& arg = args[a];
@@ -1923,7 +1923,7 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation() != nullptr, "Invalid argument for an index condition expression operation")
         CPPADCG_ASSERT_KNOWN(node.getArguments()[0].getOperation()->getOperationType() == CGOpCode::Index, "Invalid argument for an index condition expression operation")
 
-        const std::vector<size_t>& info = node.getInfo();
+        const ArenaVector<size_t>& info = node.getInfo();
 
         auto& iterationIndexOp = static_cast<IndexOperationNode<Base>&> (*node.getArguments()[0].getOperation());
         const std::string& index = *iterationIndexOp.getIndex().getName();
@@ -0,0 +1,205 @@
+#ifndef CPPAD_CG_MEMORY_ARENA_INCLUDED
+#define CPPAD_CG_MEMORY_ARENA_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A bump allocator which hands out memory from large blocks.
+ * Individual allocations are never released: all the memory is released
+ * at once with clear() or when the arena is destroyed.
+ * The arena does not call destructors, objects created with placement new
+ * must be destroyed explicitly before the memory is released.
+ *
+ * @author Joao Leal
+ */
+class MemoryArena {
+private:
+    /**
+     * the allocated blocks of memory
+     */
+    std::vector<std::unique_ptr<char[]> > _blocks;
+    /**
+     * the default size of each block
+     */
+    size_t _blockSize;
+    /**
+     * the next free position in the last block
+     */
+    char* _current;
+    /**
+     * the number of free bytes in the last block
+     */
+    size_t _available;
+    /**
+     * the total number of bytes in all blocks
+     */
+    size_t _capacity;
+public:
+
+    inline explicit MemoryArena(size_t blockSize = 64 * 1024) :
+        _blockSize(blockSize),
+        _current(nullptr),
+        _available(0),
+        _capacity(0) {
+        CPPADCG_ASSERT_KNOWN(blockSize > 0, "Invalid memory arena block size")
+    }
+
+    MemoryArena(const MemoryArena& orig) = delete;
+    MemoryArena& operator=(const MemoryArena& rhs) = delete;
+
+    /**
+     * Provides uninitialized memory which remains valid until clear() is
+     * called or the arena is destroyed.
+     *
+     * @param size the number of bytes
+     * @param alignment the required alignment (a power of two not larger
+     *                  than the alignment of std::max_align_t)
+     */
+    inline void* allocate(size_t size,
+                          size_t alignment = alignof(std::max_align_t)) {
+        CPPADCG_ASSERT_UNKNOWN(alignment > 0 && (alignment & (alignment - 1)) == 0)
+        CPPADCG_ASSERT_UNKNOWN(alignment <= alignof(std::max_align_t))
+
+        size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(_current) % alignment) % alignment;
+        if (_current == nullptr || padding + size > _available) {
+            addBlock(std::max(size, _blockSize));
+            padding = 0; // new blocks are always aligned
+        }
+
+        char* p = _current + padding;
+        _current = p + size;
+        _available -= padding + size;
+        return p;
+    }
+
+    /**
+     * Releases all the memory provided by this arena.
+     */
+    inline void clear() {
+        _blocks.clear();
+        _current = nullptr;
+        _available = 0;
+        _capacity = 0;
+    }
+
+    /**
+     * @return the total number of bytes currently reserved by this arena
+     */
+    inline size_t getCapacity() const {
+        return _capacity;
+    }
+
+    inline size_t getBlockSize() const {
+        return _blockSize;
+    }
+
+private:
+
+    inline void addBlock(size_t size) {
+        _blocks.emplace_back(new char[size]);
+        _current = _blocks.back().get();
+        _available = size;
+        _capacity += size;
+    }
+};
+
+/**
+ * A standard library allocator which provides memory from a MemoryArena.
+ * Deallocations are ignored since the memory is only released when the
+ * arena is cleared.
+ * Without an arena the memory is provided by the heap.
+ *
+ * Copies of containers using this allocator (copy construction) always
+ * use the heap so that they can outlive the arena.
+ *
+ * @author Joao Leal
+ */
+template<class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<class U>
+    struct rebind {
+        using other = ArenaAllocator<U>;
+    };
+private:
+    /**
+     * the arena providing the memory (null for the heap)
+     */
+    MemoryArena* _arena;
+public:
+
+    inline ArenaAllocator() noexcept :
+        _arena(nullptr) {
+    }
+
+    inline explicit ArenaAllocator(MemoryArena* arena) noexcept :
+        _arena(arena) {
+    }
+
+    template<class U>
+    inline ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+        _arena(other.getArena()) {
+    }
+
+    inline MemoryArena* getArena() const noexcept {
+        return _arena;
+    }
+
+    inline T* allocate(size_t n) {
+        if (_arena == nullptr)
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    inline void deallocate(T* p, size_t) noexcept {
+        if (_arena == nullptr)
+            ::operator delete(p);
+    }
+
+    inline ArenaAllocator select_on_container_copy_construction() const noexcept {
+        return ArenaAllocator();
+    }
+};
+
+template<class T, class U>
+inline bool operator==(const ArenaAllocator<T>& a1,
+                       const ArenaAllocator<U>& a2) noexcept {
+    return a1.getArena() == a2.getArena();
+}
+
+template<class T, class U>
+inline bool operator!=(const ArenaAllocator<T>& a1,
+                       const ArenaAllocator<U>& a2) noexcept {
+    return a1.getArena() != a2.getArena();
+}
+
+/**
+ * A vector whose elements can be placed in a MemoryArena.
+ */
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
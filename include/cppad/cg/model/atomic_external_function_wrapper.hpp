@@ -39,18 +39,23 @@ public:
         size_t m = ty.size;
         size_t n = tx[0].size;
 
-        CppAD::vector<bool> vx, vy;
+        /**
+         * CppAD::vector (required by atomic_base) allocates memory with
+         * thread_alloc which cannot be used by several threads at the same
+         * time unless CppAD is in parallel mode
+         */
+        std::lock_guard<std::mutex> lock(getMutex());
 
-        convert(tx, libModel._tx, n, p, p + 1);
+        CppAD::vector<bool> vx, vy;
+        CppAD::vector<Base> ltx, lty(m * (p + 1));
 
-        size_t ty_size = m * (p + 1);
-        libModel._ty.resize(ty_size);
+        convert(tx, ltx, n, p, p + 1);
 
-        std::fill(&libModel._ty[0], &libModel._ty[0] + ty_size, Base(0));
+        std::fill(&lty[0], &lty[0] + lty.size(), Base(0));
 
-        bool ret = atomic_->forward(q, p, vx, vy, libModel._tx, libModel._ty);
+        bool ret = atomic_->forward(q, p, vx, vy, ltx, lty);
 
-        convertAdd(libModel._ty, ty, m, p, p);
+        convertAdd(lty, ty, m, p, p);
 
         return ret;
     }
@@ -63,36 +68,45 @@ public:
         size_t m = py[0].size;
         size_t n = tx[0].size;
 
-        convert(tx, libModel._tx, n, p, p + 1);
+        std::lock_guard<std::mutex> lock(getMutex()); // see forward()
+
+        CppAD::vector<Base> ltx, lty(m * (p + 1)), lpx(n * (p + 1)), lpy;
 
-        libModel._ty.resize(m * (p + 1));
-        std::fill(&libModel._ty[0], &libModel._ty[0] + libModel._ty.size(), Base(0));
+        convert(tx, ltx, n, p, p + 1);
 
-        convert(py, libModel._py, m, p, p + 1);
+        std::fill(&lty[0], &lty[0] + lty.size(), Base(0));
 
-        size_t px_size = n * (p + 1);
-        libModel._px.resize(px_size);
+        convert(py, lpy, m, p, p + 1);
 
-        std::fill(&libModel._px[0], &libModel._px[0] + px_size, Base(0));
+        std::fill(&lpx[0], &lpx[0] + lpx.size(), Base(0));
 
 #ifndef NDEBUG
         if (libModel._evalAtomicForwardOne4CppAD) {
             // only required in order to avoid an issue with a validation inside CppAD
             CppAD::vector<bool> vx, vy;
-            if (!atomic_->forward(p, p, vx, vy, libModel._tx, libModel._ty))
+            if (!atomic_->forward(p, p, vx, vy, ltx, lty))
                 return false;
         }
 #endif
 
-        bool ret = atomic_->reverse(p, libModel._tx, libModel._ty, libModel._px, libModel._py);
+        bool ret = atomic_->reverse(p, ltx, lty, lpx, lpy);
 
-        convertAdd(libModel._px, px, n, p, 0); // k=0 for both p=0 and p=1
+        convertAdd(lpx, px, n, p, 0); // k=0 for both p=0 and p=1
 
         return ret;
     }
 
 private:
 
+    /**
+     * @return the mutex used to evaluate the atomic functions of all the
+     *         models one at a time
+     */
+    static inline std::mutex& getMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
     inline void convert(const Array from[],
                         CppAD::vector<Base>& to,
                         size_t n,
@@ -36,8 +36,11 @@ protected:
     std::vector<std::string> _compileFlags;
     std::vector<std::string> _compileLibFlags;
     std::vector<std::string> _linkFlags;
+    std::string _cacheFolder; // folder with previously compiled files (empty if disabled)
+    std::map<std::string, std::string> _cacheKeys; // maps compiled files to their cache keys
     bool _verbose;
     bool _saveToDiskFirst;
+    size_t _jobs; // maximum number of source files compiled simultaneously
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
@@ -45,7 +48,8 @@ public:
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _jobs(std::max<size_t>(1, std::thread::hardware_concurrency())) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -135,6 +139,54 @@ public:
         _verbose = verbose;
     }
 
+    /**
+     * Provides the folder where compiled object files and dynamic
+     * libraries are cached.
+     *
+     * @return the cache folder path (empty if caching is disabled)
+     */
+    const std::string& getCacheFolder() const {
+        return _cacheFolder;
+    }
+
+    /**
+     * Defines a folder where compiled object files and dynamic libraries
+     * are cached.
+     * Files are identified by a hash of the source code, the compiler path,
+     * the compilation/link flags, and the CppADCodeGen version.
+     * Source files which were previously compiled with the same options
+     * are not compiled again and, if all object files of a dynamic library
+     * are found in the cache, the library is not linked again.
+     * The folder can be shared among processes.
+     *
+     * @param cacheFolder path to the cache folder (empty disables caching)
+     */
+    void setCacheFolder(const std::string& cacheFolder) {
+        _cacheFolder = cacheFolder;
+    }
+
+    /**
+     * Provides the maximum number of compiler processes which can be
+     * running simultaneously while compiling source files.
+     *
+     * @return the maximum number of simultaneous compilations
+     */
+    size_t getCompileJobs() const {
+        return _jobs;
+    }
+
+    /**
+     * Defines the maximum number of compiler processes which can be
+     * running simultaneously while compiling source files.
+     * The default value is the number of hardware threads.
+     *
+     * @param jobs the maximum number of simultaneous compilations
+     *             (1 compiles source files sequentially)
+     */
+    void setCompileJobs(size_t jobs) {
+        _jobs = std::max<size_t>(1, jobs);
+    }
+
     /**
      * Compiles the provided C source code.
      *
@@ -182,63 +234,170 @@ public:
             std::cout << std::endl;
         }
 
-        std::ostringstream os;
-
         if (_saveToDiskFirst) {
             system::createFolder(_sourcesFolder);
         }
 
-        // compile each source code file into a different object file
+        std::vector<std::map<std::string, std::string>::const_iterator> srcs;
+        std::vector<std::string> files; // compiled output files
+        srcs.reserve(sources.size());
+        files.reserve(sources.size());
         for (it = sources.begin(); it != sources.end(); ++it) {
-            count++;
             std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
             outputFiles.insert(file);
+            srcs.push_back(it);
+            files.push_back(std::move(file));
+        }
 
-            steady_clock::time_point beginTime;
-
-            if (timer != nullptr || _verbose) {
-                os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << count
-                        << "/" << sources.size() << "]";
+        size_t nThreads = std::min<size_t>(_jobs, files.size());
+
+        std::mutex mutex; // protects the timer, the standard output and the error
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+
+        auto compile = [&]() {
+            std::ostringstream os;
+
+            while (!failed) {
+                size_t i = next++;
+                if (i >= files.size())
+                    break;
+
+                const std::string& name = srcs[i]->first;
+                const std::string& source = srcs[i]->second;
+                const std::string& file = files[i];
+
+                steady_clock::time_point beginTime = steady_clock::now();
+
+                std::string key;
+                bool cached = false;
+                if (!_cacheFolder.empty()) {
+                    key = createCacheKey(source, posIndepCode, outputExtension);
+                    cached = CompilerCache(_cacheFolder).retrieve(key, file);
+                }
+                const JobType& jobType = cached ? JobTypeHolder<>::REUSING_CACHED : JobTypeHolder<>::COMPILING;
+
+                if (nThreads == 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (timer != nullptr || _verbose) {
+                        os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << (i + 1)
+                                << "/" << sources.size() << "]";
+                    }
+
+                    if (timer != nullptr) {
+                        timer->startingJob("'" + file + "'", jobType, os.str());
+                        os.str("");
+                    } else if (_verbose) {
+                        char f = std::cout.fill();
+                        std::cout << os.str() << " " << jobType.getActionName() << " "
+                                << std::setw(maxsize + 9) << std::setfill('.') << std::left
+                                << ("'" + file + "' ") << " ";
+                        os.str("");
+                        std::cout.flush();
+                        std::cout.fill(f); // restore fill character
+                    }
+                }
+
+                try {
+                    if (_saveToDiskFirst) {
+                        // save a new source file to disk (also when the object file is cached)
+                        std::ofstream sourceFile;
+                        std::string srcfile = system::createPath(_sourcesFolder, name);
+                        sourceFile.open(srcfile.c_str());
+                        sourceFile << source;
+                        sourceFile.close();
+
+                        // compile the file
+                        if (!cached)
+                            compileFile(srcfile, file, posIndepCode);
+                    } else if (!cached) {
+                        // compile without saving the source code to disk
+                        compileSource(source, file, posIndepCode);
+                    }
+
+                    if (!key.empty() && !cached) {
+                        CompilerCache(_cacheFolder).store(key, file);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!failed) {
+                        // stop compiling remaining files as soon as possible
+                        failed = true;
+                        error = std::current_exception();
+                    }
+                    break;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!key.empty()) {
+                    _cacheKeys[file] = key;
+                }
+
+                if (nThreads > 1) {
+                    // the order of completion is not the order of the sources
+                    if (timer != nullptr || _verbose) {
+                        os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << ++count
+                                << "/" << sources.size() << "]";
+                    }
+
+                    if (timer != nullptr) {
+                        try {
+                            timer->completedJob("'" + file + "'", jobType, os.str(), beginTime);
+                        } catch (...) {
+                            // cancelled: must not leave this thread with an exception
+                            if (!failed) {
+                                failed = true;
+                                error = std::current_exception();
+                            }
+                            break;
+                        }
+                        os.str("");
+                        continue;
+                    } else if (_verbose) {
+                        char f = std::cout.fill();
+                        std::cout << os.str() << " " << jobType.getActionName() << " "
+                                << std::setw(maxsize + 9) << std::setfill('.') << std::left
+                                << ("'" + file + "' ") << " ";
+                        os.str("");
+                        std::cout.fill(f); // restore fill character
+                    }
+                }
+
+                if (timer != nullptr) {
+                    timer->finishedJob();
+                } else if (_verbose) {
+                    steady_clock::time_point endTime = steady_clock::now();
+                    duration<float> dt = endTime - beginTime;
+                    std::cout << "done [" << std::fixed << std::setprecision(3)
+                            << dt.count() << "]" << std::endl;
+                }
             }
-
-            if (timer != nullptr) {
-                timer->startingJob("'" + file + "'", JobTypeHolder<>::COMPILING, os.str());
-                os.str("");
-            } else if (_verbose) {
-                beginTime = steady_clock::now();
-                char f = std::cout.fill();
-                std::cout << os.str() << " compiling "
-                        << std::setw(maxsize + 9) << std::setfill('.') << std::left
-                        << ("'" + file + "' ") << " ";
-                os.str("");
-                std::cout.flush();
-                std::cout.fill(f); // restore fill character
+        };
+
+        if (nThreads == 1) {
+            compile();
+        } else {
+            // compile source code files into different object files in parallel
+            std::vector<std::thread> workers;
+            workers.reserve(nThreads - 1);
+            try {
+                for (size_t t = 1; t < nThreads; ++t) {
+                    workers.emplace_back(compile);
+                }
+            } catch (...) {
+                // failed to create a new thread: proceed with the existing ones
             }
 
-            if (_saveToDiskFirst) {
-                // save a new source file to disk
-                std::ofstream sourceFile;
-                std::string srcfile = system::createPath(_sourcesFolder, it->first);
-                sourceFile.open(srcfile.c_str());
-                sourceFile << it->second;
-                sourceFile.close();
+            compile();
 
-                // compile the file
-                compileFile(srcfile, file, posIndepCode);
-            } else {
-                 // compile without saving the source code to disk
-                compileSource(it->second, file, posIndepCode);
-            }
-
-            if (timer != nullptr) {
-                timer->finishedJob();
-            } else if (_verbose) {
-                steady_clock::time_point endTime = steady_clock::now();
-                duration<float> dt = endTime - beginTime;
-                std::cout << "done [" << std::fixed << std::setprecision(3)
-                        << dt.count() << "]" << std::endl;
+            for (std::thread& w : workers) {
+                w.join();
             }
+        }
 
+        if (error) {
+            std::rethrow_exception(error);
         }
 
     }
@@ -259,6 +418,7 @@ public:
         }
         _ofiles.clear();
         _sfiles.clear();
+        _cacheKeys.clear();
 
         remove(this->_tmpFolder.c_str());
     }
@@ -269,6 +429,95 @@ public:
 
 protected:
 
+    /**
+     * Creates the key which identifies a compiled file in the cache.
+     *
+     * @param source the content of the source file
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     * @param outputExtension the extension of the compiled file
+     * @return the cache key
+     */
+    virtual std::string createCacheKey(const std::string& source,
+                                       bool posIndepCode,
+                                       const std::string& outputExtension) const {
+        ContentHash h = CompilerCache::createHash();
+        h.add(_path);
+        h.add(_compileFlags);
+        h.add(posIndepCode);
+        h.add(outputExtension);
+        h.add(source);
+        return h.str() + outputExtension;
+    }
+
+    /**
+     * Calls the compiler to link the previously compiled object files into
+     * a dynamic library or reuses a cached library created with the same
+     * object files and arguments.
+     *
+     * @param library the path to the dynamic library to be created
+     * @param args the command line arguments for the compiler
+     */
+    virtual void linkDynamic(const std::string& library,
+                             const std::vector<std::string>& args,
+                             JobTimer* timer) {
+        std::string key;
+        bool cached = false;
+        if (!_cacheFolder.empty()) {
+            key = createLibraryCacheKey(library, args);
+            if (!key.empty())
+                cached = CompilerCache(_cacheFolder).retrieve(key, library);
+        }
+
+        const JobType& jobType = cached ? JobTimer::REUSING_CACHED : JobTimer::COMPILING_DYNAMIC_LIBRARY;
+        if (timer != nullptr) {
+            timer->startingJob("'" + library + "'", jobType);
+        } else if (this->_verbose) {
+            if (cached)
+                std::cout << jobType.getActionName() << " library '" << library << "'" << std::endl;
+            else
+                std::cout << "building library '" << library << "'" << std::endl;
+        }
+
+        if (!cached) {
+            system::callExecutable(_path, args);
+
+            if (!key.empty())
+                CompilerCache(_cacheFolder).store(key, library);
+        }
+
+        if (timer != nullptr) {
+            timer->finishedJob();
+        }
+    }
+
+    /**
+     * Creates the key which identifies a dynamic library in the cache.
+     *
+     * @param library the path to the dynamic library to be created
+     * @param args the command line arguments for the compiler
+     * @return the cache key or an empty string if some of the object files
+     *         are not in the cache
+     */
+    virtual std::string createLibraryCacheKey(const std::string& library,
+                                              const std::vector<std::string>& args) const {
+        ContentHash h = CompilerCache::createHash();
+        h.add(_path);
+        for (const std::string& a : args) {
+            if (a == library) {
+                continue; // the location is not relevant (the file name is part of the linker flags)
+            } else if (_ofiles.find(a) != _ofiles.end()) {
+                auto itKey = _cacheKeys.find(a);
+                if (itKey == _cacheKeys.end())
+                    return ""; // unknown content
+                h.add(itKey->second);
+            } else {
+                h.add(a);
+            }
+        }
+        return h.str() + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+    }
+
     /**
      * Compiles a single source file into an object file.
      *
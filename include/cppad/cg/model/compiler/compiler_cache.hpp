@@ -0,0 +1,183 @@
+#ifndef CPPAD_CG_COMPILER_CACHE_INCLUDED
+#define CPPAD_CG_COMPILER_CACHE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#if defined(__has_include)
+#if __has_include(<cppad/cg/configure.hpp>)
+#include <cppad/cg/configure.hpp>
+#endif
+#endif
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A folder with files (e.g. object files and dynamic libraries) which are
+ * identified by a key created from the content used to produce them.
+ * Files are added atomically so that the same folder can be shared by
+ * several threads and processes.
+ *
+ * @author Joao Leal
+ */
+class CompilerCache {
+private:
+    std::string _folder;
+public:
+
+    /**
+     * @param folder the folder where the cached files are kept
+     *               (created if it does not exist)
+     */
+    inline explicit CompilerCache(std::string folder) :
+        _folder(std::move(folder)) {
+    }
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    /**
+     * Creates a new hash pre-initialized with the cache format and the
+     * CppADCodeGen version.
+     */
+    static inline ContentHash createHash() {
+        ContentHash h;
+        h.add(1); // cache format version
+#ifdef CPPAD_CG_VERSION
+        h.add(CPPAD_CG_VERSION);
+#endif
+        return h;
+    }
+
+    /**
+     * @param key the key of a cached file
+     * @return the path of the file in the cache (it might not exist)
+     */
+    inline std::string getPath(const std::string& key) const {
+        return system::createPath(_folder, key);
+    }
+
+    /**
+     * Copies a previously cached file.
+     *
+     * @param key the key of the cached file
+     * @param destination the path of the file to be created
+     * @return true if the file was found in the cache and copied
+     */
+    inline bool retrieve(const std::string& key,
+                         const std::string& destination) const {
+        std::string cached = system::createPath(_folder, key);
+        if (!system::isFile(cached))
+            return false;
+
+        // the destination is replaced (not overwritten) since it could be
+        // a dynamic library which is currently loaded
+        return copyAtomically(cached, destination);
+    }
+
+    /**
+     * Adds a copy of a file to the cache.
+     * Failures are not considered errors since the cache is only an
+     * optimization.
+     *
+     * @param key the key of the file in the cache
+     * @param file the path of the file to be added
+     * @return true if the file was successfully added to the cache
+     */
+    inline bool store(const std::string& key,
+                      const std::string& file) const {
+        try {
+            system::createFolder(_folder);
+        } catch (const CGException&) {
+            return false;
+        }
+
+        // make sure other threads/processes never see incomplete files
+        return copyAtomically(file, system::createPath(_folder, key));
+    }
+
+    /**
+     * Adds a new file to the cache with the provided content.
+     * Failures are not considered errors since the cache is only an
+     * optimization.
+     *
+     * @param key the key of the file in the cache
+     * @param data the content of the file
+     * @param size the number of bytes in data
+     * @return true if the file was successfully added to the cache
+     */
+    inline bool store(const std::string& key,
+                      const char* data,
+                      size_t size) const {
+        try {
+            system::createFolder(_folder);
+        } catch (const CGException&) {
+            return false;
+        }
+
+        std::string destination = system::createPath(_folder, key);
+        std::string tmpFile = createTemporaryName(destination);
+
+        {
+            std::ofstream out(tmpFile.c_str(), std::ios::binary);
+            out.write(data, size);
+            if (!out) {
+                out.close();
+                std::remove(tmpFile.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename(tmpFile.c_str(), destination.c_str()) != 0) {
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+
+    static inline std::string createTemporaryName(const std::string& destination) {
+        std::ostringstream tmp;
+        tmp << destination << ".tmp." << std::this_thread::get_id() << "."
+            << std::chrono::steady_clock::now().time_since_epoch().count();
+        return tmp.str();
+    }
+
+    static inline bool copyAtomically(const std::string& source,
+                                      const std::string& destination) {
+        std::string tmpFile = createTemporaryName(destination);
+
+        try {
+            system::copyFile(source, tmpFile);
+        } catch (const CGException&) {
+            std::remove(tmpFile.c_str());
+            return false; // e.g. removed in the meanwhile by another process
+        }
+
+        if (std::rename(tmpFile.c_str(), destination.c_str()) != 0) {
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+        return true;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
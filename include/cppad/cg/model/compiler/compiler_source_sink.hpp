@@ -0,0 +1,111 @@
+#ifndef CPPAD_CG_COMPILER_SOURCE_SINK_INCLUDED
+#define CPPAD_CG_COMPILER_SOURCE_SINK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Compiles the source files it receives in small groups, releasing them
+ * right after they are compiled.
+ * The files of a group are compiled together (possibly in parallel, see
+ * AbstractCCompiler::setCompileJobs()) once the group reaches a maximum
+ * number of files or a maximum size.
+ * flush() must be called after the last file to compile any remaining
+ * files.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class CompilerSourceSink : public SourceSink {
+private:
+    CCompiler<Base>& _compiler;
+    bool _posIndepCode;
+    JobTimer* _timer;
+    size_t _maxFiles;
+    size_t _maxBytes;
+    /**
+     * the files waiting to be compiled
+     */
+    std::map<std::string, std::string> _sources;
+    /**
+     * the size of the files waiting to be compiled
+     */
+    size_t _bytes;
+public:
+
+    /**
+     * @param compiler the compiler used to compile the sources
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     * @param timer used to report the compilation jobs (can be null)
+     * @param maxFiles the maximum number of files compiled together
+     *                 (zero means the number of hardware threads)
+     * @param maxBytes the maximum size of the files waiting to be compiled
+     */
+    inline explicit CompilerSourceSink(CCompiler<Base>& compiler,
+                                       bool posIndepCode,
+                                       JobTimer* timer = nullptr,
+                                       size_t maxFiles = 0,
+                                       size_t maxBytes = 64 * 1024 * 1024) :
+        _compiler(compiler),
+        _posIndepCode(posIndepCode),
+        _timer(timer),
+        _maxFiles(maxFiles != 0 ? maxFiles : std::max<size_t>(1, std::thread::hardware_concurrency())),
+        _maxBytes(maxBytes),
+        _bytes(0) {
+    }
+
+    CompilerSourceSink(const CompilerSourceSink&) = delete;
+    CompilerSourceSink& operator=(const CompilerSourceSink&) = delete;
+
+    inline void addSource(const std::string& name,
+                          std::string source) override {
+        _bytes += source.size();
+        _sources[name] = std::move(source);
+
+        if (_sources.size() >= _maxFiles || _bytes >= _maxBytes) {
+            flush();
+        }
+    }
+
+    /**
+     * Compiles all the files which were not compiled yet.
+     */
+    inline void flush() {
+        if (_sources.empty())
+            return;
+
+        std::map<std::string, std::string> sources;
+        sources.swap(_sources);
+        _bytes = 0;
+
+        _compiler.compileSources(sources, _posIndepCode, _timer);
+    }
+
+    inline size_t getMaxFiles() const {
+        return _maxFiles;
+    }
+
+    inline size_t getMaxBytes() const {
+        return _maxBytes;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
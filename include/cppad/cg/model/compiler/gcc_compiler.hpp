@@ -66,17 +66,7 @@ public:
             args.push_back(it);
         }
 
-        if (timer != nullptr) {
-            timer->startingJob("'" + library + "'", JobTimer::COMPILING_DYNAMIC_LIBRARY);
-        } else if (this->_verbose) {
-            std::cout << "building library '" << library << "'" << std::endl;
-        }
-
-        system::callExecutable(this->_path, args);
-
-        if (timer != nullptr) {
-            timer->finishedJob();
-        }
+        this->linkDynamic(library, args, timer);
     }
 
     virtual ~GccCompiler() = default;
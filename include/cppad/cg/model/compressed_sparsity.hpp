@@ -0,0 +1,218 @@
+#ifndef CPPAD_CG_COMPRESSED_SPARSITY_INCLUDED
+#define CPPAD_CG_COMPRESSED_SPARSITY_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Storage order of a compressed sparse matrix
+ */
+enum class CompressedSparsityFormat {
+    Row, // compressed sparse row (CSR)
+    Column // compressed sparse column (CSC)
+};
+
+/**
+ * A sparsity pattern stored in the compressed sparse row (CSR) or the
+ * compressed sparse column (CSC) format.
+ *
+ * It also holds the permutation from the element order used by a compiled
+ * model to the compressed order, so that the values determined by the model
+ * can be placed in the compressed order without any memory allocation
+ * (e.g. for Eigen::Map<SparseMatrix>, SuiteSparse, or IPOPT).
+ * The pattern should be created only once and reused for all evaluations.
+ *
+ * @tparam Index the type used for the index arrays (e.g. int for Eigen or
+ *               SuiteSparse)
+ * @author Joao Leal
+ */
+template<class Index = size_t>
+class CompressedSparsity {
+protected:
+    CompressedSparsityFormat _format;
+    size_t _rows;
+    size_t _cols;
+    /// the position of the first element of each row/column (with an extra element for the end)
+    std::vector<Index> _outerStarts;
+    /// the column/row index of each element
+    std::vector<Index> _innerIndexes;
+    /// the compressed position of each element in the order used by the model
+    std::vector<size_t> _permutation;
+    /// the first element of each cycle of the permutation (with more than one element)
+    std::vector<size_t> _cycles;
+public:
+
+    inline explicit CompressedSparsity(CompressedSparsityFormat format = CompressedSparsityFormat::Row) :
+        _format(format),
+        _rows(0),
+        _cols(0) {
+    }
+
+    inline virtual ~CompressedSparsity() = default;
+
+    inline CompressedSparsityFormat getFormat() const {
+        return _format;
+    }
+
+    inline size_t getRows() const {
+        return _rows;
+    }
+
+    inline size_t getCols() const {
+        return _cols;
+    }
+
+    /**
+     * @return the number of structurally non-zero elements
+     */
+    inline size_t getNonZeros() const {
+        return _innerIndexes.size();
+    }
+
+    /**
+     * Provides the position of the first element of each row (CSR) or
+     * column (CSC).
+     * It has an additional element at the end with the number of
+     * non-zeros.
+     */
+    inline const std::vector<Index>& getOuterStarts() const {
+        return _outerStarts;
+    }
+
+    /**
+     * Provides the column (CSR) or row (CSC) index of each element.
+     */
+    inline const std::vector<Index>& getInnerIndexes() const {
+        return _innerIndexes;
+    }
+
+    /**
+     * Provides the compressed position of each element in the order used
+     * by the compiled model.
+     */
+    inline const std::vector<size_t>& getPermutation() const {
+        return _permutation;
+    }
+
+    /**
+     * Whether or not the elements from the compiled model are already in
+     * the compressed order.
+     */
+    inline bool isIdentityPermutation() const {
+        return _cycles.empty();
+    }
+
+    /**
+     * Defines the sparsity pattern using the coordinate format, where the
+     * order of the elements is the one used by the compiled model.
+     *
+     * @param rows the number of rows of the matrix
+     * @param cols the number of columns of the matrix
+     * @param row the row index of each element
+     * @param col the column index of each element
+     * @param nnz the number of elements
+     * @throws CGException if there are invalid or repeated elements
+     */
+    inline void setPattern(size_t rows,
+                           size_t cols,
+                           const size_t* row,
+                           const size_t* col,
+                           size_t nnz) {
+        _rows = rows;
+        _cols = cols;
+
+        bool byRow = _format == CompressedSparsityFormat::Row;
+        const size_t* outer = byRow ? row : col;
+        const size_t* inner = byRow ? col : row;
+        size_t nOuter = byRow ? rows : cols;
+        size_t nInner = byRow ? cols : rows;
+
+        // count the elements in each row/column
+        _outerStarts.assign(nOuter + 1, 0);
+        for (size_t e = 0; e < nnz; e++) {
+            if (outer[e] >= nOuter || inner[e] >= nInner)
+                throw CGException("Invalid sparsity pattern element (", row[e], ", ", col[e], ")");
+            _outerStarts[outer[e] + 1]++;
+        }
+        for (size_t o = 0; o < nOuter; o++) {
+            _outerStarts[o + 1] += _outerStarts[o];
+        }
+
+        // place the elements (stable)
+        std::vector<size_t> next(_outerStarts.begin(), _outerStarts.end() - 1);
+        std::vector<size_t> order(nnz); // model element at each compressed position
+        for (size_t e = 0; e < nnz; e++) {
+            order[next[outer[e]]++] = e;
+        }
+
+        // sort each row/column by the inner index
+        for (size_t o = 0; o < nOuter; o++) {
+            auto begin = order.begin() + _outerStarts[o];
+            auto end = order.begin() + _outerStarts[o + 1];
+            std::sort(begin, end, [inner](size_t e1, size_t e2) {
+                return inner[e1] < inner[e2];
+            });
+            for (auto it = begin; it != end; ++it) {
+                if (it != begin && inner[*it] == inner[*(it - 1)])
+                    throw CGException("Repeated sparsity pattern element (", row[*it], ", ", col[*it], ")");
+            }
+        }
+
+        _innerIndexes.resize(nnz);
+        _permutation.resize(nnz);
+        for (size_t p = 0; p < nnz; p++) {
+            _innerIndexes[p] = Index(inner[order[p]]);
+            _permutation[order[p]] = p;
+        }
+
+        // determine the cycles of the permutation
+        _cycles.clear();
+        std::vector<bool> visited(nnz, false);
+        for (size_t e = 0; e < nnz; e++) {
+            if (visited[e] || _permutation[e] == e)
+                continue;
+            _cycles.push_back(e);
+            for (size_t c = e; !visited[c]; c = _permutation[c]) {
+                visited[c] = true;
+            }
+        }
+    }
+
+    /**
+     * Reorders values from the order used by the compiled model into the
+     * compressed order (in place and without allocations).
+     *
+     * @param values the values of the elements (getNonZeros() elements)
+     */
+    template<class T>
+    inline void permute(T* values) const {
+        for (size_t s : _cycles) {
+            T tmp = values[s];
+            size_t e = _permutation[s];
+            while (e != s) {
+                std::swap(tmp, values[e]);
+                e = _permutation[e];
+            }
+            values[s] = tmp;
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -132,11 +132,7 @@ public:
         const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
             for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
+                compileModelSources(compiler, *p.second, true);
             }
 
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
@@ -167,6 +163,35 @@ public:
             return std::unique_ptr<DynamicLib<Base>> (nullptr);
     }
 
+    /**
+     * Compiles all models and generates a dynamic library in a new thread.
+     * The progress is reported to the listeners of the model library
+     * source generator (from the new thread) and the creation can be
+     * cancelled with ModelLibraryCSourceGen::cancel(), in which case the
+     * future provides a CGCancelledException.
+     * The model library source generator, its models, and the compiler
+     * must not be used or deleted until the library is created.
+     * If CppAD is used by other threads in the meanwhile, it must be
+     * prepared for multithreading with a CppADParallelSetup created before
+     * this call and destroyed after the library is created (the sources
+     * can still be generated by several threads).
+     * The destruction of the returned future waits for the creation of
+     * the library.
+     *
+     * @param compiler The compiler used to compile the sources and create
+     *                 the dynamic library
+     * @param loadLib Whether or not to load the dynamic library
+     * @return The dynamic library if loadLib is true, nullptr otherwise
+     */
+    std::future<std::unique_ptr<DynamicLib<Base>>> createDynamicLibraryAsync(CCompiler<Base>& compiler,
+                                                                             bool loadLib = true) {
+        this->modelLibraryHelper_->clearCancellation();
+
+        return std::async(std::launch::async, [this, &compiler, loadLib]() {
+            return createDynamicLibrary(compiler, loadLib);
+        });
+    }
+
     /**
      * Compiles all models and generates a static library.
      * 
@@ -189,11 +214,7 @@ public:
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
             for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
+                compileModelSources(compiler, *p.second, posIndepCode);
             }
 
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
@@ -221,6 +242,30 @@ public:
 
 protected:
 
+    /**
+     * Compiles the sources of a model (while they are generated if the
+     * model library streams the model sources).
+     */
+    virtual void compileModelSources(CCompiler<Base>& compiler,
+                                     ModelCSourceGen<Base>& model,
+                                     bool posIndepCode) {
+        if (!this->modelLibraryHelper_->isStreamModelSources()) {
+            const std::map<std::string, std::string>& modelSources = this->getSources(model);
+
+            this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+            compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+            this->modelLibraryHelper_->finishedJob();
+        } else {
+            // each group of files is compiled and released right after being generated
+            CompilerSourceSink<Base> sink(compiler, posIndepCode, this->modelLibraryHelper_);
+            this->streamSources(model, sink);
+
+            this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+            sink.flush();
+            this->modelLibraryHelper_->finishedJob();
+        }
+    }
+
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
 };
@@ -38,6 +38,14 @@ protected:
     std::set<LinuxDynamicLibModel<Base>*> _models;
 public:
 
+    /**
+     * Opens a dynamic library.
+     *
+     * @param dynLibName the path to the dynamic library
+     * @param dlOpenMode the mode used by dlopen() (RTLD_LAZY can be used to
+     *                   only resolve the symbols required by the functions
+     *                   which are called)
+     */
     explicit LinuxDynamicLib(std::string dynLibName,
                              int dlOpenMode = RTLD_NOW) :
         _dynLibName(std::move(dynLibName)),
@@ -54,8 +62,10 @@ public:
         }
 
         // load the dynamic library
+        auto beginTime = std::chrono::steady_clock::now();
         _dynLibHandle = dlopen(path.c_str(), dlOpenMode);
         CPPADCG_ASSERT_KNOWN(_dynLibHandle != nullptr, ("Failed to dynamically load library '" + _dynLibName + "': " + dlerror()).c_str())
+        this->_loadDurations["open"] += std::chrono::steady_clock::now() - beginTime;
 
         // validate the dynamic library
         this->validate();
@@ -62,6 +62,7 @@ protected:
 
         CPPADCG_ASSERT_UNKNOWN(_dynLib != nullptr);
 
+        this->_lazyFunctionLoading = _dynLib->isLazyFunctionLoading();
         this->init();
     }
 
@@ -23,10 +23,15 @@ namespace cg {
 
 /**
  * A model which can be accessed through function pointers.
- * This class is not thread-safe and it should not be used simultaneously in
- * different threads.
- * Multiple instances of this class for the same model from the same model
- * library object can be used simultaneously in different threads.
+ * The evaluation methods (e.g. ForwardZero(), SparseJacobian()) do not
+ * modify the state of this object and can be called simultaneously from
+ * different threads as long as the provided atomic functions are also
+ * thread-safe (CppAD atomic functions are evaluated one at a time).
+ * The buffers used by each evaluation are std::vector objects since
+ * CppAD::vector uses the CppAD thread_alloc memory which is not
+ * thread-safe outside CppAD parallel mode.
+ * Methods which change the model configuration (e.g. addAtomicFunction())
+ * should not be used while the model is being evaluated.
  *
  * @author Joao Leal
  */
@@ -35,20 +40,48 @@ class FunctorGenericModel : public GenericModel<Base> {
 protected:
     static constexpr const char* ERROR_LIBRARY_NOT_READY = "The model library is not ready. The model library that"
                                                            " provided this model might have been closed or deleted.";
+    /**
+     * Flags identifying the functions which can be loaded from the model
+     * library
+     */
+    enum Functions : unsigned int {
+        FUN_ZERO = 1u << 0u,
+        FUN_FORWARD_ONE = 1u << 1u,
+        FUN_REVERSE_ONE = 1u << 2u,
+        FUN_REVERSE_TWO = 1u << 3u,
+        FUN_JACOBIAN = 1u << 4u,
+        FUN_HESSIAN = 1u << 5u,
+        FUN_SPARSE_FORWARD_ONE = 1u << 6u,
+        FUN_SPARSE_REVERSE_ONE = 1u << 7u,
+        FUN_SPARSE_REVERSE_TWO = 1u << 8u,
+        FUN_SPARSE_FORWARD_ONE_MULTI = 1u << 9u,
+        FUN_SPARSE_REVERSE_TWO_MULTI = 1u << 10u,
+        FUN_SPARSE_JACOBIAN = 1u << 11u,
+        FUN_SPARSE_HESSIAN = 1u << 12u,
+        FUN_ZERO_BATCH = 1u << 13u,
+        FUN_SPARSE_JACOBIAN_BATCH = 1u << 14u,
+        FUN_SPARSE_HESSIAN_BATCH = 1u << 15u,
+        FUN_FORWARD_ONE_SPARSITY = 1u << 16u,
+        FUN_REVERSE_ONE_SPARSITY = 1u << 17u,
+        FUN_REVERSE_TWO_SPARSITY = 1u << 18u,
+        FUN_JACOBIAN_SPARSITY = 1u << 19u,
+        FUN_HESSIAN_SPARSITY = 1u << 20u,
+        FUN_HESSIAN_SPARSITY2 = 1u << 21u,
+        FUN_WORKSPACE_SIZE = 1u << 22u,
+        FUN_ALL = (1u << 23u) - 1u
+    };
 protected:
     bool _isLibraryReady;
     /// the model name
     const std::string _name;
     size_t _m;
     size_t _n;
-    std::vector<const Base*> _in;
-    std::vector<const Base*> _inHess;
-    std::vector<Base*> _out;
+    /// the number of independent variable arrays
+    size_t _inSize;
     LangCAtomicFun _atomicFuncArg;
     std::vector<std::string> _atomicNames; // names of the atomic/external functions required by this model
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
     size_t _missingAtomicFunctions;
-    CppAD::vector<Base> _tx, _ty, _px, _py;
     // original model function
     void (*_zero)(Base const*const*, Base * const*, LangCAtomicFun);
     // first order forward mode
@@ -67,10 +100,20 @@ protected:
     int (*_sparseReverseOne)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
     //
     int (*_sparseReverseTwo)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    // first order forward mode with multiple directions
+    int (*_sparseForwardOneMulti)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    // second order reverse mode with multiple directions
+    int (*_sparseReverseTwoMulti)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
     // sparse jacobian function in the dynamic library
     void (*_sparseJacobian)(Base const*const*, Base * const*, LangCAtomicFun);
     // sparse hessian function in the dynamic library
     void (*_sparseHessian)(Base const*const*, Base * const*, LangCAtomicFun);
+    // original model function for multiple points
+    void (*_zeroBatch)(unsigned long, Base const*const*, Base * const*, LangCAtomicFun);
+    // sparse jacobian function for multiple points
+    void (*_sparseJacobianBatch)(unsigned long, Base const*const*, Base * const*, LangCAtomicFun);
+    // sparse hessian function for multiple points
+    void (*_sparseHessianBatch)(unsigned long, Base const*const*, Base * const*, LangCAtomicFun);
     //
     void (*_forwardOneSparsity)(unsigned long, unsigned long const**, unsigned long*);
     //
@@ -91,6 +134,16 @@ protected:
             unsigned long * nnz);
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
+    void (*_workspaceSize)(unsigned long* size,
+            int* perThread);
+    /// whether or not functions are only loaded from the library when they are first used
+    bool _lazyFunctionLoading;
+    /// the functions already loaded from the library (see Functions)
+    std::atomic<unsigned int> _loadedFunctions;
+    /// used to load functions (with lazy loading) and to record the load durations
+    mutable std::mutex _loadMutex;
+    /// the time spent in each stage of loading this model
+    std::map<std::string, std::chrono::steady_clock::duration> _loadDurations;
 
 public:
 
@@ -100,9 +153,7 @@ public:
             _name(std::move(other._name)),
             _m(other._m),
             _n(other._n),
-            _in(std::move(other._in)),
-            _inHess(std::move(other._inHess)),
-            _out(std::move(other._out)),
+            _inSize(other._inSize),
             _atomicFuncArg{this, &atomicForward, &atomicReverse},
             _atomicNames(std::move(other._atomicNames)),
             _atomic(std::move(other._atomic)),
@@ -116,15 +167,24 @@ public:
             _sparseForwardOne(other._sparseForwardOne),
             _sparseReverseOne(other._sparseReverseOne),
             _sparseReverseTwo(other._sparseReverseTwo),
+            _sparseForwardOneMulti(other._sparseForwardOneMulti),
+            _sparseReverseTwoMulti(other._sparseReverseTwoMulti),
             _sparseJacobian(other._sparseJacobian),
             _sparseHessian(other._sparseHessian),
+            _zeroBatch(other._zeroBatch),
+            _sparseJacobianBatch(other._sparseJacobianBatch),
+            _sparseHessianBatch(other._sparseHessianBatch),
             _forwardOneSparsity(other._forwardOneSparsity),
             _reverseOneSparsity(other._reverseOneSparsity),
             _reverseTwoSparsity(other._reverseTwoSparsity),
             _jacobianSparsity(other._jacobianSparsity),
             _hessianSparsity(other._hessianSparsity),
             _hessianSparsity2(other._hessianSparsity2),
-            _atomicFunctions(other._atomicFunctions) {
+            _atomicFunctions(other._atomicFunctions),
+            _workspaceSize(other._workspaceSize),
+            _lazyFunctionLoading(other._lazyFunctionLoading),
+            _loadedFunctions(other._loadedFunctions.load()),
+            _loadDurations(std::move(other._loadDurations)) {
 
         other._isLibraryReady = false;
     }
@@ -142,6 +202,29 @@ public:
         return _name;
     }
 
+    /**
+     * Whether or not the functions of this model are only loaded from the
+     * model library when they are first used.
+     * Lazy loading is enabled through the model library that creates the
+     * model (e.g. FunctorModelLibrary::setLazyFunctionLoading()).
+     */
+    inline bool isLazyFunctionLoading() const {
+        return _lazyFunctionLoading;
+    }
+
+    /**
+     * Provides the time spent in each stage of loading this model:
+     *  - "validation": checking the model information in the library;
+     *  - "functions": resolving the function symbols in the library (with
+     *    lazy loading it also includes the functions loaded so far).
+     *
+     * @return the duration of each stage
+     */
+    inline std::map<std::string, std::chrono::steady_clock::duration> getLoadDurations() const {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+        return _loadDurations;
+    }
+
     const std::vector<std::string>& getAtomicFunctionNames() override {
         return _atomicNames;
     }
@@ -158,11 +241,13 @@ public:
 
     // Jacobian sparsity
     bool isJacobianSparsityAvailable() override {
+        requireFunctions(FUN_JACOBIAN_SPARSITY);
         return _jacobianSparsity != nullptr;
     }
 
     std::vector<bool> JacobianSparsityBool() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -179,6 +264,7 @@ public:
 
     std::vector<std::set<size_t> > JacobianSparsitySet() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -193,9 +279,12 @@ public:
         return s;
     }
 
+    using GenericModel<Base>::JacobianSparsity;
+
     void JacobianSparsity(std::vector<size_t>& equations,
                           std::vector<size_t>& variables) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -211,11 +300,13 @@ public:
 
     // Hessian sparsity
     bool isHessianSparsityAvailable() override {
+        requireFunctions(FUN_HESSIAN_SPARSITY);
         return _hessianSparsity != nullptr;
     }
 
     std::vector<bool> HessianSparsityBool() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -232,6 +323,7 @@ public:
 
     std::vector<std::set<size_t> > HessianSparsitySet() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -246,9 +338,12 @@ public:
         return s;
     }
 
+    using GenericModel<Base>::HessianSparsity;
+
     void HessianSparsity(std::vector<size_t>& rows,
                          std::vector<size_t>& cols) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -263,11 +358,13 @@ public:
     }
 
     bool isEquationHessianSparsityAvailable() override {
+        requireFunctions(FUN_HESSIAN_SPARSITY2);
         return _hessianSparsity2 != nullptr;
     }
 
     std::vector<bool> HessianSparsityBool(size_t i) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY2);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity2 != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -284,6 +381,7 @@ public:
 
     std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY2);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity2 != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -301,6 +399,7 @@ public:
     void HessianSparsity(size_t i, std::vector<size_t>& rows,
                          std::vector<size_t>& cols) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN_SPARSITY2);
         CPPADCG_ASSERT_KNOWN(_hessianSparsity2 != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
         unsigned long const* row, *col;
@@ -326,7 +425,23 @@ public:
         return _m;
     }
 
+    size_t getWorkspaceSize(bool& perThread) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_WORKSPACE_SIZE);
+
+        perThread = false;
+        if (_workspaceSize == nullptr)
+            return 0; // created by an older version
+
+        unsigned long size;
+        int threadLocal;
+        (*_workspaceSize)(&size, &threadLocal);
+        perThread = threadLocal != 0;
+        return size;
+    }
+
     bool isForwardZeroAvailable() override {
+        requireFunctions(FUN_ZERO);
         return _zero != nullptr;
     }
 
@@ -336,30 +451,32 @@ public:
     void ForwardZero(ArrayView<const Base> x,
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_ZERO);
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
-        _in[0] = x.data();
-        _out[0] = dep.data();
+        const Base* in[1] = {x.data()};
+        Base* out[1] = {dep.data()};
 
-        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
+        (*_zero)(in, out, _atomicFuncArg);
     }
 
     void ForwardZero(const std::vector<const Base*> &x,
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_ZERO);
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(_inSize == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
-        _out[0] = dep.data();
+        Base* out[1] = {dep.data()};
 
-        (*_zero)(&x[0], &_out[0], _atomicFuncArg);
+        (*_zero)(&x[0], out, _atomicFuncArg);
     }
 
     void ForwardZero(const CppAD::vector<bool>& vx,
@@ -367,17 +484,18 @@ public:
                      ArrayView<const Base> tx,
                      ArrayView<Base> ty) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_ZERO);
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(tx.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(ty.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
-        _in[0] = tx.data();
-        _out[0] = ty.data();
+        const Base* in[1] = {tx.data()};
+        Base* out[1] = {ty.data()};
 
-        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
+        (*_zero)(in, out, _atomicFuncArg);
 
         if (vx.size() > 0) {
             CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size")
@@ -395,6 +513,7 @@ public:
     }
 
     bool isJacobianAvailable() override {
+        requireFunctions(FUN_JACOBIAN);
         return _jacobian != nullptr;
     }
 
@@ -402,21 +521,22 @@ public:
     void Jacobian(ArrayView<const Base> x,
                   ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_JACOBIAN);
         CPPADCG_ASSERT_KNOWN(_jacobian != nullptr, "No Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        const Base* in[1] = {x.data()};
+        Base* out[1] = {jac.data()};
 
-        _in[0] = x.data();
-        _out[0] = jac.data();
-
-        (*_jacobian)(&_in[0], &_out[0], _atomicFuncArg);
+        (*_jacobian)(in, out, _atomicFuncArg);
     }
 
     bool isHessianAvailable() override {
+        requireFunctions(FUN_HESSIAN);
         return _hessian != nullptr;
     }
 
@@ -425,22 +545,23 @@ public:
                  ArrayView<const Base> w,
                  ArrayView<Base> hess) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_HESSIAN);
         CPPADCG_ASSERT_KNOWN(_hessian != nullptr, "No Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
-        _inHess[0] = x.data();
-        _inHess[1] = w.data();
-        _out[0] = hess.data();
+        const Base* in[2] = {x.data(), w.data()};
+        Base* out[1] = {hess.data()};
 
-        (*_hessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+        (*_hessian)(in, out, _atomicFuncArg);
     }
 
     bool isForwardOneAvailable() override {
+        requireFunctions(FUN_FORWARD_ONE);
         return _forwardOne != nullptr;
     }
 
@@ -449,6 +570,7 @@ public:
         const size_t k = 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_FORWARD_ONE);
         CPPADCG_ASSERT_KNOWN(_forwardOne != nullptr, "No forward one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(tx.size() >= (k + 1) * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= (k + 1) * _m, "Invalid ty size")
@@ -460,6 +582,7 @@ public:
     }
 
     bool isSparseForwardOneAvailable() override {
+        requireFunctions(FUN_SPARSE_FORWARD_ONE | FUN_FORWARD_ONE_SPARSITY);
         return _forwardOneSparsity != nullptr && _sparseForwardOne != nullptr;
     }
 
@@ -467,6 +590,7 @@ public:
                     size_t tx1Nnz, const size_t idx[], const Base tx1[],
                     ArrayView<Base> ty1) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_FORWARD_ONE | FUN_FORWARD_ONE_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseForwardOne != nullptr, "No sparse forward one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_forwardOneSparsity != nullptr, "No forward one sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -480,18 +604,17 @@ public:
         unsigned long const* pos;
         size_t nnz = 0;
 
-        _ty.resize(_m);
-        Base* compressed = &_ty[0];
+        std::vector<Base> compressed(_m);
 
-        _inHess[0] = x.data();
-        _out[0] = compressed;
+        const Base* in[2] = {x.data(), nullptr};
+        Base* out[1] = {compressed.data()};
 
         for (size_t ej = 0; ej < tx1Nnz; ej++) {
             size_t j = idx[ej];
             (*_forwardOneSparsity)(j, &pos, &nnz);
 
-            _inHess[1] = &tx1[ej];
-            int ret = (*_sparseForwardOne)(j, &_inHess[0], &_out[0], _atomicFuncArg);
+            in[1] = &tx1[ej];
+            int ret = (*_sparseForwardOne)(j, in, out, _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed.") // generic failure
 
@@ -501,7 +624,60 @@ public:
         }
     }
 
+    bool isSparseForwardOneMultiAvailable() override {
+        requireFunctions(FUN_SPARSE_FORWARD_ONE_MULTI);
+        return _sparseForwardOneMulti != nullptr;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t nDir,
+                    ArrayView<const Base> tx1,
+                    ArrayView<Base> ty1) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_FORWARD_ONE | FUN_SPARSE_FORWARD_ONE_MULTI);
+        CPPADCG_ASSERT_KNOWN(_sparseForwardOneMulti != nullptr || _sparseForwardOne != nullptr, "No sparse forward one function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
+        CPPADCG_ASSERT_KNOWN(tx1.size() >= _n * nDir, "Invalid tx1 size")
+        CPPADCG_ASSERT_KNOWN(ty1.size() >= _m * nDir, "Invalid ty1 size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        if (_sparseForwardOneMulti != nullptr) {
+            const Base* in[2] = {x.data(), tx1.data()};
+            Base* out[1] = {ty1.data()};
+
+            int ret = (*_sparseForwardOneMulti)(nDir, in, out, _atomicFuncArg);
+
+            CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed.") // generic failure
+            return;
+        }
+
+        /**
+         * one direction at a time
+         */
+        std::vector<size_t> idx;
+        std::vector<Base> tx1k, ty1k(_m);
+        idx.reserve(_n);
+        tx1k.reserve(_n);
+
+        for (size_t k = 0; k < nDir; k++) {
+            idx.clear();
+            tx1k.clear();
+            for (size_t j = 0; j < _n; j++) {
+                if (tx1[j * nDir + k] != Base(0)) {
+                    idx.push_back(j);
+                    tx1k.push_back(tx1[j * nDir + k]);
+                }
+            }
+
+            ForwardOne(x, idx.size(), idx.data(), tx1k.data(), ty1k);
+
+            for (size_t i = 0; i < _m; i++)
+                ty1[i * nDir + k] = ty1k[i];
+        }
+    }
+
     bool isReverseOneAvailable() override {
+        requireFunctions(FUN_REVERSE_ONE);
         return _reverseOne != nullptr;
     }
 
@@ -513,6 +689,7 @@ public:
         const size_t k1 = k + 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_REVERSE_ONE);
         CPPADCG_ASSERT_KNOWN(_reverseOne != nullptr, "No reverse one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size")
@@ -526,6 +703,7 @@ public:
     }
 
     bool isSparseReverseOneAvailable() override {
+        requireFunctions(FUN_SPARSE_REVERSE_ONE | FUN_REVERSE_ONE_SPARSITY);
         return _reverseOneSparsity != nullptr && _sparseReverseOne != nullptr;
     }
 
@@ -533,6 +711,7 @@ public:
                     ArrayView<Base> px,
                     size_t pyNnz, const size_t idx[], const Base py[]) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_REVERSE_ONE | FUN_REVERSE_ONE_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseReverseOne != nullptr, "No sparse reverse one function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_reverseOneSparsity != nullptr, "No reverse one sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -546,18 +725,17 @@ public:
         unsigned long const* pos;
         size_t nnz = 0;
 
-        _px.resize(_n);
-        Base* compressed = &_px[0];
+        std::vector<Base> compressed(_n);
 
-        _inHess[0] = x.data();
-        _out[0] = compressed;
+        const Base* in[2] = {x.data(), nullptr};
+        Base* out[1] = {compressed.data()};
 
         for (size_t ei = 0; ei < pyNnz; ei++) {
             size_t i = idx[ei];
             (*_reverseOneSparsity)(i, &pos, &nnz);
 
-            _inHess[1] = &py[ei];
-            int ret = (*_sparseReverseOne)(i, &_inHess[0], &_out[0], _atomicFuncArg);
+            in[1] = &py[ei];
+            int ret = (*_sparseReverseOne)(i, in, out, _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order reverse mode failed.")
 
@@ -568,6 +746,7 @@ public:
     }
 
     bool isReverseTwoAvailable() override {
+        requireFunctions(FUN_REVERSE_TWO);
         return _reverseTwo != nullptr;
     }
 
@@ -579,8 +758,9 @@ public:
         const size_t k1 = k + 1;
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_REVERSE_TWO);
         CPPADCG_ASSERT_KNOWN(_reverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1")
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1")
         CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size")
         CPPADCG_ASSERT_KNOWN(px.size() >= k1 * _n, "Invalid px size")
@@ -594,6 +774,7 @@ public:
     }
 
     bool isSparseReverseTwoAvailable() override {
+        requireFunctions(FUN_SPARSE_REVERSE_TWO);
         return _sparseReverseTwo != nullptr;
     }
 
@@ -602,6 +783,7 @@ public:
                     ArrayView<Base> px2,
                     ArrayView<const Base> py2) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_REVERSE_TWO | FUN_REVERSE_TWO_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseReverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(_reverseTwoSparsity != nullptr, "No reverse two sparsity function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
@@ -616,20 +798,17 @@ public:
         unsigned long const* pos;
         size_t nnz = 0;
 
-        _px.resize(_n);
-        Base* compressed = &_px[0];
+        std::vector<Base> compressed(_n);
 
-        const Base * in[3];
-        in[0] = x.data();
-        in[2] = py2.data();
-        _out[0] = compressed;
+        const Base* in[3] = {x.data(), nullptr, py2.data()};
+        Base* out[1] = {compressed.data()};
 
         for (size_t ej = 0; ej < tx1Nnz; ej++) {
             size_t j = idx[ej];
             (*_reverseTwoSparsity)(j, &pos, &nnz);
 
             in[1] = &tx1[ej];
-            int ret = (*_sparseReverseTwo)(j, &in[0], &_out[0], _atomicFuncArg);
+            int ret = (*_sparseReverseTwo)(j, in, out, _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "Second-order reverse mode failed.") // generic failure
 
@@ -639,17 +818,75 @@ public:
         }
     }
 
+    bool isSparseReverseTwoMultiAvailable() override {
+        requireFunctions(FUN_SPARSE_REVERSE_TWO_MULTI);
+        return _sparseReverseTwoMulti != nullptr;
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t nDir,
+                    ArrayView<const Base> tx1,
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_REVERSE_TWO | FUN_SPARSE_REVERSE_TWO_MULTI);
+        CPPADCG_ASSERT_KNOWN(_sparseReverseTwoMulti != nullptr || _sparseReverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(x.size() >= _n, "Invalid x size")
+        CPPADCG_ASSERT_KNOWN(tx1.size() >= _n * nDir, "Invalid tx1 size")
+        CPPADCG_ASSERT_KNOWN(px2.size() >= _n * nDir, "Invalid px2 size")
+        CPPADCG_ASSERT_KNOWN(py2.size() >= _m, "Invalid py2 size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        if (_sparseReverseTwoMulti != nullptr) {
+            const Base* in[3] = {x.data(), tx1.data(), py2.data()};
+            Base* out[1] = {px2.data()};
+
+            int ret = (*_sparseReverseTwoMulti)(nDir, in, out, _atomicFuncArg);
+
+            CPPADCG_ASSERT_KNOWN(ret == 0, "Second-order reverse mode failed.") // generic failure
+            return;
+        }
+
+        /**
+         * one direction at a time
+         */
+        std::vector<size_t> idx;
+        std::vector<Base> tx1k, px2k(_n);
+        idx.reserve(_n);
+        tx1k.reserve(_n);
+
+        for (size_t k = 0; k < nDir; k++) {
+            idx.clear();
+            tx1k.clear();
+            for (size_t j = 0; j < _n; j++) {
+                if (tx1[j * nDir + k] != Base(0)) {
+                    idx.push_back(j);
+                    tx1k.push_back(tx1[j * nDir + k]);
+                }
+            }
+
+            ReverseTwo(x, idx.size(), idx.data(), tx1k.data(), px2k, py2);
+
+            for (size_t j = 0; j < _n; j++)
+                px2[j * nDir + k] = px2k[j];
+        }
+    }
+
     bool isSparseJacobianAvailable() override {
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY);
         return _jacobianSparsity != nullptr && _sparseJacobian != nullptr;
     }
 
     /// calculate sparse Jacobians
 
+    using GenericModel<Base>::SparseJacobian;
+
     void SparseJacobian(ArrayView<const Base> x,
                         ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size")
@@ -660,13 +897,13 @@ public:
         unsigned long nnz;
         (*_jacobianSparsity)(&row, &col, &nnz);
 
-        CppAD::vector<Base> compressed(nnz);
+        std::vector<Base> compressed(nnz);
 
         if (nnz > 0) {
-            _in[0] = x.data();
-            _out[0] = &compressed[0];
+            const Base* in[1] = {x.data()};
+            Base* out[1] = {compressed.data()};
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(in, out, _atomicFuncArg);
         }
 
         createDenseFromSparse(compressed,
@@ -681,8 +918,9 @@ public:
                         std::vector<size_t>& row,
                         std::vector<size_t>& col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -696,10 +934,10 @@ public:
         col.resize(nnz);
 
         if (nnz > 0) {
-            _in[0] = &x[0];
-            _out[0] = &jac[0];
+            const Base* in[1] = {&x[0]};
+            Base* out[1] = {&jac[0]};
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(in, out, _atomicFuncArg);
             std::copy(drow, drow + nnz, row.begin());
             std::copy(dcol, dcol + nnz, col.begin());
         }
@@ -710,8 +948,9 @@ public:
                         size_t const** row,
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
@@ -725,10 +964,10 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
-            _in[0] = x.data();
-            _out[0] = jac.data();
+            const Base* in[1] = {x.data()};
+            Base* out[1] = {jac.data()};
 
-            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(in, out, _atomicFuncArg);
         }
     }
 
@@ -737,8 +976,9 @@ public:
                         size_t const** row,
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(_inSize == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
         unsigned long const* drow;
@@ -750,27 +990,31 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
-            _out[0] = jac.data();
+            Base* out[1] = {jac.data()};
 
-            (*_sparseJacobian)(&x[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(&x[0], out, _atomicFuncArg);
         }
     }
 
     bool isSparseHessianAvailable() override {
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY);
         return _hessianSparsity != nullptr && _sparseHessian != nullptr;
     }
 
     /// calculate sparse Hessians
 
+    using GenericModel<Base>::SparseHessian;
+
     void SparseHessian(ArrayView<const Base> x,
                        ArrayView<const Base> w,
                        ArrayView<Base> hess) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         // CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -778,13 +1022,12 @@ public:
         unsigned long nnz;
         (*_hessianSparsity)(&row, &col, &nnz);
 
-        CppAD::vector<Base> compressed(nnz);
+        std::vector<Base> compressed(nnz);
         if (nnz > 0) {
-            _inHess[0] = x.data();
-            _inHess[1] = w.data();
-            _out[0] = &compressed[0];
+            const Base* in[2] = {x.data(), w.data()};
+            Base* out[1] = {compressed.data()};
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(in, out, _atomicFuncArg);
         }
 
         createDenseFromSparse(compressed,
@@ -800,10 +1043,11 @@ public:
                        std::vector<size_t>& row,
                        std::vector<size_t>& col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -819,11 +1063,10 @@ public:
             std::copy(drow, drow + nnz, row.begin());
             std::copy(dcol, dcol + nnz, col.begin());
 
-            _inHess[0] = &x[0];
-            _inHess[1] = &w[0];
-            _out[0] = &hess[0];
+            const Base* in[2] = {&x[0], &w[0]};
+            Base* out[1] = {&hess[0]};
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(in, out, _atomicFuncArg);
         }
     }
 
@@ -833,8 +1076,9 @@ public:
                        size_t const** row,
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
@@ -848,11 +1092,10 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
-            _inHess[0] = x.data();
-            _inHess[1] = w.data();
-            _out[0] = hess.data();
+            const Base* in[2] = {x.data(), w.data()};
+            Base* out[1] = {hess.data()};
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(in, out, _atomicFuncArg);
         }
     }
 
@@ -862,8 +1105,9 @@ public:
                        size_t const** row,
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY);
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(_inSize == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -875,11 +1119,156 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
-            std::copy(x.begin(), x.end(), _inHess.begin());
-            _inHess.back() = w.data(); // the index might not be 1
-            _out[0] = hess.data();
+            std::vector<const Base*> in(x.size() + 1);
+            std::copy(x.begin(), x.end(), in.begin());
+            in.back() = w.data(); // the index might not be 1
+            Base* out[1] = {hess.data()};
 
-            (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
+            (*_sparseHessian)(in.data(), out, _atomicFuncArg);
+        }
+    }
+
+    /// evaluations at multiple points
+
+    using GenericModel<Base>::ForwardZeroBatch;
+
+    bool isForwardZeroBatchAvailable() override {
+        requireFunctions(FUN_ZERO_BATCH);
+        return _zeroBatch != nullptr;
+    }
+
+    void ForwardZeroBatch(ArrayView<const Base> x,
+                          size_t nPoints,
+                          ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_ZERO | FUN_ZERO_BATCH);
+        CPPADCG_ASSERT_KNOWN(_zeroBatch != nullptr || _zero != nullptr, "No zero order forward function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m * nPoints, "Invalid dependent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        if (nPoints == 0)
+            return;
+
+        if (_zeroBatch != nullptr) {
+            const Base* in[1] = {x.data()};
+            Base* out[1] = {dep.data()};
+
+            (*_zeroBatch)(nPoints, in, out, _atomicFuncArg);
+            return;
+        }
+
+        // evaluate one point at a time
+        std::vector<Base> xp(_n), yp(_m);
+        const Base* in[1] = {xp.data()};
+        Base* out[1] = {yp.data()};
+
+        for (size_t p = 0; p < nPoints; ++p) {
+            gatherPoint(x.data(), _n, nPoints, p, xp.data());
+            (*_zero)(in, out, _atomicFuncArg);
+            scatterPoint(yp.data(), _m, nPoints, p, dep.data());
+        }
+    }
+
+    bool isSparseJacobianBatchAvailable() override {
+        requireFunctions(FUN_SPARSE_JACOBIAN_BATCH | FUN_JACOBIAN_SPARSITY);
+        return _jacobianSparsity != nullptr && _sparseJacobianBatch != nullptr;
+    }
+
+    void SparseJacobianBatch(ArrayView<const Base> x,
+                             size_t nPoints,
+                             ArrayView<Base> jac,
+                             size_t const** row,
+                             size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_JACOBIAN | FUN_SPARSE_JACOBIAN_BATCH | FUN_JACOBIAN_SPARSITY);
+        CPPADCG_ASSERT_KNOWN(_sparseJacobianBatch != nullptr || _sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow;
+        unsigned long const* dcol;
+        unsigned long nnz;
+        (*_jacobianSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz * nPoints == jac.size(), "Invalid number of non-zero elements in Jacobian")
+        *row = drow;
+        *col = dcol;
+
+        if (nnz == 0 || nPoints == 0)
+            return;
+
+        if (_sparseJacobianBatch != nullptr) {
+            const Base* in[1] = {x.data()};
+            Base* out[1] = {jac.data()};
+
+            (*_sparseJacobianBatch)(nPoints, in, out, _atomicFuncArg);
+            return;
+        }
+
+        // evaluate one point at a time
+        std::vector<Base> xp(_n), jacp(nnz);
+        const Base* in[1] = {xp.data()};
+        Base* out[1] = {jacp.data()};
+
+        for (size_t p = 0; p < nPoints; ++p) {
+            gatherPoint(x.data(), _n, nPoints, p, xp.data());
+            (*_sparseJacobian)(in, out, _atomicFuncArg);
+            scatterPoint(jacp.data(), nnz, nPoints, p, jac.data());
+        }
+    }
+
+    bool isSparseHessianBatchAvailable() override {
+        requireFunctions(FUN_SPARSE_HESSIAN_BATCH | FUN_HESSIAN_SPARSITY);
+        return _hessianSparsity != nullptr && _sparseHessianBatch != nullptr;
+    }
+
+    void SparseHessianBatch(ArrayView<const Base> x,
+                            ArrayView<const Base> w,
+                            size_t nPoints,
+                            ArrayView<Base> hess,
+                            size_t const** row,
+                            size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        requireFunctions(FUN_SPARSE_HESSIAN | FUN_SPARSE_HESSIAN_BATCH | FUN_HESSIAN_SPARSITY);
+        CPPADCG_ASSERT_KNOWN(_sparseHessianBatch != nullptr || _sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(_inSize == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n * nPoints, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m * nPoints, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        unsigned long const* drow, *dcol;
+        unsigned long nnz;
+        (*_hessianSparsity)(&drow, &dcol, &nnz);
+        CPPADCG_ASSERT_KNOWN(nnz * nPoints == hess.size(), "Invalid number of non-zero elements in Hessian")
+        *row = drow;
+        *col = dcol;
+
+        if (nnz == 0 || nPoints == 0)
+            return;
+
+        if (_sparseHessianBatch != nullptr) {
+            const Base* in[2] = {x.data(), w.data()};
+            Base* out[1] = {hess.data()};
+
+            (*_sparseHessianBatch)(nPoints, in, out, _atomicFuncArg);
+            return;
+        }
+
+        // evaluate one point at a time
+        std::vector<Base> xp(_n), wp(_m), hessp(nnz);
+        const Base* in[2] = {xp.data(), wp.data()};
+        Base* out[1] = {hessp.data()};
+
+        for (size_t p = 0; p < nPoints; ++p) {
+            gatherPoint(x.data(), _n, nPoints, p, xp.data());
+            gatherPoint(w.data(), _m, nPoints, p, wp.data());
+            (*_sparseHessian)(in, out, _atomicFuncArg);
+            scatterPoint(hessp.data(), nnz, nPoints, p, hess.data());
         }
     }
 
@@ -895,6 +1284,7 @@ protected:
         _name(std::move(name)),
         _m(0),
         _n(0),
+        _inSize(0),
         _atomicFuncArg{nullptr}, // not really required
         _missingAtomicFunctions(0),
         _zero(nullptr),
@@ -906,24 +1296,39 @@ protected:
         _sparseForwardOne(nullptr),
         _sparseReverseOne(nullptr),
         _sparseReverseTwo(nullptr),
+        _sparseForwardOneMulti(nullptr),
+        _sparseReverseTwoMulti(nullptr),
         _sparseJacobian(nullptr),
         _sparseHessian(nullptr),
+        _zeroBatch(nullptr),
+        _sparseJacobianBatch(nullptr),
+        _sparseHessianBatch(nullptr),
         _forwardOneSparsity(nullptr),
         _reverseOneSparsity(nullptr),
         _reverseTwoSparsity(nullptr),
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
         _hessianSparsity2(nullptr),
-        _atomicFunctions(nullptr) {
+        _atomicFunctions(nullptr),
+        _workspaceSize(nullptr),
+        _lazyFunctionLoading(false),
+        _loadedFunctions(0) {
 
     }
 
     virtual void init() {
+        auto beginTime = std::chrono::steady_clock::now();
+
         // validate the dynamic library
         validate();
 
+        auto endTime = std::chrono::steady_clock::now();
+        _loadDurations["validation"] += endTime - beginTime;
+
         // load functions from the dynamic library
         loadFunctions();
+
+        _loadDurations["functions"] += std::chrono::steady_clock::now() - endTime;
     }
 
     virtual void* loadFunction(const std::string& functionName,
@@ -946,9 +1351,7 @@ protected:
         unsigned int outSize = 0;
         (*infoFunc)(&dynamicLibBaseName, &_m, &_n, &inSize, &outSize);
 
-        _in.resize(inSize);
-        _inHess.resize(inSize + 1);
-        _out.resize(outSize);
+        _inSize = inSize;
 
         CPPADCG_ASSERT_KNOWN(local == std::string(dynamicLibBaseName),
                              (std::string("Invalid data type in dynamic library. Expected '") + local
@@ -962,33 +1365,11 @@ protected:
     }
 
     virtual void loadFunctions() {
-        _zero = reinterpret_cast<decltype(_zero)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO, false));
-        _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
-        _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
-        _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
-        _jacobian = reinterpret_cast<decltype(_jacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN, false));
-        _hessian = reinterpret_cast<decltype(_hessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN, false));
-        _sparseForwardOne = reinterpret_cast<decltype(_sparseForwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE, false));
-        _sparseReverseOne = reinterpret_cast<decltype(_sparseReverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, false));
-        _sparseReverseTwo = reinterpret_cast<decltype(_sparseReverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, false));
-        _sparseJacobian = reinterpret_cast<decltype(_sparseJacobian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN, false));
-        _sparseHessian = reinterpret_cast<decltype(_sparseHessian)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN, false));
-        _forwardOneSparsity = reinterpret_cast<decltype(_forwardOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY, false));
-        _reverseOneSparsity = reinterpret_cast<decltype(_reverseOneSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, false));
-        _reverseTwoSparsity = reinterpret_cast<decltype(_reverseTwoSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, false));
-        _jacobianSparsity = reinterpret_cast<decltype(_jacobianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY, false));
-        _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
-        _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
-        _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
+        if (!_lazyFunctionLoading) {
+            loadFunctions(FUN_ALL);
+        }
 
-        CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOne == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseReverseOne == nullptr) == (_reverseOneSparsity == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseReverseOne == nullptr) == (_reverseOne == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwoSparsity == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr), "Missing functions in the dynamic library")
-        CPPADCG_ASSERT_KNOWN((_sparseHessian == nullptr) || (_hessianSparsity != nullptr), "Missing functions in the dynamic library")
+        _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
 
         /**
          * Prepare the atomic functions argument
@@ -1009,6 +1390,137 @@ protected:
         _missingAtomicFunctions = n;
     }
 
+    /**
+     * Makes sure that functions were loaded from the model library.
+     * It only loads functions when lazy loading is used.
+     *
+     * @param functions the required functions (see Functions)
+     */
+    inline void requireFunctions(unsigned int functions) {
+        if ((_loadedFunctions.load(std::memory_order_acquire) & functions) != functions) {
+            loadFunctions(functions);
+        }
+    }
+
+    /**
+     * Loads functions from the model library (if they were not loaded yet).
+     *
+     * @param functions the functions to load (see Functions)
+     */
+    virtual void loadFunctions(unsigned int functions) {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+
+        if (!_isLibraryReady)
+            return;
+
+        unsigned int loaded = _loadedFunctions.load(std::memory_order_relaxed);
+        unsigned int missing = functions & ~loaded;
+        if (missing == 0)
+            return; // loaded by another thread
+
+        auto beginTime = std::chrono::steady_clock::now();
+
+        const std::string prefix = _name + "_";
+        if (missing & FUN_ZERO)
+            _zero = reinterpret_cast<decltype(_zero)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO, false));
+        if (missing & FUN_FORWARD_ONE)
+            _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
+        if (missing & FUN_REVERSE_ONE)
+            _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
+        if (missing & FUN_REVERSE_TWO)
+            _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
+        if (missing & FUN_JACOBIAN)
+            _jacobian = reinterpret_cast<decltype(_jacobian)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_JACOBIAN, false));
+        if (missing & FUN_HESSIAN)
+            _hessian = reinterpret_cast<decltype(_hessian)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_HESSIAN, false));
+        if (missing & FUN_SPARSE_FORWARD_ONE)
+            _sparseForwardOne = reinterpret_cast<decltype(_sparseForwardOne)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE, false));
+        if (missing & FUN_SPARSE_REVERSE_ONE)
+            _sparseReverseOne = reinterpret_cast<decltype(_sparseReverseOne)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE, false));
+        if (missing & FUN_SPARSE_REVERSE_TWO)
+            _sparseReverseTwo = reinterpret_cast<decltype(_sparseReverseTwo)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO, false));
+        if (missing & FUN_SPARSE_FORWARD_ONE_MULTI)
+            _sparseForwardOneMulti = reinterpret_cast<decltype(_sparseForwardOneMulti)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE_MULTI, false));
+        if (missing & FUN_SPARSE_REVERSE_TWO_MULTI)
+            _sparseReverseTwoMulti = reinterpret_cast<decltype(_sparseReverseTwoMulti)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO_MULTI, false));
+        if (missing & FUN_SPARSE_JACOBIAN)
+            _sparseJacobian = reinterpret_cast<decltype(_sparseJacobian)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN, false));
+        if (missing & FUN_SPARSE_HESSIAN)
+            _sparseHessian = reinterpret_cast<decltype(_sparseHessian)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN, false));
+        if (missing & FUN_ZERO_BATCH)
+            _zeroBatch = reinterpret_cast<decltype(_zeroBatch)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_BATCH, false));
+        if (missing & FUN_SPARSE_JACOBIAN_BATCH)
+            _sparseJacobianBatch = reinterpret_cast<decltype(_sparseJacobianBatch)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_BATCH, false));
+        if (missing & FUN_SPARSE_HESSIAN_BATCH)
+            _sparseHessianBatch = reinterpret_cast<decltype(_sparseHessianBatch)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN_BATCH, false));
+        if (missing & FUN_FORWARD_ONE_SPARSITY)
+            _forwardOneSparsity = reinterpret_cast<decltype(_forwardOneSparsity)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY, false));
+        if (missing & FUN_REVERSE_ONE_SPARSITY)
+            _reverseOneSparsity = reinterpret_cast<decltype(_reverseOneSparsity)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE_SPARSITY, false));
+        if (missing & FUN_REVERSE_TWO_SPARSITY)
+            _reverseTwoSparsity = reinterpret_cast<decltype(_reverseTwoSparsity)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY, false));
+        if (missing & FUN_JACOBIAN_SPARSITY)
+            _jacobianSparsity = reinterpret_cast<decltype(_jacobianSparsity)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY, false));
+        if (missing & FUN_HESSIAN_SPARSITY)
+            _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
+        if (missing & FUN_HESSIAN_SPARSITY2)
+            _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
+        if (missing & FUN_WORKSPACE_SIZE)
+            _workspaceSize = reinterpret_cast<decltype(_workspaceSize)>(loadFunction(prefix + ModelCSourceGen<Base>::FUNCTION_WORKSPACE_SIZE, false));
+
+        loaded |= missing;
+
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_FORWARD_ONE | FUN_FORWARD_ONE_SPARSITY) || ((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_FORWARD_ONE | FUN_SPARSE_FORWARD_ONE) || ((_sparseForwardOne == nullptr) == (_forwardOne == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_REVERSE_ONE | FUN_REVERSE_ONE_SPARSITY) || ((_sparseReverseOne == nullptr) == (_reverseOneSparsity == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_REVERSE_ONE | FUN_SPARSE_REVERSE_ONE) || ((_sparseReverseOne == nullptr) == (_reverseOne == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_REVERSE_TWO | FUN_REVERSE_TWO_SPARSITY) || ((_sparseReverseTwo == nullptr) == (_reverseTwoSparsity == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_REVERSE_TWO | FUN_SPARSE_REVERSE_TWO) || ((_sparseReverseTwo == nullptr) == (_reverseTwo == nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_JACOBIAN | FUN_JACOBIAN_SPARSITY) || ((_sparseJacobian == nullptr) || (_jacobianSparsity != nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_HESSIAN | FUN_HESSIAN_SPARSITY) || ((_sparseHessian == nullptr) || (_hessianSparsity != nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_JACOBIAN_BATCH | FUN_JACOBIAN_SPARSITY) || ((_sparseJacobianBatch == nullptr) || (_jacobianSparsity != nullptr)), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(!isLoaded(loaded, FUN_SPARSE_HESSIAN_BATCH | FUN_HESSIAN_SPARSITY) || ((_sparseHessianBatch == nullptr) || (_hessianSparsity != nullptr)), "Missing functions in the dynamic library")
+
+        if (_lazyFunctionLoading) {
+            _loadDurations["functions"] += std::chrono::steady_clock::now() - beginTime;
+        }
+
+        _loadedFunctions.store(loaded, std::memory_order_release);
+    }
+
+    static inline bool isLoaded(unsigned int loaded,
+                                unsigned int functions) {
+        return (loaded & functions) == functions;
+    }
+
+    /**
+     * Copies the values of a single point from an array with a
+     * structure-of-arrays layout.
+     */
+    static inline void gatherPoint(const Base* soa,
+                                   size_t size,
+                                   size_t nPoints,
+                                   size_t p,
+                                   Base* point) {
+        for (size_t i = 0; i < size; ++i) {
+            point[i] = soa[i * nPoints + p];
+        }
+    }
+
+    /**
+     * Copies the values of a single point into an array with a
+     * structure-of-arrays layout.
+     */
+    static inline void scatterPoint(const Base* point,
+                                    size_t size,
+                                    size_t nPoints,
+                                    size_t p,
+                                    Base* soa) {
+        for (size_t i = 0; i < size; ++i) {
+            soa[i * nPoints + p] = point[i];
+        }
+    }
+
     template <class VectorSet>
     inline void loadSparsity(bool set_type,
                              VectorSet& s,
@@ -1037,7 +1549,7 @@ protected:
         }
     }
 
-    inline void createDenseFromSparse(const CppAD::vector<Base>& compressed,
+    inline void createDenseFromSparse(const std::vector<Base>& compressed,
                                       unsigned long nrows, unsigned long ncols,
                                       unsigned long const* rows, unsigned long const* cols,
                                       unsigned long nnz,
@@ -1051,6 +1563,8 @@ protected:
     }
 
     virtual void modelLibraryClosed() {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+
         _isLibraryReady = false;
         _zero = nullptr;
         _forwardOne = nullptr;
@@ -42,6 +42,10 @@ protected:
     float (*_getThreadPoolGuidedMaxWork)();
     void (*_setThreadPoolNumberOfTimeMeas)(unsigned int n);
     unsigned int (*_getThreadPoolNumberOfTimeMeas)();
+    /// whether or not the functions of new models are only loaded when they are first used
+    bool _lazyFunctionLoading;
+    /// the time spent in each stage of loading this library
+    std::map<std::string, std::chrono::steady_clock::duration> _loadDurations;
 public:
 
     inline FunctorModelLibrary(FunctorModelLibrary&& other) noexcept:
@@ -59,7 +63,9 @@ public:
             _setThreadPoolGuidedMaxWork(other._setThreadPoolGuidedMaxWork),
             _getThreadPoolGuidedMaxWork(other._getThreadPoolGuidedMaxWork),
             _setThreadPoolNumberOfTimeMeas(other._setThreadPoolNumberOfTimeMeas),
-            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas) {
+            _getThreadPoolNumberOfTimeMeas(other._getThreadPoolNumberOfTimeMeas),
+            _lazyFunctionLoading(other._lazyFunctionLoading),
+            _loadDurations(std::move(other._loadDurations)) {
         other._onClose = nullptr;
     }
 
@@ -81,6 +87,42 @@ public:
         return std::unique_ptr<GenericModel<Base>> (modelFunctor(modelName).release());
     }
 
+    /**
+     * Whether or not the functions of the models created afterwards are
+     * only loaded from the library when they are first used.
+     */
+    inline bool isLazyFunctionLoading() const {
+        return _lazyFunctionLoading;
+    }
+
+    /**
+     * Defines whether or not the functions of the models created afterwards
+     * (e.g. with model()) are only loaded from the library when they are
+     * first used.
+     * This reduces the time required to create models from large libraries
+     * when only some of the model functions are used (e.g. only
+     * ForwardZero()).
+     * For dynamic libraries, it can be combined with opening the library
+     * with RTLD_LAZY.
+     *
+     * @param lazy whether or not to use lazy loading
+     */
+    inline void setLazyFunctionLoading(bool lazy) {
+        _lazyFunctionLoading = lazy;
+    }
+
+    /**
+     * Provides the time spent in each stage of loading this library (e.g.
+     * "open" and "validation").
+     * The time spent loading each model is provided by
+     * FunctorGenericModel::getLoadDurations().
+     *
+     * @return the duration of each stage
+     */
+    inline const std::map<std::string, std::chrono::steady_clock::duration>& getLoadDurations() const {
+        return _loadDurations;
+    }
+
     /**
      * Provides the API version used to create the model library.
      *
@@ -201,10 +243,13 @@ protected:
             _setThreadPoolGuidedMaxWork(nullptr),
             _getThreadPoolGuidedMaxWork(nullptr),
             _setThreadPoolNumberOfTimeMeas(nullptr),
-            _getThreadPoolNumberOfTimeMeas(nullptr) {
+            _getThreadPoolNumberOfTimeMeas(nullptr),
+            _lazyFunctionLoading(false) {
     }
 
     inline void validate() {
+        auto beginTime = std::chrono::steady_clock::now();
+
         /**
          * Check the version
          */
@@ -255,6 +300,8 @@ protected:
         if(_setThreads != nullptr) {
             (*_setThreads)(std::thread::hardware_concurrency());
         }
+
+        _loadDurations["validation"] += std::chrono::steady_clock::now() - beginTime;
     }
 };
 
@@ -135,6 +135,23 @@ public:
      */
     virtual size_t Range() const = 0;
 
+    /**
+     * Provides the number of bytes required by the temporary arrays of the
+     * compiled functions.
+     * If the temporaries were placed in a per-thread workspace (see
+     * ModelCSourceGen::setTemporariesInWorkspace()) this memory is not
+     * taken from the stack and it is the total used by each thread for all
+     * the functions, otherwise it is the stack memory of the function
+     * which uses the most memory.
+     *
+     * @param perThread set to true if the temporary arrays are placed in a
+     *                  per-thread workspace and false if they are
+     *                  allocated in the stack
+     * @return the size of the workspace in bytes (zero if the model
+     *         library does not provide this information)
+     */
+    virtual size_t getWorkspaceSize(bool& perThread) = 0;
+
     /**
      * The names of the atomic functions required by this model.
      * All external/atomic functions must be provided before using
@@ -487,6 +504,38 @@ public:
                             size_t tx1Nnz, const size_t idx[], const Base tx1[],
                             ArrayView<Base> ty1) = 0;
 
+    /**
+     * Determines whether or not a dedicated function for the first-order
+     * forward mode with multiple directions is available.
+     * The multiple direction version of ForwardOne() can still be used if
+     * it is not available but the directions are evaluated one at a time.
+     *
+     * @return true if the model has a function for the evaluation of
+     *         multiple directions
+     */
+    virtual bool isSparseForwardOneMultiAvailable() = 0;
+
+    /**
+     * Computes the first-order Taylor coefficients for dependent variables
+     * for several directions in a single call (a Jacobian-matrix product).
+     * The zero-order values and the Jacobian are only determined once for
+     * all directions.
+     * The direction index changes fastest:
+     *  \f[ ty1[ i \, nDir + k ] = \sum_j \frac{\partial F_i}{\partial x_j} tx1[ j \, nDir + k ] \f]
+     * Only the Jacobian elements used by the sparse forward mode are
+     * considered.
+     *
+     * @param x independent variable vector
+     * @param nDir the number of directions
+     * @param tx1 the seed directions (n * nDir elements)
+     * @param ty1 the directional derivatives of the dependent variables
+     *            (m * nDir elements)
+     */
+    virtual void ForwardOne(ArrayView<const Base> x,
+                            size_t nDir,
+                            ArrayView<const Base> tx1,
+                            ArrayView<Base> ty1) = 0;
+
     /***********************************************************************
      *                        Reverse one
      **********************************************************************/
@@ -672,6 +721,40 @@ public:
                             ArrayView<Base> px2,
                             ArrayView<const Base> py2) = 0;
 
+    /**
+     * Determines whether or not a dedicated function for the second-order
+     * reverse mode with multiple directions is available.
+     * The multiple direction version of ReverseTwo() can still be used if
+     * it is not available but the directions are evaluated one at a time.
+     *
+     * @return true if the model has a function for the evaluation of
+     *         multiple directions
+     */
+    virtual bool isSparseReverseTwoMultiAvailable() = 0;
+
+    /**
+     * Computes second-order results during a reverse mode sweep (p = 2)
+     * for several directions in a single call (Hessian-vector products).
+     * The zero-order values and the Hessian are only determined once for
+     * all directions.
+     * The direction index changes fastest:
+     *  \f[ px2[ j \, nDir + k ] = \sum_l \frac{\partial^2 }{\partial x_l \partial x_j } \left( \sum_{i} py2_i F_i \right) tx1[ l \, nDir + k ] \f]
+     *
+     * @param x independent variable vector
+     * @param nDir the number of directions
+     * @param tx1 the first-order Taylor coefficients of the independents
+     *            for all directions (n * nDir elements)
+     * @param px2 second-order partials of the independents for all
+     *            directions (n * nDir elements)
+     * @param py2 second-order partials of the dependents
+     *            (should have the size of the dependent variables)
+     */
+    virtual void ReverseTwo(ArrayView<const Base> x,
+                            size_t nDir,
+                            ArrayView<const Base> tx1,
+                            ArrayView<Base> px2,
+                            ArrayView<const Base> py2) = 0;
+
     /***********************************************************************
      *                        Sparse Jacobians
      **********************************************************************/
@@ -769,6 +852,42 @@ public:
                                 size_t const** row,
                                 size_t const** col) = 0;
 
+    /**
+     * Provides the Jacobian sparsity pattern in a compressed format
+     * (CSR or CSC according to the format of the provided object).
+     * This should be done only once since it requires memory allocations.
+     *
+     * @param sparsity the compressed sparsity pattern (its format must
+     *                 already be defined)
+     */
+    template<class Index>
+    inline void JacobianSparsity(CompressedSparsity<Index>& sparsity) {
+        std::vector<size_t> rows, cols;
+        JacobianSparsity(rows, cols);
+        sparsity.setPattern(Range(), Domain(), rows.data(), cols.data(), rows.size());
+    }
+
+    /**
+     * Calculates a Jacobian using sparse methods and places the values
+     * directly in the order of a compressed sparse format (CSR or CSC)
+     * without any memory allocation.
+     *
+     * @param x independent variable array (must have n elements)
+     * @param sparsity the compressed sparsity pattern previously obtained
+     *                 with JacobianSparsity(CompressedSparsity<Index>&)
+     * @param jac the values of the Jacobian in the compressed order
+     *            (must have sparsity.getNonZeros() elements)
+     */
+    template<class Index>
+    inline void SparseJacobian(ArrayView<const Base> x,
+                               const CompressedSparsity<Index>& sparsity,
+                               ArrayView<Base> jac) {
+        size_t const* row;
+        size_t const* col;
+        SparseJacobian(x, jac, &row, &col);
+        sparsity.permute(jac.data());
+    }
+
     /***********************************************************************
      *                        Sparse Hessians
      **********************************************************************/
@@ -879,6 +998,151 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /**
+     * Provides the sparsity pattern of the weighted sum of the Hessians in
+     * a compressed format (CSR or CSC according to the format of the
+     * provided object).
+     * Only the elements provided by the compiled model are included
+     * (e.g. only the lower triangle if the model was created that way).
+     * This should be done only once since it requires memory allocations.
+     *
+     * @param sparsity the compressed sparsity pattern (its format must
+     *                 already be defined)
+     */
+    template<class Index>
+    inline void HessianSparsity(CompressedSparsity<Index>& sparsity) {
+        std::vector<size_t> rows, cols;
+        HessianSparsity(rows, cols);
+        sparsity.setPattern(Domain(), Domain(), rows.data(), cols.data(), rows.size());
+    }
+
+    /**
+     * Determines the sparse weighted sum of the Hessians and places the
+     * values directly in the order of a compressed sparse format (CSR or
+     * CSC) without any memory allocation.
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param sparsity the compressed sparsity pattern previously obtained
+     *                 with HessianSparsity(CompressedSparsity<Index>&)
+     * @param hess the values of the Hessian in the compressed order
+     *             (must have sparsity.getNonZeros() elements)
+     */
+    template<class Index>
+    inline void SparseHessian(ArrayView<const Base> x,
+                              ArrayView<const Base> w,
+                              const CompressedSparsity<Index>& sparsity,
+                              ArrayView<Base> hess) {
+        size_t const* row;
+        size_t const* col;
+        SparseHessian(x, w, hess, &row, &col);
+        sparsity.permute(hess.data());
+    }
+
+    /***********************************************************************
+     *                   Evaluation at multiple points
+     **********************************************************************/
+
+    /**
+     * Determines whether or not a dedicated function for the zero-order
+     * forward mode at multiple points is available.
+     * ForwardZeroBatch() can still be used if it is not available but
+     * the points are evaluated one at a time.
+     *
+     * @return true if the model has a function for the evaluation at
+     *         multiple points
+     */
+    virtual bool isForwardZeroBatchAvailable() = 0;
+
+    /**
+     * Evaluates the dependent model variables (zero-order) at several
+     * points.
+     * The values use a structure-of-arrays layout:
+     *  \f[ dep[ i \, nPoints + p ] = F_i( x^{(p)} ) \f]
+     * where \f$ x^{(p)}_j = x[ j \, nPoints + p ] \f$.
+     *
+     * @param x The independent variables of all points (n * nPoints elements)
+     * @param nPoints The number of points
+     * @param dep The dependent variables of all points
+     */
+    template<typename VectorBase>
+    inline void ForwardZeroBatch(const VectorBase& x,
+                                 size_t nPoints,
+                                 VectorBase& dep) {
+        dep.resize(Range() * nPoints);
+        this->ForwardZeroBatch(ArrayView<const Base>(&x[0], x.size()),
+                               nPoints,
+                               ArrayView<Base>(&dep[0], dep.size()));
+    }
+
+    /**
+     * @copydoc GenericModel::ForwardZeroBatch(const VectorBase&, size_t, VectorBase&)
+     */
+    virtual void ForwardZeroBatch(ArrayView<const Base> x,
+                                  size_t nPoints,
+                                  ArrayView<Base> dep) = 0;
+
+    /**
+     * Determines whether or not a dedicated function for the sparse
+     * Jacobian at multiple points is available.
+     * SparseJacobianBatch() can still be used if it is not available but
+     * the points are evaluated one at a time.
+     *
+     * @return true if the model has a function for the evaluation at
+     *         multiple points
+     */
+    virtual bool isSparseJacobianBatchAvailable() = 0;
+
+    /**
+     * Calculates the sparse Jacobian at several points.
+     * The values use a structure-of-arrays layout:
+     *  \f[ jac[ e \, nPoints + p ] = \frac{\partial F_{row[e]}( x^{(p)} ) }{\partial x_{col[e]} } \f]
+     * where \f$ x^{(p)}_j = x[ j \, nPoints + p ] \f$.
+     *
+     * @param x The independent variables of all points (n * nPoints elements)
+     * @param nPoints The number of points
+     * @param jac The values of the sparse Jacobians (nnz * nPoints elements)
+     * @param row The row indices of the Jacobian values
+     * @param col The column indices of the Jacobian values
+     */
+    virtual void SparseJacobianBatch(ArrayView<const Base> x,
+                                     size_t nPoints,
+                                     ArrayView<Base> jac,
+                                     size_t const** row,
+                                     size_t const** col) = 0;
+
+    /**
+     * Determines whether or not a dedicated function for the sparse
+     * Hessian at multiple points is available.
+     * SparseHessianBatch() can still be used if it is not available but
+     * the points are evaluated one at a time.
+     *
+     * @return true if the model has a function for the evaluation at
+     *         multiple points
+     */
+    virtual bool isSparseHessianBatchAvailable() = 0;
+
+    /**
+     * Calculates the sparse weighted sum of the Hessians at several points.
+     * The values use a structure-of-arrays layout:
+     *  \f[ hess[ e \, nPoints + p ] = \frac{\partial^2 }{\partial x_{row[e]} \partial x_{col[e]} } \sum_{i} w^{(p)}_i F_i( x^{(p)} ) \f]
+     * where \f$ x^{(p)}_j = x[ j \, nPoints + p ] \f$ and
+     * \f$ w^{(p)}_i = w[ i \, nPoints + p ] \f$.
+     *
+     * @param x The independent variables of all points (n * nPoints elements)
+     * @param w The equation multipliers of all points (m * nPoints elements)
+     * @param nPoints The number of points
+     * @param hess The values of the sparse Hessians (nnz * nPoints elements)
+     * @param row The row indices of the Hessian values
+     * @param col The column indices of the Hessian values
+     */
+    virtual void SparseHessianBatch(ArrayView<const Base> x,
+                                    ArrayView<const Base> w,
+                                    size_t nPoints,
+                                    ArrayView<Base> hess,
+                                    size_t const** row,
+                                    size_t const** col) = 0;
+
     /**
      * Provides a wrapper for this compiled model allowing it to be used as
      * an atomic function. The model must not be deleted while the atomic
@@ -55,10 +55,12 @@ protected:
 
         CPPADCG_ASSERT_UNKNOWN(_dynLib != nullptr);
 
+        this->_lazyFunctionLoading = _dynLib->isLazyFunctionLoading();
         this->init();
     }
 
     void* loadFunction(const std::string& functionName, bool required = true) override {
+        std::lock_guard<std::mutex> lock(_dynLib->_loadMutex);
         return _dynLib->loadFunction(functionName, required);
     }
 
@@ -31,6 +31,13 @@ template<class Base>
 class LlvmModelLibrary : public FunctorModelLibrary<Base> {
 protected:
     std::set<LlvmModel<Base>*> _models;
+    /**
+     * the functions of all the models are compiled by the same LLVM
+     * module, context, and execution engine, therefore they must be
+     * loaded one at a time (models can load their functions lazily from
+     * different threads)
+     */
+    std::mutex _loadMutex;
 public:
     inline virtual ~LlvmModelLibrary() {
         // do not call clean-up here
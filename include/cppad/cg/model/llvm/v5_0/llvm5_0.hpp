@@ -54,6 +54,7 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 //#include <llvm/ExecutionEngine/JIT.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
@@ -64,6 +65,7 @@
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Support/ManagedStatic.h>
 #include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
 //#include <llvm/Support/system_error.h>
@@ -87,6 +89,7 @@
 #include <cppad/cg/model/compiler/clang_compiler.hpp>
 #include <cppad/cg/model/llvm/llvm_model_library.hpp>
 #include <cppad/cg/model/llvm/llvm_model.hpp>
+#include <cppad/cg/model/llvm/v5_0/llvm_object_cache.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_impl.hpp>
 #include <cppad/cg/model/llvm/v5_0/llvm_model_library_processor.hpp>
 
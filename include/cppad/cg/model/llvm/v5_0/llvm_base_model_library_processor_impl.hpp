@@ -34,6 +34,14 @@ protected:
     std::shared_ptr<llvm::LLVMContext> _context; // must be deleted after _linker and _module (it must come first)
     std::unique_ptr<llvm::Linker> _linker;
     std::unique_ptr<llvm::Module> _module;
+    /// the number of threads used to compile the sources (0 for the number of hardware threads)
+    unsigned int _threads;
+    /// the default optimization level
+    unsigned int _optimizationLevel;
+    /// the optimization level of specific models
+    std::map<std::string, unsigned int> _modelOptimizationLevel;
+    /// folder with previously compiled modules (empty if disabled)
+    std::string _cacheFolder;
 public:
 
     /**
@@ -44,7 +52,9 @@ public:
     LlvmBaseModelLibraryProcessorImpl(ModelLibraryCSourceGen<Base>& librarySourceGen,
                                       std::string version) :
         LlvmBaseModelLibraryProcessor<Base>(librarySourceGen),
-            _version(std::move(version)) {
+            _version(std::move(version)),
+            _threads(1),
+            _optimizationLevel(0) {
     }
 
     virtual ~LlvmBaseModelLibraryProcessorImpl() = default;
@@ -70,6 +80,96 @@ public:
         return _includePaths;
     }
 
+    /**
+     * Provides the number of threads used to compile the sources with the
+     * Clang frontend.
+     *
+     * @return the number of threads (0 for the number of hardware threads)
+     */
+    inline unsigned int getThreadNumber() const {
+        return _threads;
+    }
+
+    /**
+     * Defines the number of threads used to compile the sources with the
+     * Clang frontend.
+     * Each thread uses its own LLVM context and the resulting modules are
+     * linked together into a single module at the end.
+     *
+     * @param n the number of threads (0 for the number of hardware threads)
+     */
+    inline void setThreadNumber(unsigned int n) {
+        _threads = n;
+    }
+
+    /**
+     * @return the optimization level used for the sources of models without
+     *         a specific optimization level and for the library sources
+     */
+    inline unsigned int getOptimizationLevel() const {
+        return _optimizationLevel;
+    }
+
+    /**
+     * Defines the optimization level (as in -O0, -O1, -O2, -O3) used for
+     * the sources of models without a specific optimization level and for
+     * the library sources.
+     *
+     * @param level the optimization level
+     */
+    inline void setOptimizationLevel(unsigned int level) {
+        _optimizationLevel = level;
+    }
+
+    /**
+     * @param model the model name
+     * @return the optimization level used for the sources of a model
+     */
+    inline unsigned int getModelOptimizationLevel(const std::string& model) const {
+        auto it = _modelOptimizationLevel.find(model);
+        if (it != _modelOptimizationLevel.end())
+            return it->second;
+        return _optimizationLevel;
+    }
+
+    /**
+     * Defines the optimization level (as in -O0, -O1, -O2, -O3) used for
+     * the sources of a specific model.
+     * A higher level leads to faster model evaluations at the cost of a
+     * longer compilation.
+     *
+     * @param model the model name
+     * @param level the optimization level
+     */
+    inline void setModelOptimizationLevel(const std::string& model,
+                                          unsigned int level) {
+        _modelOptimizationLevel[model] = level;
+    }
+
+    /**
+     * @return the folder where compiled modules are cached
+     *         (empty if caching is disabled)
+     */
+    inline const std::string& getCacheFolder() const {
+        return _cacheFolder;
+    }
+
+    /**
+     * Defines a folder where the LLVM bitcode and the machine code of the
+     * created libraries are cached.
+     * Files are identified by a hash of the source code, the LLVM version,
+     * the optimization levels, the include paths, the host target, and the
+     * CppADCodeGen version.
+     * Libraries previously created from the same sources are loaded
+     * without running Clang and without generating machine code again.
+     * The folder can be shared among processes.
+     *
+     * @param cacheFolder path to the cache folder (empty disables caching)
+     */
+    inline void setCacheFolder(const std::string& cacheFolder) {
+        _cacheFolder = cacheFolder;
+    }
+
     /**
      *
      * @return a model library
@@ -88,27 +188,66 @@ public:
 
         _context.reset(new llvm::LLVMContext());
 
+        std::vector<LlvmSource> sources;
+
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         for (const auto& p : models) {
             const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
-            createLlvmModules(modelSources);
+            addLlvmSources(sources, modelSources, getModelOptimizationLevel(p.first));
         }
 
-        const std::map<std::string, std::string>& sources = this->getLibrarySources();
-        createLlvmModules(sources);
+        const std::map<std::string, std::string>& libSources = this->getLibrarySources();
+        addLlvmSources(sources, libSources, _optimizationLevel);
 
         const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-        createLlvmModules(customSource);
+        addLlvmSources(sources, customSource, _optimizationLevel);
+
+        std::unique_ptr<llvm::ObjectCache> objectCache;
+        if (_cacheFolder.empty()) {
+            createLlvmModules(sources);
+        } else {
+            std::string key = createCacheKey(sources);
+            CompilerCache cache(_cacheFolder);
+
+            if (!loadCachedModule(cache.getPath(key + ".bc"))) {
+                createLlvmModules(sources);
+                saveModule(cache, key + ".bc");
+            }
+            objectCache.reset(new LlvmObjectCache(_cacheFolder, key + ".o"));
+        }
 
         llvm::InitializeNativeTarget();
 
-        std::unique_ptr<LlvmModelLibrary<Base>> lib(new LlvmModelLibraryImpl<Base>(std::move(_module), _context));
+        std::unique_ptr<LlvmModelLibrary<Base>> lib(new LlvmModelLibraryImpl<Base>(std::move(_module), _context,
+                                                                                   std::move(objectCache)));
 
         this->modelLibraryHelper_->finishedJob();
 
         return lib;
     }
 
+    /**
+     * Creates a model library in a new thread.
+     * The progress is reported to the listeners of the model library
+     * source generator (from the new thread) and the creation can be
+     * cancelled with ModelLibraryCSourceGen::cancel(), in which case the
+     * future provides a CGCancelledException.
+     * This processor, the model library source generator, and its models
+     * must not be used or deleted until the library is created.
+     * If CppAD is used by other threads in the meanwhile, it must be
+     * prepared for multithreading with a CppADParallelSetup created before
+     * this call and destroyed after the library is created.
+     *
+     * @return a model library
+     */
+    std::future<std::unique_ptr<LlvmModelLibrary<Base>>> createAsync() {
+        this->modelLibraryHelper_->clearCancellation();
+
+        return std::async(std::launch::async, [this]() {
+            return create();
+        });
+    }
+
     /**
      * Creates a LLVM model library using an external Clang compiler to
      * generate the bitcode.
@@ -194,14 +333,190 @@ public:
 
 protected:
 
-    virtual void createLlvmModules(const std::map<std::string, std::string>& sources) {
+    /**
+     * A source file to be compiled into a LLVM module
+     */
+    struct LlvmSource {
+        const std::string* filename;
+        const std::string* source;
+        unsigned int optimizationLevel;
+    };
+
+    static inline void addLlvmSources(std::vector<LlvmSource>& llvmSources,
+                                      const std::map<std::string, std::string>& sources,
+                                      unsigned int optimizationLevel) {
         for (const auto& p : sources) {
-            createLlvmModule(p.first, p.second);
+            llvmSources.push_back(LlvmSource{&p.first, &p.second, optimizationLevel});
+        }
+    }
+
+    virtual void createLlvmModules(const std::vector<LlvmSource>& sources) {
+        size_t nThreads = _threads > 0 ? _threads : std::max(std::thread::hardware_concurrency(), 1u);
+        nThreads = std::min(nThreads, sources.size());
+
+        if (nThreads <= 1) {
+            for (const LlvmSource& s : sources) {
+                std::unique_ptr<llvm::Module> module = createLlvmModule(*s.filename, *s.source, s.optimizationLevel, *_context);
+                linkLlvmModule(std::move(module), _module, _linker);
+            }
+            return;
+        }
+
+        /**
+         * compile the sources in several threads (each with its own context)
+         * and then move the resulting modules into the main context
+         */
+        std::atomic<size_t> next(0);
+        std::vector<std::future<std::string>> bitcodes;
+        bitcodes.reserve(nThreads);
+        for (size_t t = 0; t < nThreads; t++) {
+            bitcodes.push_back(std::async(std::launch::async, [this, &sources, &next]() {
+                return createLlvmBitcode(sources, next);
+            }));
+        }
+
+        for (auto& f: bitcodes) {
+            std::string bitcode;
+            try {
+                bitcode = f.get();
+            } catch (...) {
+                next = sources.size(); // stop the other threads as soon as possible
+                throw;
+            }
+            if (bitcode.empty())
+                continue;
+
+            llvm::MemoryBufferRef buffer(bitcode, "bitcode");
+            llvm::Expected<std::unique_ptr<llvm::Module>> moduleOrError = llvm::parseBitcodeFile(buffer, *_context);
+            if (!moduleOrError) {
+                std::ostringstream error;
+                size_t nError = 0;
+                handleAllErrors(moduleOrError.takeError(), [&](llvm::ErrorInfoBase& eib) {
+                    if (nError > 0) error << "; ";
+                    error << eib.message();
+                    nError++;
+                });
+                throw CGException(error.str());
+            }
+
+            linkLlvmModule(std::move(moduleOrError.get()), _module, _linker);
+        }
+    }
+
+    /**
+     * Compiles sources into a single module until there are no more sources
+     * left (used by each compilation thread).
+     *
+     * @param sources all the sources to be compiled
+     * @param next the index of the next source to be compiled (shared by all threads)
+     * @return the bitcode of the module (empty if no source was compiled)
+     */
+    virtual std::string createLlvmBitcode(const std::vector<LlvmSource>& sources,
+                                          std::atomic<size_t>& next) {
+        llvm::LLVMContext context; // must be deleted after linker and module
+        std::unique_ptr<llvm::Module> module;
+        std::unique_ptr<llvm::Linker> linker;
+
+        for (size_t i = next++; i < sources.size(); i = next++) {
+            const LlvmSource& s = sources[i];
+            linkLlvmModule(createLlvmModule(*s.filename, *s.source, s.optimizationLevel, context), module, linker);
+        }
+
+        std::string bitcode;
+        if (module != nullptr) {
+            llvm::raw_string_ostream os(bitcode);
+#if LLVM_VERSION_MAJOR >= 7
+            llvm::WriteBitcodeToFile(*module, os);
+#else
+            llvm::WriteBitcodeToFile(module.get(), os);
+#endif
+            os.flush();
+        }
+        return bitcode;
+    }
+
+    /**
+     * Creates the key used to identify the files of a library in the cache.
+     *
+     * @param sources all the sources of the library
+     * @return the cache key
+     */
+    virtual std::string createCacheKey(const std::vector<LlvmSource>& sources) const {
+        ContentHash h = CompilerCache::createHash();
+        h.add(LLVM_VERSION_STRING);
+        h.add(llvm::sys::getProcessTriple());
+        h.add(llvm::sys::getHostCPUName().str());
+        h.add(_includePaths);
+        h.add(sources.size());
+        for (const LlvmSource& s : sources) {
+            h.add(*s.filename);
+            h.add(*s.source);
+            h.add(s.optimizationLevel);
         }
+        return h.str();
     }
 
-    virtual void createLlvmModule(const std::string& filename,
-                                  const std::string& source) {
+    /**
+     * Loads a module previously saved in the cache into the main context.
+     *
+     * @param file the path to the cached bitcode file
+     * @return true if the module was loaded
+     */
+    virtual bool loadCachedModule(const std::string& file) {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(file);
+        if (!buffer)
+            return false; // not cached
+
+        llvm::Expected<std::unique_ptr<llvm::Module>> moduleOrError = llvm::parseBitcodeFile(buffer.get()->getMemBufferRef(), *_context);
+        if (!moduleOrError) {
+            llvm::consumeError(moduleOrError.takeError()); // e.g. a corrupted file which will be replaced
+            return false;
+        }
+
+        this->modelLibraryHelper_->startingJob("", JobTimer::REUSING_CACHED);
+        _module = std::move(moduleOrError.get());
+        this->modelLibraryHelper_->finishedJob();
+        return true;
+    }
+
+    /**
+     * Saves the bitcode of the main module in the cache.
+     * Failures are ignored since the cache is only an optimization.
+     */
+    virtual void saveModule(const CompilerCache& cache,
+                            const std::string& key) {
+        if (_module == nullptr)
+            return;
+
+        std::string bitcode;
+        llvm::raw_string_ostream os(bitcode);
+#if LLVM_VERSION_MAJOR >= 7
+        llvm::WriteBitcodeToFile(*_module, os);
+#else
+        llvm::WriteBitcodeToFile(_module.get(), os);
+#endif
+        os.flush();
+
+        cache.store(key, bitcode.data(), bitcode.size());
+    }
+
+    static inline void linkLlvmModule(std::unique_ptr<llvm::Module> module,
+                                      std::unique_ptr<llvm::Module>& linkerModule,
+                                      std::unique_ptr<llvm::Linker>& linker) {
+        if (linker == nullptr) {
+            linkerModule = std::move(module);
+            linker.reset(new llvm::Linker(*linkerModule.get()));
+        } else {
+            if (linker->linkInModule(std::move(module))) {
+                throw CGException("LLVM failed to link module");
+            }
+        }
+    }
+
+    virtual std::unique_ptr<llvm::Module> createLlvmModule(const std::string& filename,
+                                                           const std::string& source,
+                                                           unsigned int optimizationLevel,
+                                                           llvm::LLVMContext& context) {
         using namespace llvm;
         using namespace clang;
 
@@ -213,7 +528,8 @@ protected:
         IntrusiveRefCntPtr<DiagnosticIDs> diagID(new DiagnosticIDs());
         IntrusiveRefCntPtr<DiagnosticsEngine> diags(new DiagnosticsEngine(diagID, &*diagOpts, diagClient));
 
-        std::vector<const char*> args {"-Wall", "-x", "c", "string-input"}; // -Wall or -v flag is required to avoid an error inside createInvocationFromCommandLine()
+        std::string optFlag = "-O" + std::to_string(optimizationLevel);
+        std::vector<const char*> args {"-Wall", optFlag.c_str(), "-x", "c", "string-input"}; // -Wall or -v flag is required to avoid an error inside createInvocationFromCommandLine()
         std::shared_ptr<CompilerInvocation> invocation(createInvocationFromCommandLine(args, diags));
         if (invocation == nullptr)
             throw CGException("Failed to create compiler invocation");
@@ -260,7 +576,7 @@ protected:
             hso.AddPath(llvm::StringRef(_includePaths[s]), clang::frontend::Angled, false, false);
 
         // Create and execute the frontend to generate an LLVM bitcode module.
-        clang::EmitLLVMOnlyAction action(_context.get());
+        clang::EmitLLVMOnlyAction action(&context);
         if (!compiler.ExecuteAction(action))
             throw CGException("Failed to emit LLVM bitcode");
 
@@ -268,18 +584,9 @@ protected:
         if (module == nullptr)
             throw CGException("No module");
 
-        if (_linker == nullptr) {
-            _module = std::move(module);
-            _linker.reset(new llvm::Linker(*_module.get()));
-        } else {
-            if (_linker->linkInModule(std::move(module))) {
-                throw CGException("LLVM failed to link module");
-            }
-        }
-
-        // NO delete module;
         // NO delete invocation;
         //llvm::llvm_shutdown();
+        return module;
     }
 
 };
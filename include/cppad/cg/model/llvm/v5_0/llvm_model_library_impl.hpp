@@ -31,14 +31,23 @@ class LlvmModelLibraryImpl : public LlvmModelLibrary<Base> {
 protected:
     llvm::Module* _module; // owned by _executionEngine
     std::shared_ptr<llvm::LLVMContext> _context;
+    std::unique_ptr<llvm::ObjectCache> _objectCache; // must be deleted after _executionEngine
     std::unique_ptr<llvm::ExecutionEngine> _executionEngine;
     std::unique_ptr<llvm::legacy::FunctionPassManager> _fpm;
 public:
 
+    /**
+     * @param module the module with all the model functions
+     * @param context the context of the module
+     * @param objectCache an optional cache for the machine code generated
+     *                    for the module
+     */
     LlvmModelLibraryImpl(std::unique_ptr<llvm::Module> module,
-                         std::shared_ptr<llvm::LLVMContext> context) :
+                         std::shared_ptr<llvm::LLVMContext> context,
+                         std::unique_ptr<llvm::ObjectCache> objectCache = nullptr) :
         _module(module.get()),
-        _context(context) {
+        _context(context),
+        _objectCache(std::move(objectCache)) {
         using namespace llvm;
 
         // Create the JIT.  This takes ownership of the module.
@@ -55,6 +64,10 @@ public:
             throw CGException("Could not create ExecutionEngine: ", errStr);
         }
 
+        if (_objectCache != nullptr) {
+            _executionEngine->setObjectCache(_objectCache.get());
+        }
+
         _fpm.reset(new llvm::legacy::FunctionPassManager(_module));
 
         preparePassManager();
@@ -0,0 +1,61 @@
+#ifndef CPPAD_CG_LLVM_OBJECT_CACHE_INCLUDED
+#define CPPAD_CG_LLVM_OBJECT_CACHE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Keeps the machine code generated by the JIT for a LLVM module in a
+ * CompilerCache folder so that it does not have to be generated again
+ * in the following executions.
+ *
+ * @author Joao Leal
+ */
+class LlvmObjectCache : public llvm::ObjectCache {
+protected:
+    const CompilerCache _cache;
+    const std::string _key;
+public:
+
+    /**
+     * @param folder the cache folder
+     * @param key the key of the object file for the module in the cache
+     */
+    inline LlvmObjectCache(const std::string& folder,
+                           std::string key) :
+        _cache(folder),
+        _key(std::move(key)) {
+    }
+
+    void notifyObjectCompiled(const llvm::Module* module,
+                              llvm::MemoryBufferRef obj) override {
+        _cache.store(_key, obj.getBufferStart(), obj.getBufferSize());
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(_cache.getPath(_key));
+        if (!buffer)
+            return nullptr; // not cached yet
+
+        return std::move(buffer.get());
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -49,17 +49,23 @@ public:
     static const std::string FUNCTION_REVERSE_TWO;
     static const std::string FUNCTION_SPARSE_JACOBIAN;
     static const std::string FUNCTION_SPARSE_HESSIAN;
+    static const std::string FUNCTION_FORWARD_ZERO_BATCH;
+    static const std::string FUNCTION_SPARSE_JACOBIAN_BATCH;
+    static const std::string FUNCTION_SPARSE_HESSIAN_BATCH;
     static const std::string FUNCTION_JACOBIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY;
     static const std::string FUNCTION_HESSIAN_SPARSITY2;
     static const std::string FUNCTION_SPARSE_FORWARD_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_ONE;
     static const std::string FUNCTION_SPARSE_REVERSE_TWO;
+    static const std::string FUNCTION_SPARSE_FORWARD_ONE_MULTI;
+    static const std::string FUNCTION_SPARSE_REVERSE_TWO_MULTI;
     static const std::string FUNCTION_FORWARD_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
+    static const std::string FUNCTION_WORKSPACE_SIZE;
 protected:
     static const std::string CONST;
 
@@ -135,6 +141,25 @@ protected:
         std::set<size_t> forbiddenRows;
     };
 
+    /**
+     * Where the source code of the function for a single column/row of a
+     * directional derivative is placed, so that several columns/rows can be
+     * generated concurrently
+     */
+    class DirectionalSourceGen {
+    public:
+        /// the model (or a copy of the model used only by the current thread)
+        ADFun<CGBase>* fun;
+        /// used to report the jobs (can be null)
+        JobTimer* timer;
+        /// the names of the atomic functions used by the generated code
+        std::vector<std::string>* atomicFunctions;
+        /// receives the generated source code
+        SourceSink* sources;
+        size_t maxLiveTemporaries;
+        size_t workspaceSize;
+    };
+
 protected:
     /**
      * the original model
@@ -149,6 +174,11 @@ protected:
      * loop models
      */
     std::set<LoopModel<Base>*> _loopTapes;
+    /**
+     * whether or not loops were found by the last source code generation
+     * (also restored when the sources are reused)
+     */
+    bool _loopsDetected;
     /**
      * the name of the model
      */
@@ -171,6 +201,11 @@ protected:
      * model library (experimental).
      */
     bool _multiThreading;
+    /**
+     * The maximum number of tasks used to evaluate the sparse Jacobian and
+     * the sparse Hessian of models with loops in multithreaded code.
+     */
+    size_t _multiThreadingLoopTasks;
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
@@ -203,6 +238,29 @@ protected:
      * functions when _sparseHessian is true
      */
     bool _sparseHessianReusesRev2;
+    /**
+     * whether or not the sparse Jacobian should be evaluated using one
+     * directional derivative function for each color of a coloring of the
+     * Jacobian columns (forward mode) or rows (reverse mode)
+     */
+    bool _sparseJacobianColoring;
+    /**
+     * whether or not the sparse Hessian should be evaluated using one
+     * directional derivative function for each color of a coloring of the
+     * Hessian columns
+     */
+    bool _sparseHessianColoring;
+    /**
+     * generate source code for the evaluation of the forward zero, sparse
+     * Jacobian, and sparse Hessian at multiple points
+     */
+    bool _batch;
+    /**
+     * generate source code for the first-order forward mode and the
+     * second-order reverse mode with multiple directions at once
+     * (only used when _forwardOne or _reverseTwo are true)
+     */
+    bool _multiDirection;
     JacobianADMode _jacMode;
     /**
      * Custom Jacobian element indexes
@@ -238,6 +296,31 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * whether or not to reorder operations to reduce the number of
+     * temporary variables alive at the same time
+     */
+    bool _minimizeLiveVariables;
+    /**
+     * the highest number of temporary variables alive at the same time
+     * in the generated functions
+     */
+    size_t _maxLiveTemporaries;
+    /**
+     * whether or not the temporary arrays are placed in a per-thread
+     * workspace instead of the stack
+     */
+    bool _temporariesInWorkspace;
+    /**
+     * the number of bytes required by the temporary arrays of the
+     * generated functions (see getWorkspaceSize())
+     */
+    size_t _workspaceSize;
+    /**
+     * the number of threads used to generate the functions of each
+     * column/row of the directional derivatives
+     */
+    size_t _sourceGenThreads;
     /**
      *
      */
@@ -280,6 +363,15 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * places the generated source code in _sources
+     */
+    SourceMapSink _sourcesSink;
+    /**
+     * receives the generated source code (_sourcesSink unless the sources
+     * are being provided to another sink)
+     */
+    SourceSink* _sink;
 public:
 
     /**
@@ -293,10 +385,12 @@ public:
                     std::string model) :
         _fun(fun),
         _funNoLoops(nullptr),
+        _loopsDetected(false),
         _name(std::move(model)),
         _baseTypeName(ModelCSourceGen<Base>::baseTypeName()),
         _parameterPrecision(std::numeric_limits<Base>::digits10),
         _multiThreading(true),
+        _multiThreadingLoopTasks(8),
         _zero(true),
         _zeroEvaluated(false),
         _jacobian(false),
@@ -309,11 +403,22 @@ public:
         _reverseTwo(false),
         _sparseJacobianReusesOne(true),
         _sparseHessianReusesRev2(true),
+        _sparseJacobianColoring(false),
+        _sparseHessianColoring(false),
+        _batch(false),
+        _multiDirection(false),
         _jacMode(JacobianADMode::Automatic),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _minimizeLiveVariables(false),
+        _maxLiveTemporaries(0),
+        _temporariesInWorkspace(false),
+        _workspaceSize(0),
+        _sourceGenThreads(1),
+        _jobTimer(nullptr),
+        _sourcesSink(_sources),
+        _sink(&_sourcesSink) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -391,11 +496,13 @@ public:
      * Returns whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
      * Multithreaded code is only generated if requested by the model library.
-     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled,
-     * at least one of _forwardOne and _reverseOne must be enabled, and loop
-     * detection must be disabled.
+     * For the sparse Jacobian, the _sparseJacobianReusesOne and at least one
+     * of _forwardOne and _reverseOne must be enabled, or the
+     * _sparseJacobianColoring must be enabled and loop detection must be
+     * disabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
-     * must be enabled and loop detection must be disabled.
+     * must be enabled, or the _sparseHessianColoring must be enabled and
+     * loop detection must be disabled.
      *
      * @return whether or not multithreading can be used for this model
      */
@@ -407,11 +514,13 @@ public:
      * Defines whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
      * Multithreaded code is only generated if requested by the model library.
-     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled,
-     * at least one of _forwardOne and _reverseOne must be enabled, and loop
-     * detection must be disabled.
+     * For the sparse Jacobian, the _sparseJacobianReusesOne and at least one
+     * of _forwardOne and _reverseOne must be enabled, or the
+     * _sparseJacobianColoring must be enabled and loop detection must be
+     * disabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
-     * must be enabled and loop detection must be disabled.
+     * must be enabled, or the _sparseHessianColoring must be enabled and
+     * loop detection must be disabled.
      *
      * @param multiThreading whether or not multithreading can be used for this
      *                       model
@@ -420,12 +529,45 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Provides the maximum number of tasks used to evaluate the sparse
+     * Jacobian and the sparse Hessian of models with loops in multithreaded
+     * code.
+     *
+     * @return the maximum number of tasks
+     */
+    inline size_t getMultiThreadingLoopTasks() const {
+        return _multiThreadingLoopTasks;
+    }
+
+    /**
+     * Defines the maximum number of tasks used to evaluate the sparse
+     * Jacobian and the sparse Hessian of models with loops in multithreaded
+     * code.
+     * The function calls are split into tasks with a similar number of
+     * calls (a loop can be split across several tasks) which are executed
+     * in parallel.
+     * Each task adds its contributions to its own copy of the result and
+     * these copies are summed at the end.
+     * More tasks improve the load balancing but require more memory and a
+     * longer final summation, this value should not be much higher than the
+     * number of threads used to evaluate the model.
+     *
+     * @param tasks the maximum number of tasks
+     */
+    inline void setMultiThreadingLoopTasks(size_t tasks) {
+        CPPADCG_ASSERT_KNOWN(tasks > 0, "The number of tasks must be greater than zero")
+        _multiThreadingLoopTasks = tasks;
+    }
+
     inline bool isJacobianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseJacobian && _sparseJacobianReusesOne && (_forwardOne || _reverseOne);
+        return _multiThreading && _sparseJacobian &&
+                ((_sparseJacobianColoring && !_loopsDetected) || (_sparseJacobianReusesOne && (_forwardOne || _reverseOne)));
     }
 
     inline bool isHessianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
+        return _multiThreading && _sparseHessian &&
+                ((_sparseHessianColoring && !_loopsDetected) || (_sparseHessianReusesRev2 && _reverseTwo));
     }
 
     /**
@@ -562,6 +704,42 @@ public:
         _sparseHessianReusesRev2 = reuse;
     }
 
+    /**
+     * Determines whether or not the sparse Hessian should be evaluated
+     * using a coloring of the Hessian columns.
+     * One directional second order derivative function is generated for
+     * each color and the number of generated functions is the number of
+     * colors instead of the number of independent variables.
+     * A star coloring is used so that the symmetry of the Hessian
+     * (H(i,j) = H(j,i)) reduces the number of colors.
+     * It has precedence over the reuse of the reverse two functions and it
+     * is not used for models with loops.
+     *
+     * @return true if the sparse Hessian should be generated using a
+     *         coloring of the Hessian columns
+     */
+    inline bool isSparseHessianColoring() const {
+        return _sparseHessianColoring;
+    }
+
+    /**
+     * Defines whether or not the sparse Hessian should be evaluated
+     * using a coloring of the Hessian columns.
+     * One directional second order derivative function is generated for
+     * each color and the number of generated functions is the number of
+     * colors instead of the number of independent variables.
+     * A star coloring is used so that the symmetry of the Hessian
+     * (H(i,j) = H(j,i)) reduces the number of colors.
+     * It has precedence over the reuse of the reverse two functions and it
+     * is not used for models with loops.
+     *
+     * @param coloring true if the sparse Hessian should be generated using
+     *                 a coloring of the Hessian columns
+     */
+    inline void setSparseHessianColoring(bool coloring) {
+        _sparseHessianColoring = coloring;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function that
      * provides the Hessian sparsity pattern for each equation/dependent,
@@ -655,6 +833,40 @@ public:
         _sparseJacobianReusesOne = reuse;
     }
 
+    /**
+     * Determines whether or not the sparse Jacobian should be evaluated
+     * using a coloring of the Jacobian columns (forward mode) or rows
+     * (reverse mode).
+     * One directional derivative function is generated for each color and
+     * the number of generated functions is the number of colors instead of
+     * the number of columns or rows.
+     * It has precedence over the reuse of the forward one and reverse one
+     * functions and it is not used for models with loops.
+     *
+     * @return true if the sparse Jacobian should be generated using a
+     *         coloring of the Jacobian
+     */
+    inline bool isSparseJacobianColoring() const {
+        return _sparseJacobianColoring;
+    }
+
+    /**
+     * Defines whether or not the sparse Jacobian should be evaluated
+     * using a coloring of the Jacobian columns (forward mode) or rows
+     * (reverse mode).
+     * One directional derivative function is generated for each color and
+     * the number of generated functions is the number of colors instead of
+     * the number of columns or rows.
+     * It has precedence over the reuse of the forward one and reverse one
+     * functions and it is not used for models with loops.
+     *
+     * @param coloring true if the sparse Jacobian should be generated using
+     *                 a coloring of the Jacobian
+     */
+    inline void setSparseJacobianColoring(bool coloring) {
+        _sparseJacobianColoring = coloring;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates the original model.
@@ -677,6 +889,40 @@ public:
         _zero = create;
     }
 
+    /**
+     * Determines whether or not to generate source-code for functions that
+     * evaluate the model, the sparse Jacobian, and the sparse Hessian
+     * (the ones which are enabled) at multiple points in a single call.
+     *
+     * @see setCreateBatch()
+     *
+     * @return true if source-code for the evaluation at multiple points
+     *         should be created, false otherwise
+     */
+    inline bool isCreateBatch() const {
+        return _batch;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for functions that
+     * evaluate the model, the sparse Jacobian, and the sparse Hessian
+     * (the ones which are enabled) at multiple points in a single call.
+     * The generated functions loop over the points using a
+     * structure-of-arrays layout which can be vectorized by the C compiler
+     * (they are never split according to getMaxAssignmentsPerFunc()).
+     * These functions are only created for models without loops and
+     * without atomic functions; otherwise the generic model evaluates one
+     * point at a time.
+     *
+     * @see GenericModel::ForwardZeroBatch()
+     *
+     * @param create true if source-code for the evaluation at multiple
+     *               points should be created, false otherwise
+     */
+    inline void setCreateBatch(bool create) {
+        _batch = create;
+    }
+
     /**
      * Determines whether or not to generate source-code for the
      * first-order forward mode that is used for the evaluation of the
@@ -789,6 +1035,40 @@ public:
         _reverseTwo = create;
     }
 
+    /**
+     * Determines whether or not to generate source-code for the
+     * first-order forward mode and the second-order reverse mode which
+     * evaluate several directions in a single call.
+     *
+     * @see setCreateMultiDirection()
+     *
+     * @return true if source-code for multiple directions should be
+     *         created, false otherwise
+     */
+    inline bool isCreateMultiDirection() const {
+        return _multiDirection;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for the first-order
+     * forward mode and the second-order reverse mode which evaluate several
+     * directions in a single call (only for the modes which are enabled).
+     * The derivative values are determined only once for all directions,
+     * which avoids repeating the zero-order sweep and the per-direction
+     * call overhead in Jacobian-matrix and Hessian-matrix products.
+     *
+     * @see setCreateForwardOne()
+     * @see setCreateReverseTwo()
+     * @see GenericModel::ForwardOne(ArrayView<const Base>, size_t, ArrayView<const Base>, ArrayView<Base>)
+     * @see GenericModel::ReverseTwo(ArrayView<const Base>, size_t, ArrayView<const Base>, ArrayView<Base>, ArrayView<const Base>)
+     *
+     * @param create true if source-code for multiple directions should be
+     *               created, false otherwise
+     */
+    inline void setCreateMultiDirection(bool create) {
+        _multiDirection = create;
+    }
+
     /**
      * Specifies a user defined Jacobian sparsity to be computed.
      * The elements can be provided in any order as long as they are a subset
@@ -896,6 +1176,147 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * Whether or not operations are reordered to reduce the number of
+     * temporary variables alive at the same time.
+     *
+     * @see setMinimizeLiveVariables()
+     */
+    inline bool isMinimizeLiveVariables() const {
+        return _minimizeLiveVariables;
+    }
+
+    /**
+     * Defines whether or not to reorder the evaluation of independent
+     * subexpressions so that fewer temporary variables are alive at the
+     * same time in the generated functions.
+     * This can reduce the size of the temporary array and improve the
+     * locality of its accesses.
+     *
+     * @param minimize whether or not to reorder operations
+     * @see CodeHandler::setMinimizeLiveVariables()
+     */
+    inline void setMinimizeLiveVariables(bool minimize) {
+        _minimizeLiveVariables = minimize;
+    }
+
+    /**
+     * Provides the highest number of temporary variables alive at the same
+     * time in the functions created by the last source code generation.
+     */
+    inline size_t getMaxLiveTemporaryVariables() const {
+        return _maxLiveTemporaries;
+    }
+
+    /**
+     * Whether or not the temporary arrays of the generated functions are
+     * placed in a per-thread workspace instead of the stack.
+     *
+     * @see setTemporariesInWorkspace()
+     */
+    inline bool isTemporariesInWorkspace() const {
+        return _temporariesInWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays of the generated
+     * functions are declared as static thread local variables (a
+     * per-thread workspace) instead of being allocated in the stack.
+     * This is useful for large models whose temporary arrays would not
+     * fit in the stack of the calling threads.
+     * The workspace of each thread is allocated once and reused by all
+     * calls from that thread.
+     * The dynamic libraries must be compiled with a C11 compiler and
+     * thread local storage might not be supported by JIT compilers.
+     *
+     * @param inWorkspace whether or not to use a per-thread workspace
+     * @see LanguageC::setTemporariesInWorkspace()
+     */
+    inline void setTemporariesInWorkspace(bool inWorkspace) {
+        _temporariesInWorkspace = inWorkspace;
+    }
+
+    /**
+     * Provides the number of threads used to generate the functions for
+     * each column/row of the first-order forward mode and of the first and
+     * second-order reverse modes.
+     *
+     * @see setSourceGenerationThreadNumber()
+     */
+    inline size_t getSourceGenerationThreadNumber() const {
+        return _sourceGenThreads;
+    }
+
+    /**
+     * Defines the number of threads used to generate the functions for
+     * each column/row of the first-order forward mode and of the first and
+     * second-order reverse modes.
+     * Only models with atomic functions and without loops create a new
+     * operation graph for each column/row (the others share a single
+     * graph), therefore the other models are not affected.
+     * The generated sources do not depend on the number of threads.
+     * The jobs of each column/row are reported in the original order once
+     * the column/row is completed.
+     *
+     * Each thread evaluates its own copy of the model, however the atomic
+     * functions are shared and must support concurrent evaluations in
+     * CppAD parallel mode (CGAtomicFunBridge uses a copy of its ADFun for
+     * each thread).
+     * CppAD is placed in parallel mode while the functions are generated
+     * (see CppADParallelSetup), therefore CppAD must not be used by any
+     * other thread at the same time.
+     * The functions are generated sequentially if CppAD is already in
+     * parallel mode (e.g. when the sources of several models of a
+     * library are generated concurrently).
+     *
+     * @param threads the number of threads (zero means the number of
+     *                hardware threads and one disables the concurrent
+     *                generation)
+     */
+    inline void setSourceGenerationThreadNumber(size_t threads) {
+        _sourceGenThreads = threads;
+    }
+
+    /**
+     * Provides the number of bytes required by the temporary arrays of the
+     * generated functions, as determined by the last source code
+     * generation.
+     * If the temporaries are placed in a per-thread workspace, each
+     * generated function has its own arrays and this is the sum for all
+     * the functions (the memory used by each thread), otherwise it is the
+     * size for the function which uses the most stack memory.
+     * This value is also made available by the compiled model library.
+     *
+     * @see GenericModel::getWorkspaceSize()
+     */
+    inline size_t getWorkspaceSize() const {
+        return _workspaceSize;
+    }
+
+    /**
+     * Creates a key which identifies the source code generated for this
+     * model.
+     * It depends on the operations of the taped model, on the typical
+     * independent variable values, and on all the options which affect the
+     * source code generation.
+     * Different models can be generated with the same key only if they
+     * produce the same source code.
+     *
+     * Atomic functions are identified by their name and by
+     * CGAbstractAtomicFun::getFingerprint().
+     *
+     * @warning Atomic functions which do not implement
+     *          CGAbstractAtomicFun::getFingerprint() are only identified by
+     *          their name: when their behaviour (e.g. sparsity) changes they
+     *          must be renamed, otherwise outdated source code, object files
+     *          and libraries can be reused from the compiler cache.
+     *
+     * @param multiThreadingType the multithreading type requested by the
+     *                           model library
+     * @return the key as a hexadecimal string
+     */
+    virtual std::string getFingerprint(MultiThreadingType multiThreadingType);
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -917,6 +1338,23 @@ public:
 
 protected:
 
+    /**
+     * Adds a value to a fingerprint.
+     * The bytes of float and double values are used directly, while other
+     * types are serialized with operator<< since their representation might
+     * contain padding or pointers.
+     */
+    static inline void addToFingerprint(ContentHash& h,
+                                        const Base& value);
+
+    static inline void addToFingerprint(ContentHash& h,
+                                        const Base& value,
+                                        std::true_type rawBytes);
+
+    static inline void addToFingerprint(ContentHash& h,
+                                        const Base& value,
+                                        std::false_type rawBytes);
+
     virtual VariableNameGenerator<Base>* createVariableNameGenerator(const std::string& depName = "y",
                                                                      const std::string& indepName = "x",
                                                                      const std::string& tmpName = "v",
@@ -925,6 +1363,21 @@ protected:
     const std::map<std::string, std::string>& getSources(MultiThreadingType multiThreadingType,
                                                          JobTimer* timer);
 
+    /**
+     * Provides each generated source file to a sink as soon as it is
+     * complete, instead of keeping all the files of this model in memory.
+     * The sources are not kept by this object (they are generated again if
+     * they are requested later), unless they were already generated.
+     *
+     * @param multiThreadingType the multithreading type requested by the
+     *                           model library
+     * @param sink receives the source files
+     * @param timer used to report the jobs (can be null)
+     */
+    virtual void streamSources(MultiThreadingType multiThreadingType,
+                               SourceSink& sink,
+                               JobTimer* timer);
+
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
@@ -934,6 +1387,8 @@ protected:
 
     virtual void generateAtomicFuncNames();
 
+    virtual void generateWorkspaceSizeSource();
+
     virtual bool isAtomicsUsed();
 
     virtual const std::map<size_t, AtomicUseInfo<Base> >& getAtomicsInfo();
@@ -960,6 +1415,20 @@ protected:
 
     virtual void generateSparseJacobianSource(bool forward);
 
+    /**
+     * Generates the operation graph for the sparse Jacobian using the
+     * elements in _jacSparsity
+     */
+    virtual std::vector<CGBase> prepareSparseJacobian(CodeHandler<Base>& handler,
+                                                      std::vector<CGBase>& indVars,
+                                                      bool forward);
+
+    /**
+     * Determines whether or not forward mode should be used to evaluate
+     * the sparse Jacobian
+     */
+    virtual bool isSparseJacobianForwardMode();
+
     virtual void generateSparseJacobianForRevSource(bool forward,
                                                     MultiThreadingType multiThreadingType);
 
@@ -1031,7 +1500,8 @@ protected:
                                                                  const std::string& keyName,
                                                                  const std::map<size_t, std::set<size_t> >& nonLoopElements,
                                                                  const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& loopGroups,
-                                                                 void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g));
+                                                                 void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
+                                                                 MultiThreadingType multiThreadingType);
 
     inline virtual void generateFunctionNameLoopFor1(std::ostringstream& cache,
                                                      const LoopModel<Base>& loop,
@@ -1061,6 +1531,14 @@ protected:
 
     virtual void generateSparseHessianSourceDirectly();
 
+    /**
+     * Generates the operation graph for the sparse Hessian using the
+     * elements in _hessSparsity
+     */
+    virtual std::vector<CGBase> prepareSparseHessian(CodeHandler<Base>& handler,
+                                                     std::vector<CGBase>& indVars,
+                                                     std::vector<CGBase>& w);
+
     virtual void generateSparseHessianSourceFromRev2(MultiThreadingType multiThreadingType);
 
     virtual std::string generateSparseHessianRev2SingleThreadSource(const std::string& functionName,
@@ -1123,7 +1601,8 @@ protected:
                                               bool useSymmetry);
 
     inline virtual void generateSparseHessianWithLoopsSourceFromRev2(const std::map<size_t, CompressedVectorInfo>& hessInfo,
-                                                                     size_t maxCompressedSize);
+                                                                     size_t maxCompressedSize,
+                                                                     MultiThreadingType multiThreadingType);
 
     inline virtual void generateFunctionNameLoopRev2(std::ostringstream& cache,
                                                      const LoopModel<Base>& loop,
@@ -1150,6 +1629,20 @@ protected:
     virtual void generateSparsity1DSource2(const std::string& function,
                                            const std::map<size_t, std::vector<size_t> >& rows);
 
+    /**
+     * Generates one function for each column/row of a directional
+     * derivative, possibly using several threads.
+     *
+     * @param elements maps the column/row to the indexes of the elements
+     *                 of the directional derivative
+     * @param generate creates the function of a single column/row using
+     *                 only the provided destination (it can be called
+     *                 concurrently)
+     * @see setSourceGenerationThreadNumber()
+     */
+    virtual void generateDirectionalSources(const std::map<size_t, std::vector<size_t> >& elements,
+                                            const std::function<void(size_t, const std::vector<size_t>&, DirectionalSourceGen&)>& generate);
+
     /***********************************************************************
      * Forward 1 mode
      **********************************************************************/
@@ -1158,6 +1651,10 @@ protected:
 
     virtual void generateSparseForwardOneSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements);
 
+    virtual void generateSparseForwardOneSourceWithAtomics(size_t j,
+                                                           const std::vector<size_t>& rows,
+                                                           DirectionalSourceGen& gen);
+
     virtual void generateSparseForwardOneSourcesNoAtomics(const std::map<size_t, std::vector<size_t> >& elements);
 
     virtual void generateForwardOneSources();
@@ -1183,6 +1680,10 @@ protected:
 
     virtual void generateSparseReverseOneSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements);
 
+    virtual void generateSparseReverseOneSourceWithAtomics(size_t i,
+                                                           const std::vector<size_t>& cols,
+                                                           DirectionalSourceGen& gen);
+
     virtual void generateSparseReverseOneSourcesNoAtomics(const std::map<size_t, std::vector<size_t> >& elements);
 
     virtual void generateReverseOneSources();
@@ -1207,6 +1708,10 @@ protected:
 
     virtual void generateSparseReverseTwoSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements);
 
+    virtual void generateSparseReverseTwoSourceWithAtomics(size_t j,
+                                                           const std::vector<size_t>& cols,
+                                                           DirectionalSourceGen& gen);
+
     virtual void generateSparseReverseTwoSourcesNoAtomics(const std::map<size_t, std::vector<size_t> >& elements,
                                                           const std::vector<size_t>& evalRows,
                                                           const std::vector<size_t>& evalCols);
@@ -1223,6 +1728,109 @@ protected:
      */
     virtual void prepareSparseReverseTwoWithLoops(const std::map<size_t, std::vector<size_t> >& elements);
 
+    /***********************************************************************
+     * Multiple directions
+     **********************************************************************/
+
+    virtual void generateSparseForwardOneMultiSource();
+
+    virtual void generateSparseReverseTwoMultiSource();
+
+    /**
+     * Generates the function which evaluates the derivative values only
+     * once and then multiplies them by all the directions.
+     *
+     * @param function the name of the function to generate
+     * @param valuesFunction the name of the function which evaluates the
+     *                       derivative values
+     * @param outSize the number of elements of each output direction
+     * @param outIndexes the output index of each derivative value
+     * @param inIndexes the input direction index of each derivative value
+     * @param multipliers whether or not the values function also
+     *                    receives the equation multipliers (in[2])
+     */
+    virtual void generateGlobalMultiDirectionalFunctionSource(const std::string& function,
+                                                              const std::string& valuesFunction,
+                                                              size_t outSize,
+                                                              const std::vector<size_t>& outIndexes,
+                                                              const std::vector<size_t>& inIndexes,
+                                                              bool multipliers);
+
+    /***********************************************************************
+     * Coloring
+     **********************************************************************/
+
+    virtual void generateSparseJacobianColoredSource(bool forward,
+                                                     MultiThreadingType multiThreadingType);
+
+    virtual void generateSparseHessianColoredSource(MultiThreadingType multiThreadingType);
+
+    /**
+     * Determines a coloring of the columns of a sparse matrix where
+     * columns with the same color do not have non-zero elements in the
+     * same row (Curtis-Powell-Reed).
+     * A greedy approach is used with the natural column order, which is
+     * optimal for banded matrices.
+     *
+     * @param columns the columns to color
+     * @param colRows the rows with non-zero elements in each column
+     * @param rowCols the columns with non-zero elements in each row
+     * @param colors the color of each column in columns (output)
+     * @return the number of colors
+     */
+    static size_t determineColumnColors(const std::set<size_t>& columns,
+                                        const SparsitySetType& colRows,
+                                        const SparsitySetType& rowCols,
+                                        std::map<size_t, size_t>& colors);
+
+    /**
+     * Determines a star coloring of the adjacency graph of a symmetric
+     * matrix: adjacent vertices have different colors and every path with
+     * four vertices uses at least three colors.
+     * Each element (i, j) can then be recovered directly from the column
+     * sums of the color of j or from the ones of the color of i.
+     * A greedy approach is used with the natural vertex order.
+     *
+     * @param vertices the vertices to color
+     * @param adjacency the adjacent vertices of each vertex (without the
+     *                  vertex itself)
+     * @param colors the color of each vertex in vertices (output)
+     * @return the number of colors
+     */
+    static size_t determineStarColors(const std::set<size_t>& vertices,
+                                      const SparsitySetType& adjacency,
+                                      std::map<size_t, size_t>& colors);
+
+    /**
+     * Determines which compressed vectors can be provided directly to the
+     * functions without a temporary array.
+     *
+     * @return the maximum size of the temporary array
+     */
+    static size_t determineCompressedOrder(std::map<size_t, CompressedVectorInfo>& info);
+
+    /***********************************************************************
+     * Evaluation at multiple points
+     **********************************************************************/
+
+    /**
+     * Whether or not it is possible to generate functions for the
+     * evaluation at multiple points.
+     */
+    virtual bool isBatchSupported();
+
+    virtual void generateZeroBatchSource();
+
+    virtual void generateSparseJacobianBatchSource();
+
+    virtual void generateSparseHessianBatchSource();
+
+    virtual void generateBatchSource(CodeHandler<Base>& handler,
+                                     std::vector<CGBase>& dependents,
+                                     LangCBatchVariableNameGenerator<Base>& nameGen,
+                                     const std::string& functionName,
+                                     const std::string& jobName);
+
     /***********************************************************************
      * Sparsities
      **********************************************************************/
@@ -1299,6 +1907,18 @@ protected:
     static void printLoopEndOpenMP(std::ostringstream& cache,
                                    size_t size);
 
+    /**
+     * Prints a function which evaluates a sparse Jacobian or a sparse
+     * Hessian of a model with loops using several threads.
+     * The function calls are split into tasks (see
+     * setMultiThreadingLoopTasks()) and each task adds its contributions to
+     * its own copy of the result which are summed at the end.
+     */
+    virtual void printForRevUsageFunctionMultiThread(std::ostringstream& out,
+                                                     loops::ForRevUsagePrinter<Base>& printer,
+                                                     const std::string& modelFunction,
+                                                     MultiThreadingType multiThreadingType);
+
     /**
      *
      */
@@ -1307,6 +1927,20 @@ protected:
 
     inline void finishedJob();
 
+    /**
+     * Adds the size of the temporary arrays of a new generated function to
+     * the workspace size.
+     * The thread local arrays of all functions exist at the same time
+     * while stack arrays only exist during the function call.
+     */
+    inline void addWorkspaceSize(size_t& total,
+                                 size_t functionSize) const {
+        if (_temporariesInWorkspace)
+            total += functionSize;
+        else
+            total = std::max(total, functionSize);
+    }
+
     friend class
     ModelLibraryCSourceGen<Base>;
 
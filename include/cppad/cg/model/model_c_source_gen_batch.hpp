@@ -0,0 +1,148 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_BATCH_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_BATCH_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+bool ModelCSourceGen<Base>::isBatchSupported() {
+    return _loopTapes.empty() && !isAtomicsUsed();
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateZeroBatchSource() {
+    const std::string jobName = "model (zero-order forward) for multiple points";
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+    std::vector<CGBase> indVars(_fun.Domain());
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < indVars.size(); i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+    finishedJob();
+
+    LangCBatchVariableNameGenerator<Base> nameGen;
+
+    generateBatchSource(handler, dep, nameGen, _name + "_" + FUNCTION_FORWARD_ZERO_BATCH, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseJacobianBatchSource() {
+    const std::string jobName = "sparse Jacobian for multiple points";
+
+    determineJacobianSparsity();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+    std::vector<CGBase> indVars(_fun.Domain());
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < indVars.size(); i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    std::vector<CGBase> jac = prepareSparseJacobian(handler, indVars, isSparseJacobianForwardMode());
+
+    finishedJob();
+
+    LangCBatchVariableNameGenerator<Base> nameGen("nPoints", "jac");
+
+    generateBatchSource(handler, jac, nameGen, _name + "_" + FUNCTION_SPARSE_JACOBIAN_BATCH, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseHessianBatchSource() {
+    const std::string jobName = "sparse Hessian for multiple points";
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+
+    determineHessianSparsity();
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+    // independent variables
+    std::vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    // multipliers
+    std::vector<CGBase> w(m);
+    handler.makeVariables(w);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            w[i].setValue(Base(1.0));
+        }
+    }
+
+    std::vector<CGBase> hess = prepareSparseHessian(handler, indVars, w);
+
+    finishedJob();
+
+    LangCBatchVariableNameGenerator<Base> nameGen("nPoints", "hess");
+    nameGen.setMultipliers("mult", n);
+
+    generateBatchSource(handler, hess, nameGen, _name + "_" + FUNCTION_SPARSE_HESSIAN_BATCH, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateBatchSource(CodeHandler<Base>& handler,
+                                                std::vector<CGBase>& dependents,
+                                                LangCBatchVariableNameGenerator<Base>& nameGen,
+                                                const std::string& functionName,
+                                                const std::string& jobName) {
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(0, _sink); // the loop over the points cannot be split
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    langC.setGenerateFunction(functionName);
+    langC.setFunctionIndexArgument(*handler.makeIndexDclrNode(nameGen.getNumberOfPointsName()));
+
+    std::ostringstream code;
+
+    handler.generateCode(code, langC, dependents, nameGen, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,528 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_COLOR_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_COLOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseJacobianColoredSource(bool forward,
+                                                                MultiThreadingType multiThreadingType) {
+    using std::vector;
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+
+    const std::vector<size_t>& rows = _jacSparsity.rows;
+    const std::vector<size_t>& cols = _jacSparsity.cols;
+
+    /**
+     * color the columns (forward mode) or the rows (reverse mode)
+     */
+    const SparsitySetType& rowSparsity = _jacSparsity.sparsity;
+    SparsitySetType colSparsity(n);
+    for (size_t i = 0; i < rowSparsity.size(); i++) {
+        for (size_t j : rowSparsity[i]) {
+            colSparsity[j].insert(i);
+        }
+    }
+
+    const std::vector<size_t>& seeds = forward ? cols : rows;
+    const std::vector<size_t>& outputs = forward ? rows : cols;
+
+    std::set<size_t> seedIndexes(seeds.begin(), seeds.end());
+    std::map<size_t, size_t> colors;
+    size_t nColors;
+    if (forward) {
+        nColors = determineColumnColors(seedIndexes, colSparsity, rowSparsity, colors);
+    } else {
+        nColors = determineColumnColors(seedIndexes, rowSparsity, colSparsity, colors);
+    }
+
+    /**
+     * jacInfo[color].index{equations (forward) or variables (reverse)}
+     */
+    std::map<size_t, CompressedVectorInfo> jacInfo;
+    std::vector<std::map<size_t, size_t> > positions(nColors); // compressed position of each output
+    std::vector<std::set<size_t> > colorSeeds(nColors);
+    for (size_t e = 0; e < rows.size(); e++) {
+        size_t c = colors[seeds[e]];
+        colorSeeds[c].insert(seeds[e]);
+
+        CompressedVectorInfo& info = jacInfo[c];
+        auto itPos = positions[c].find(outputs[e]);
+        if (itPos == positions[c].end()) {
+            positions[c][outputs[e]] = info.indexes.size();
+            info.indexes.push_back(outputs[e]);
+            info.locations.emplace_back();
+            info.locations.back().insert(e);
+        } else {
+            info.locations[itPos->second].insert(e);
+        }
+    }
+
+    size_t maxCompressedSize = determineCompressedOrder(jacInfo);
+
+    /**
+     * Generate one directional derivative function for each color
+     */
+    std::string functionName = _name + "_" + FUNCTION_SPARSE_JACOBIAN;
+    std::string colorSuffix = "color";
+
+    const std::string jobName = "sparse Jacobian (colored)";
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    for (const auto& it : jacInfo) {
+        size_t c = it.first;
+        const std::vector<size_t>& els = it.second.indexes;
+
+        _cache.str("");
+        _cache << "sparse Jacobian (color " << c << ")";
+        const std::string subJobName = _cache.str();
+
+        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+        vector<CGBase> indVars(n);
+        handler.makeVariables(indVars);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                indVars[i].setValue(_x[i]);
+            }
+        }
+
+        CGBase dir;
+        handler.makeVariable(dir);
+        if (_x.size() > 0) {
+            dir.setValue(Base(1.0));
+        }
+
+        _fun.Forward(0, indVars);
+
+        vector<CGBase> compressed;
+        compressed.reserve(els.size());
+        if (forward) {
+            vector<CGBase> dx(n);
+            for (size_t j : colorSeeds[c])
+                dx[j] = dir;
+            vector<CGBase> dy = _fun.Forward(1, dx);
+            CPPADCG_ASSERT_UNKNOWN(dy.size() == m);
+            for (size_t i : els)
+                compressed.push_back(dy[i]);
+        } else {
+            vector<CGBase> w(m);
+            for (size_t i : colorSeeds[c])
+                w[i] = dir;
+            vector<CGBase> dw = _fun.Reverse(1, w);
+            CPPADCG_ASSERT_UNKNOWN(dw.size() == n);
+            for (size_t j : els)
+                compressed.push_back(dw[j]);
+        }
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+        langC.setGenerateFunction(functionName + "_" + colorSuffix + std::to_string(c));
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator(forward ? "dy" : "dw"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), forward ? "dx" : "py", n);
+
+        handler.generateCode(code, langC, compressed, nameGenHess, _atomicFunctions, subJobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
+    }
+
+    finishedJob();
+
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        _sink->addSource(functionName + ".c", generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionName, colorSuffix, forward));
+    } else {
+        _sink->addSource(functionName + ".c", generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionName, colorSuffix, forward, multiThreadingType));
+    }
+
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseHessianColoredSource(MultiThreadingType multiThreadingType) {
+    using std::vector;
+
+    const size_t m = _fun.Range();
+    const size_t n = _fun.Domain();
+    const size_t p = 2;
+
+    /**
+     * we might have to consider a slightly different order than the one
+     * specified by the user according to the available elements in the sparsity
+     */
+    std::vector<size_t> evalRows, evalCols;
+    determineSecondOrderElements4Eval(evalRows, evalCols);
+
+    /**
+     * make use of the symmetry of the Hessian in order to reduce operations
+     */
+    std::map<size_t, std::map<size_t, size_t> > locations;
+    for (size_t e = 0; e < evalRows.size(); e++) {
+        locations[evalRows[e]][evalCols[e]] = e;
+    }
+
+    std::map<size_t, std::vector<size_t> > duplicates; // the elements determined using symmetry
+    std::vector<bool> evaluate(evalRows.size(), true);
+    for (size_t e = 0; e < evalRows.size(); e++) {
+        size_t i = evalRows[e];
+        size_t j = evalCols[e];
+        if (i < j) {
+            auto itJ = locations.find(j);
+            if (itJ != locations.end()) {
+                auto itI = itJ->second.find(i);
+                if (itI != itJ->second.end()) {
+                    duplicates[itI->second].push_back(e);
+                    evaluate[e] = false; // symmetric value being determined
+                }
+            }
+        }
+    }
+
+    /**
+     * star coloring of the adjacency graph of the Hessian where each
+     * color is a direction for the second order reverse mode
+     * (px[k] = sum of H(k, j) for all the variables j with that color)
+     */
+    const SparsitySetType& sparsity = _hessSparsity.sparsity;
+    SparsitySetType adjacency(n);
+    for (size_t i = 0; i < sparsity.size(); i++) {
+        for (size_t j : sparsity[i]) {
+            if (i != j) {
+                adjacency[i].insert(j);
+                adjacency[j].insert(i);
+            }
+        }
+    }
+
+    std::set<size_t> vertices;
+    for (size_t e = 0; e < evalRows.size(); e++) {
+        if (evaluate[e]) {
+            vertices.insert(evalRows[e]);
+            vertices.insert(evalCols[e]);
+        }
+    }
+
+    std::map<size_t, size_t> colors;
+    size_t nColors = determineStarColors(vertices, adjacency, colors);
+
+    std::vector<std::set<size_t> > colorSeeds(nColors);
+    for (const auto& itColor : colors) {
+        colorSeeds[itColor.second].insert(itColor.first);
+    }
+
+    /**
+     * determines whether or not H(i, j) is the only element of the row i
+     * in the columns with the color of j
+     */
+    auto isDirect = [&](size_t i, size_t j) {
+        size_t c = colors.at(j);
+        for (size_t k : adjacency[i]) {
+            if (k != j) {
+                auto itColor = colors.find(k);
+                if (itColor != colors.end() && itColor->second == c)
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    /**
+     * hessInfo[color].index{vars}
+     */
+    std::map<size_t, CompressedVectorInfo> hessInfo;
+    std::vector<std::map<size_t, size_t> > positions(nColors); // compressed position of each output
+    for (size_t e = 0; e < evalRows.size(); e++) {
+        if (!evaluate[e])
+            continue;
+
+        // the star coloring guarantees that at least one of them is direct
+        size_t i = evalRows[e];
+        size_t j = evalCols[e];
+        if (!isDirect(i, j)) {
+            std::swap(i, j);
+            CPPADCG_ASSERT_UNKNOWN(isDirect(i, j))
+        }
+
+        size_t c = colors.at(j);
+
+        CompressedVectorInfo& info = hessInfo[c];
+        size_t pos;
+        auto itPos = positions[c].find(i);
+        if (itPos == positions[c].end()) {
+            pos = info.indexes.size();
+            positions[c][i] = pos;
+            info.indexes.push_back(i);
+            info.locations.emplace_back();
+        } else {
+            pos = itPos->second;
+        }
+        info.locations[pos].insert(e);
+
+        auto itDup = duplicates.find(e);
+        if (itDup != duplicates.end()) {
+            info.locations[pos].insert(itDup->second.begin(), itDup->second.end());
+        }
+    }
+
+    size_t maxCompressedSize = determineCompressedOrder(hessInfo);
+
+    /**
+     * Generate one directional second order derivative function for each color
+     */
+    std::string functionName = _name + "_" + FUNCTION_SPARSE_HESSIAN;
+    std::string colorSuffix = "color";
+
+    const std::string jobName = "sparse Hessian (colored)";
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    for (const auto& it : hessInfo) {
+        size_t c = it.first;
+        const std::vector<size_t>& els = it.second.indexes;
+
+        _cache.str("");
+        _cache << "sparse Hessian (color " << c << ")";
+        const std::string subJobName = _cache.str();
+
+        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+        vector<CGBase> tx0(n);
+        handler.makeVariables(tx0);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                tx0[i].setValue(_x[i]);
+            }
+        }
+
+        CGBase tx1;
+        handler.makeVariable(tx1);
+        if (_x.size() > 0) {
+            tx1.setValue(Base(1.0));
+        }
+
+        vector<CGBase> py(m);
+        handler.makeVariables(py);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                py[i].setValue(Base(1.0));
+            }
+        }
+
+        _fun.Forward(0, tx0);
+
+        vector<CGBase> tx1v(n);
+        for (size_t j : colorSeeds[c])
+            tx1v[j] = tx1;
+        _fun.Forward(1, tx1v);
+
+        vector<CGBase> px = _fun.Reverse(2, py);
+        CPPADCG_ASSERT_UNKNOWN(px.size() == p * n);
+
+        vector<CGBase> compressed;
+        compressed.reserve(els.size());
+        for (size_t j : els) {
+            compressed.push_back(px[j * p + 1]);
+        }
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+        langC.setGenerateFunction(functionName + "_" + colorSuffix + std::to_string(c));
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
+        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+
+        handler.generateCode(code, langC, compressed, nameGenRev2, _atomicFunctions, subJobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
+    }
+
+    finishedJob();
+
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        _sink->addSource(functionName + ".c", generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionName, colorSuffix));
+    } else {
+        _sink->addSource(functionName + ".c", generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionName, colorSuffix, multiThreadingType));
+    }
+
+    _cache.str("");
+}
+
+template<class Base>
+size_t ModelCSourceGen<Base>::determineColumnColors(const std::set<size_t>& columns,
+                                                   const SparsitySetType& colRows,
+                                                   const SparsitySetType& rowCols,
+                                                   std::map<size_t, size_t>& colors) {
+    colors.clear();
+
+    size_t nColors = 0;
+    std::vector<size_t> forbidden; // the last column for which each color was forbidden (+1)
+
+    for (size_t j : columns) {
+        for (size_t i : colRows[j]) {
+            for (size_t j2 : rowCols[i]) {
+                auto itColor = colors.find(j2);
+                if (itColor != colors.end()) {
+                    forbidden[itColor->second] = j + 1;
+                }
+            }
+        }
+
+        size_t c = 0;
+        while (c < nColors && forbidden[c] == j + 1) {
+            c++;
+        }
+        if (c == nColors) {
+            nColors++;
+            forbidden.push_back(0);
+        }
+        colors[j] = c;
+    }
+
+    return nColors;
+}
+
+template<class Base>
+size_t ModelCSourceGen<Base>::determineStarColors(const std::set<size_t>& vertices,
+                                                 const SparsitySetType& adjacency,
+                                                 std::map<size_t, size_t>& colors) {
+    colors.clear();
+
+    size_t nColors = 0;
+    std::vector<size_t> forbidden; // the last vertex for which each color was forbidden (+1)
+    std::map<size_t, size_t> neighborColors; // the number of colored neighbors with each color
+
+    auto forbid = [&](size_t x, size_t v) {
+        auto itColor = colors.find(x);
+        if (itColor != colors.end())
+            forbidden[itColor->second] = v + 1;
+    };
+
+    for (size_t v : vertices) {
+        neighborColors.clear();
+        for (size_t w : adjacency[v]) {
+            auto itColor = colors.find(w);
+            if (itColor != colors.end()) {
+                forbidden[itColor->second] = v + 1; // distance-1 coloring
+                neighborColors[itColor->second]++;
+            }
+        }
+
+        for (size_t w : adjacency[v]) {
+            auto itW = colors.find(w);
+            if (itW == colors.end())
+                continue;
+            size_t cw = itW->second;
+
+            for (size_t x : adjacency[w]) {
+                if (x == v)
+                    continue;
+
+                if (neighborColors[cw] > 1) {
+                    /**
+                     * path u - v - w - x where u and w have the same color
+                     * (v cannot have the color of x)
+                     */
+                    forbid(x, v);
+                    continue;
+                }
+
+                /**
+                 * path v - w - x - y where w and y have the same color
+                 * (v cannot have the color of x)
+                 */
+                for (size_t y : adjacency[x]) {
+                    if (y != w) {
+                        auto itY = colors.find(y);
+                        if (itY != colors.end() && itY->second == cw) {
+                            forbid(x, v);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t c = 0;
+        while (c < nColors && forbidden[c] == v + 1) {
+            c++;
+        }
+        if (c == nColors) {
+            nColors++;
+            forbidden.push_back(0);
+        }
+        colors[v] = c;
+    }
+
+    return nColors;
+}
+
+template<class Base>
+size_t ModelCSourceGen<Base>::determineCompressedOrder(std::map<size_t, CompressedVectorInfo>& info) {
+    size_t maxCompressedSize = 0;
+
+    for (auto& it : info) {
+        const std::vector<size_t>& els = it.second.indexes;
+        const std::vector<std::set<size_t> >& location = it.second.locations;
+        CPPADCG_ASSERT_UNKNOWN(els.size() == location.size());
+        CPPADCG_ASSERT_UNKNOWN(els.size() > 0);
+
+        bool passed = true;
+        size_t arrayStart = *location[0].begin();
+        for (size_t e = 0; e < els.size(); e++) {
+            if (location[e].size() > 1) {
+                passed = false; // too many elements
+                break;
+            }
+            if (*location[e].begin() != arrayStart + e) {
+                passed = false; // wrong order
+                break;
+            }
+        }
+        it.second.ordered = passed;
+
+        if (!passed && els.size() > maxCompressedSize)
+            maxCompressedSize = els.size();
+    }
+
+    return maxCompressedSize;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
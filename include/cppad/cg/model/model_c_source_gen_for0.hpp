@@ -26,6 +26,7 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     std::vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -49,15 +50,18 @@ void ModelCSourceGen<Base>::generateZeroSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
 
     handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 }
 
 
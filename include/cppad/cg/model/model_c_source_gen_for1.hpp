@@ -60,73 +60,79 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSources() {
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements) {
-    using std::vector;
-
     /**
-     * Generate one function for each dependent variable
+     * Generate one function for each independent variable
      */
-    size_t n = _fun.Domain();
-
-    vector<CGBase> dxv(n);
-
-    const std::string jobName = "model (forward one)";
-    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+    generateDirectionalSources(elements, [this](size_t j, const std::vector<size_t>& rows, DirectionalSourceGen& gen) {
+        generateSparseForwardOneSourceWithAtomics(j, rows, gen);
+    });
+}
 
-    for (const auto& it : elements) {
-        size_t j = it.first;
-        const std::vector<size_t>& rows = it.second;
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseForwardOneSourceWithAtomics(size_t j,
+                                                                      const std::vector<size_t>& rows,
+                                                                      DirectionalSourceGen& gen) {
+    using std::vector;
 
-        _cache.str("");
-        _cache << "model (forward one, indep " << j << ")";
-        const std::string subJobName = _cache.str();
+    ADFun<CGBase>& fun = *gen.fun;
+    size_t n = fun.Domain();
 
-        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+    std::ostringstream cache;
+    cache << "model (forward one, indep " << j << ")";
+    const std::string subJobName = cache.str();
 
-        CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+    if (gen.timer != nullptr)
+        gen.timer->startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        vector<CGBase> indVars(n);
-        handler.makeVariables(indVars);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                indVars[i].setValue(_x[i]);
-            }
-        }
+    CodeHandler<Base> handler;
+    handler.setJobTimer(gen.timer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
-        CGBase dx;
-        handler.makeVariable(dx);
-        if (_x.size() > 0) {
-            dx.setValue(Base(1.0));
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
         }
+    }
 
-        // TODO: consider caching the zero order coefficients somehow between calls
-        _fun.Forward(0, indVars);
-        dxv[j] = dx;
-        vector<CGBase> dy = _fun.Forward(1, dxv);
-        dxv[j] = Base(0);
-        CPPADCG_ASSERT_UNKNOWN(dy.size() == _fun.Range());
-
-        vector<CGBase> dyCustom;
-        for (size_t it2 : rows) {
-            dyCustom.push_back(dy[it2]);
-        }
+    CGBase dx;
+    handler.makeVariable(dx);
+    if (_x.size() > 0) {
+        dx.setValue(Base(1.0));
+    }
 
-        finishedJob();
+    // TODO: consider caching the zero order coefficients somehow between calls
+    fun.Forward(0, indVars);
+    vector<CGBase> dxv(n);
+    dxv[j] = dx;
+    vector<CGBase> dy = fun.Forward(1, dxv);
+    CPPADCG_ASSERT_UNKNOWN(dy.size() == fun.Range());
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
+    vector<CGBase> dyCustom;
+    for (size_t it2 : rows) {
+        dyCustom.push_back(dy[it2]);
+    }
 
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+    if (gen.timer != nullptr)
+        gen.timer->finishedJob();
 
-        handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
-    }
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, gen.sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    cache.str("");
+    cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
+    langC.setGenerateFunction(cache.str());
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dy"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
+
+    handler.generateCode(code, langC, dyCustom, nameGenHess, *gen.atomicFunctions, subJobName);
+    gen.maxLiveTemporaries = std::max(gen.maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(gen.workspaceSize, langC.getWorkspaceSize());
 }
 
 template<class Base>
@@ -140,6 +146,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -201,9 +208,10 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         const std::string subJobName = _cache.str();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -213,6 +221,8 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
     }
 }
 
@@ -316,7 +326,7 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "   free(txPos);\n"
             "   return 0;\n"
             "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -63,9 +64,10 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
@@ -73,6 +75,8 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 }
 
 template<class Base>
@@ -82,7 +86,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSource(MultiThreadingType multi
      */
     determineHessianSparsity();
 
-    if (_sparseHessianReusesRev2 && _reverseTwo) {
+    if (_sparseHessianColoring && _loopTapes.empty() && !_hessSparsity.rows.empty()) {
+        generateSparseHessianColoredSource(multiThreadingType);
+    } else if (_sparseHessianReusesRev2 && _reverseTwo) {
         generateSparseHessianSourceFromRev2(multiThreadingType);
     } else {
         generateSparseHessianSourceDirectly();
@@ -97,6 +103,56 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+    // independent variables
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    // multipliers
+    vector<CGBase> w(m);
+    handler.makeVariables(w);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            w[i].setValue(Base(1.0));
+        }
+    }
+
+    vector<CGBase> hess = prepareSparseHessian(handler, indVars, w);
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+
+    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
+}
+
+template<class Base>
+std::vector<CG<Base>> ModelCSourceGen<Base>::prepareSparseHessian(CodeHandler<Base>& handler,
+                                                                 std::vector<CGBase>& indVars,
+                                                                 std::vector<CGBase>& w) {
+    using std::vector;
+
     /**
      * we might have to consider a slightly different order than the one
      * specified by the user according to the available elements in the sparsity
@@ -155,32 +211,6 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
         }
     }
 
-    /**
-     * 
-     */
-    startingJob("'" + jobName + "'", JobTimer::GRAPH);
-
-    CodeHandler<Base> handler;
-    handler.setJobTimer(_jobTimer);
-
-    // independent variables
-    vector<CGBase> indVars(n);
-    handler.makeVariables(indVars);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < n; i++) {
-            indVars[i].setValue(_x[i]);
-        }
-    }
-
-    // multipliers
-    vector<CGBase> w(m);
-    handler.makeVariables(w);
-    if (_x.size() > 0) {
-        for (size_t i = 0; i < m; i++) {
-            w[i].setValue(Base(1.0));
-        }
-    }
-
     vector<CGBase> hess(_hessSparsity.rows.size());
     if (_loopTapes.empty()) {
         CppAD::sparse_hessian_work work;
@@ -208,19 +238,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
                                              duplicates);
     }
 
-    finishedJob();
-
-    LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
-
-    std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
-    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
-
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    return hess;
 }
 
 template<class Base>
@@ -285,7 +303,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
         /**
          * with loops
          */
-        generateSparseHessianWithLoopsSourceFromRev2(hessInfo, maxCompressedSize);
+        generateSparseHessianWithLoopsSourceFromRev2(hessInfo, maxCompressedSize, multiThreadingType);
         return;
     }
 
@@ -294,9 +312,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
     string rev2Suffix = "indep";
 
     if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix);
+        _sink->addSource(functionName + ".c", generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix));
     } else {
-        _sources[functionName + ".c"] = generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType);
+        _sink->addSource(functionName + ".c", generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType));
     }
     _cache.str("");
 }
@@ -498,11 +516,12 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         printFunctionStartPThreads(_cache, hessInfo.size());
         _cache << "\n"
                 "   for(i = 0; i < " << hessInfo.size() << "; ++i) {\n"
-                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
-                "      args[i]->func = p[i];\n"
-                "      args[i]->in = inLocal;\n"
-                "      args[i]->out[0] = &hess[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC .getArgumentAtomic() << ";\n"
+                "      args[i].func = p[i];\n"
+                "      args[i].in = inLocal;\n"
+                "      args[i].out[0] = &hess[offset[i]];\n"
+                "      args[i].atomicFun = " << langC .getArgumentAtomic() << ";\n"
+                "      job_args[i] = &args[i];\n"
+                "      elapsed[i] = 0;\n"
                 "   }\n"
                 "\n";
         printFunctionEndPThreads(_cache, hessInfo.size());
@@ -664,12 +683,12 @@ void ModelCSourceGen<Base>::generateHessianSparsitySource() {
     determineHessianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY, _hessSparsity);
-    _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 
     if (_hessianByEquation || _reverseTwo) {
         generateSparsity2DSource2(_name + "_" + FUNCTION_HESSIAN_SPARSITY2, _hessSparsities);
-        _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c"] = _cache.str();
+        _sink->addSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c", _cache.str());
         _cache.str("");
     }
 }
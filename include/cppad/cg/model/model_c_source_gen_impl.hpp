@@ -44,6 +44,15 @@ const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN = "sparse_jaco
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN = "sparse_hessian";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_BATCH = "forward_zero_batch";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_JACOBIAN_BATCH = "sparse_jacobian_batch";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_HESSIAN_BATCH = "sparse_hessian_batch";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN_SPARSITY = "jacobian_sparsity";
 
@@ -62,6 +71,12 @@ const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_ONE = "sparse_r
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO = "sparse_reverse_two";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_FORWARD_ONE_MULTI = "sparse_forward_one_multi";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_SPARSE_REVERSE_TWO_MULTI = "sparse_reverse_two_multi";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE_SPARSITY = "forward_one_sparsity";
 
@@ -77,6 +92,9 @@ const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_WORKSPACE_SIZE = "workspace_size";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::CONST = "const";
 
@@ -92,17 +110,226 @@ template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
     if (_sources.empty()) {
-        generateSources(multiThreadingType, timer);
+        try {
+            generateSources(multiThreadingType, timer);
+        } catch (...) {
+            _sources.clear(); // e.g. cancelled (must not be reused)
+            throw;
+        }
     }
     return _sources;
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::streamSources(MultiThreadingType multiThreadingType,
+                                          SourceSink& sink,
+                                          JobTimer* timer) {
+    if (!_sources.empty()) {
+        for (const auto& it : _sources) {
+            sink.addSource(it.first, it.second);
+        }
+        return;
+    }
+
+    _sink = &sink;
+    try {
+        generateSources(multiThreadingType, timer);
+    } catch (...) {
+        _sink = &_sourcesSink;
+        throw;
+    }
+    _sink = &_sourcesSink;
+}
+
+template<class Base>
+std::string ModelCSourceGen<Base>::getFingerprint(MultiThreadingType multiThreadingType) {
+    ContentHash h = CompilerCache::createHash();
+
+    auto addValue = [&h](const Base& v) {
+        addToFingerprint(h, v);
+    };
+
+    auto addIndexes = [&h](ArrayView<const size_t> indexes) {
+        h.add(indexes.size());
+        for (size_t i : indexes)
+            h.add(i);
+    };
+
+    /**
+     * generation options
+     */
+    h.add(_name);
+    h.add(_baseTypeName);
+    h.add(_parameterPrecision);
+    h.add(static_cast<unsigned long long>(multiThreadingType));
+    h.add(_multiThreading);
+    h.add(_multiThreadingLoopTasks);
+    h.add(_zero);
+    h.add(_jacobian);
+    h.add(_hessian);
+    h.add(_sparseJacobian);
+    h.add(_sparseHessian);
+    h.add(_hessianByEquation);
+    h.add(_forwardOne);
+    h.add(_reverseOne);
+    h.add(_reverseTwo);
+    h.add(_sparseJacobianReusesOne);
+    h.add(_sparseHessianReusesRev2);
+    h.add(_sparseJacobianColoring);
+    h.add(_sparseHessianColoring);
+    h.add(_batch);
+    h.add(_multiDirection);
+    h.add(static_cast<unsigned long long>(_jacMode));
+    h.add(_custom_jac.defined);
+    addIndexes(_custom_jac.row);
+    addIndexes(_custom_jac.col);
+    h.add(_custom_hess.defined);
+    addIndexes(_custom_hess.row);
+    addIndexes(_custom_hess.col);
+    h.add(_maxAssignPerFunc);
+    h.add(_maxOperationsPerAssignment);
+    h.add(_minimizeLiveVariables);
+    h.add(_temporariesInWorkspace);
+
+    h.add(_x.size());
+    for (const Base& v : _x)
+        addValue(v);
+
+    h.add(_relatedDepCandidates.size());
+    for (const auto& related : _relatedDepCandidates) {
+        addIndexes(std::vector<size_t>(related.begin(), related.end()));
+    }
+
+    /**
+     * the operations of the model (zero order forward mode)
+     */
+    CodeHandler<Base> handler;
+
+    std::vector<CGBase> indVars(_fun.Domain());
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < indVars.size(); i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+    // the position of each operation in the order they are hashed
+    std::unordered_map<const OperationNode<Base>*, size_t> ids;
+    for (size_t j = 0; j < indVars.size(); j++) {
+        ids[indVars[j].getOperationNode()] = j;
+    }
+
+    // depth-first search without recursion (the graph can be very deep)
+    std::vector<std::pair<OperationNode<Base>*, size_t> > stack;
+
+    // atomic functions whose fingerprint was already added
+    std::set<size_t> atomics;
+    const auto& atomicFuns = handler.getAtomicFunctions();
+
+    h.add(dep.size());
+    for (const CGBase& d : dep) {
+        if (d.isParameter()) {
+            h.add(0);
+            addValue(d.getValue());
+            continue;
+        }
+
+        stack.emplace_back(d.getOperationNode(), 0);
+        while (!stack.empty()) {
+            OperationNode<Base>* node = stack.back().first;
+            size_t& a = stack.back().second;
+            const auto& args = node->getArguments();
+
+            if (ids.find(node) != ids.end()) {
+                stack.pop_back();
+                continue;
+            }
+
+            // visit the arguments first
+            while (a < args.size() && (args[a].getOperation() == nullptr ||
+                                       ids.find(args[a].getOperation()) != ids.end())) {
+                a++;
+            }
+            if (a < args.size()) {
+                stack.emplace_back(args[a].getOperation(), 0);
+                continue;
+            }
+
+            h.add(static_cast<unsigned long long>(node->getOperationType()));
+            addIndexes(node->getInfo());
+            if (node->getOperationType() == CGOpCode::AtomicForward ||
+                node->getOperationType() == CGOpCode::AtomicReverse) {
+                size_t atomicId = node->getInfo()[0];
+                h.add(handler.getAtomicFunctionName(atomicId));
+                if (atomics.insert(atomicId).second) {
+                    auto itAtomic = atomicFuns.find(atomicId);
+                    if (itAtomic != atomicFuns.end())
+                        h.add(itAtomic->second->getFingerprint());
+                }
+            }
+
+            h.add(args.size());
+            for (const Argument<Base>& arg : args) {
+                if (arg.getOperation() != nullptr) {
+                    h.add(1);
+                    h.add(ids[arg.getOperation()]);
+                } else {
+                    h.add(0);
+                    addValue(*arg.getParameter());
+                }
+            }
+
+            size_t id = ids.size();
+            ids[node] = id;
+            stack.pop_back();
+        }
+
+        h.add(1);
+        h.add(ids[d.getOperationNode()]);
+    }
+
+    return h.str();
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::addToFingerprint(ContentHash& h,
+                                                    const Base& value) {
+    using RawBytes = std::integral_constant<bool, std::is_same<Base, double>::value ||
+                                                  std::is_same<Base, float>::value>;
+    addToFingerprint(h, value, RawBytes());
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::addToFingerprint(ContentHash& h,
+                                                    const Base& value,
+                                                    std::true_type rawBytes) {
+    h.add(reinterpret_cast<const char*>(&value), sizeof(Base));
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::addToFingerprint(ContentHash& h,
+                                                    const Base& value,
+                                                    std::false_type rawBytes) {
+    int precision = std::numeric_limits<Base>::max_digits10;
+    if (precision <= 0)
+        precision = 36; // numeric_limits is not specialized (enough for quadruple precision)
+
+    std::ostringstream os;
+    os << std::setprecision(precision) << value;
+    h.add(os.str());
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingType,
                                             JobTimer* timer) {
     _jobTimer = timer;
+    _maxLiveTemporaries = 0;
+    _workspaceSize = 0;
 
     generateLoops();
+    _loopsDetected = !_loopTapes.empty();
 
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
 
@@ -122,6 +349,9 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     if (_forwardOne) {
         generateSparseForwardOneSources();
         generateForwardOneSources();
+        if (_multiDirection) {
+            generateSparseForwardOneMultiSource();
+        }
     }
 
     if (_reverseOne) {
@@ -132,6 +362,9 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     if (_reverseTwo) {
         generateSparseReverseTwoSources();
         generateReverseTwoSources();
+        if (_multiDirection) {
+            generateSparseReverseTwoMultiSource();
+        }
     }
 
     if (_sparseJacobian) {
@@ -142,6 +375,20 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         generateSparseHessianSource(multiThreadingType);
     }
 
+    if (_batch && isBatchSupported()) {
+        if (_zero) {
+            generateZeroBatchSource();
+        }
+
+        if (_sparseJacobian) {
+            generateSparseJacobianBatchSource();
+        }
+
+        if (_sparseHessian) {
+            generateSparseHessianBatchSource();
+        }
+    }
+
     if (_sparseJacobian || _forwardOne || _reverseOne) {
         generateJacobianSparsitySource();
     }
@@ -154,6 +401,8 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
 
     generateAtomicFuncNames();
 
+    generateWorkspaceSizeSource();
+
     finishedJob();
 }
 
@@ -163,6 +412,10 @@ void ModelCSourceGen<Base>::generateLoops() {
         return; //nothing to do
     }
 
+    if (_funNoLoops != nullptr) {
+        return; // already determined by a previous (interrupted) generation
+    }
+
     startingJob("", JobTimer::LOOP_DETECTION);
 
     CodeHandler<Base> handler;
@@ -210,7 +463,7 @@ void ModelCSourceGen<Base>::generateInfoSource() {
             "   *indCount = " << nameGen->getIndependent().size() << "; // number of independent array variables\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    _sink->addSource(funcName + ".c", _cache.str());
 }
 
 template<class Base>
@@ -231,7 +484,21 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
             "   *n = " << n << ";\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    _sink->addSource(funcName + ".c", _cache.str());
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateWorkspaceSizeSource() {
+    std::string funcName = _name + "_" + FUNCTION_WORKSPACE_SIZE;
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* size",
+                                                                         "int* perThread"});
+    _cache << " {\n"
+            "   *size = " << _workspaceSize << "; // bytes\n"
+            "   *perThread = " << (_temporariesInWorkspace ? 1 : 0) << ";\n"
+            "}\n\n";
+
+    _sink->addSource(funcName + ".c", _cache.str());
 }
 
 template<class Base>
@@ -345,14 +612,14 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
             "   };\n";
 
     _cache << "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 
     /**
      * Sparsity
      */
     generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
-    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + function_sparsity + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -673,49 +940,45 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
         cache << "};";
     };
 
-    cache << "   ExecArgStruct* args[" << size << "];\n";
+    /**
+     * the scheduling information learned from previous calls is shared but it
+     * is only accessed through the thread pool so that this function is reentrant
+     */
+    cache << "   ExecArgStruct args[" << size << "];\n";
+    cache << "   void* job_args[" << size << "];\n";
     cache << "   static cppadcg_thpool_function_type execute_functions[" << size << "] = ";
     repeatFill("exec_func");
     cache << "\n";
-    cache << "   static float ref_elapsed[" << size << "] = ";
-    repeatFill("0");
-    cache << "\n";
-    cache << "   static float elapsed[" << size << "] = ";
+    cache << "   static float sched_ref_elapsed[" << size << "] = ";
     repeatFill("0");
     cache << "\n"
-            "   static int order[" << size << "] = {";
+            "   static int sched_order[" << size << "] = {";
     for (size_t i = 0; i < size; ++i) {
         if (i != 0) cache << ", ";
         cache << i;
     }
     cache << "};\n"
-            "   static int job2Thread[" << size << "] = ";
+            "   static int sched_job2Thread[" << size << "] = ";
     repeatFill("-1");
     cache << "\n"
-            "   static int last_elapsed_changed = 1;\n"
-            "   unsigned int nBench = cppadcg_thpool_get_n_time_meas();\n"
-            "   static unsigned int n_meas = 0;\n"
-            "   int do_benchmark = " << (size > 0 ? "(n_meas < nBench && !cppadcg_thpool_is_disabled())" : "0") << ";\n"
+            "   static cppadcg_thpool_schedule schedule = {" << size << ", sched_ref_elapsed, sched_order, sched_job2Thread, 0, 1};\n"
+            "   float ref_elapsed[" << size << "];\n"
+            "   float elapsed[" << size << "];\n"
+            "   int order[" << size << "];\n"
+            "   int job2Thread[" << size << "];\n"
+            "   int last_elapsed_changed;\n"
+            "   int do_benchmark = cppadcg_thpool_schedule_load(&schedule, ref_elapsed, order, job2Thread, &last_elapsed_changed);\n"
             "   float* elapsed_p = do_benchmark ? elapsed : NULL;\n";
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionEndPThreads(std::ostringstream& cache,
                                                      size_t size) {
-    cache << "   cppadcg_thpool_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
+    cache << "   cppadcg_thpool_add_jobs(execute_functions, job_args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
             "\n"
             "   cppadcg_thpool_wait();\n"
             "\n"
-            "   for(i = 0; i < " << size << "; ++i) {\n"
-            "      free(args[i]);\n"
-            "   }\n"
-            "\n"
-            "   if(do_benchmark) {\n"
-            "      cppadcg_thpool_update_order(ref_elapsed, n_meas, elapsed, order, " << size << ");\n"
-            "      n_meas++;\n"
-            "   } else {\n"
-            "      last_elapsed_changed = 0;\n"
-            "   }\n";
+            "   cppadcg_thpool_schedule_store(&schedule, elapsed_p, job2Thread);\n";
 }
 
 template<class Base>
@@ -802,6 +1065,143 @@ void ModelCSourceGen<Base>::printLoopEndOpenMP(std::ostringstream& cache,
 
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateDirectionalSources(const std::map<size_t, std::vector<size_t> >& elements,
+                                                       const std::function<void(size_t, const std::vector<size_t>&, DirectionalSourceGen&)>& generate) {
+    DirectionalSourceGen serial{&_fun, _jobTimer, &_atomicFunctions, _sink, _maxLiveTemporaries, _workspaceSize};
+
+    size_t nThreads = _sourceGenThreads;
+    if (nThreads == 0)
+        nThreads = std::thread::hardware_concurrency();
+    nThreads = std::min(nThreads, elements.size());
+    nThreads = std::min(nThreads, CppADParallelSetup<Base>::getMaxThreads() - 1);
+
+    std::vector<std::pair<size_t, const std::vector<size_t>*> > items;
+    for (const auto& it : elements) {
+        items.emplace_back(it.first, &it.second);
+    }
+    const size_t nItems = items.size();
+    size_t merged = 0; // the columns/rows already placed in the model
+
+    if (nThreads > 1 && !thread_alloc::in_parallel()) {
+        /**
+         * Each column/row is generated with a copy of the atomic function
+         * names, its own sources, and its own jobs, which are only merged
+         * (in the original order) after the column/row is completed so that
+         * the result does not depend on the number of threads.
+         * A column/row which uses atomic functions which were not used
+         * before is generated again afterwards because the indexes of the
+         * atomic functions depend on the previous columns/rows.
+         */
+        const size_t nAtomics = _atomicFunctions.size();
+        std::vector<std::vector<std::string> > atomicFunctions(nItems, _atomicFunctions);
+        std::vector<std::map<std::string, std::string> > sources(nItems);
+        std::vector<SourceMapSink> sinks;
+        sinks.reserve(nItems);
+        std::vector<std::unique_ptr<JobTimer> > timers(nItems);
+        std::vector<JobRecorder> recorders(nItems);
+        std::vector<std::promise<void> > done(nItems);
+        std::vector<DirectionalSourceGen> gens(nItems);
+        for (size_t i = 0; i < nItems; ++i) {
+            timers[i].reset(new JobTimer());
+            timers[i]->addListener(recorders[i]);
+            sinks.emplace_back(sources[i]);
+            gens[i] = DirectionalSourceGen{nullptr, timers[i].get(), &atomicFunctions[i], &sinks[i], 0, 0};
+        }
+
+        auto merge = [&](size_t i) {
+            if (_jobTimer != nullptr)
+                _jobTimer->replayJobs(recorders[i]);
+            for (auto& it : sources[i]) {
+                _sink->addSource(it.first, std::move(it.second));
+            }
+            serial.maxLiveTemporaries = std::max(serial.maxLiveTemporaries, gens[i].maxLiveTemporaries);
+            addWorkspaceSize(serial.workspaceSize, gens[i].workspaceSize);
+        };
+
+        std::atomic<size_t> next(0);
+        std::atomic<bool> stop(false);
+
+        auto generateItems = [&]() {
+            std::unique_ptr<ADFun<CGBase> > fun; // a tape cannot be evaluated by several threads
+            size_t i;
+            while (!stop && (i = next++) < nItems) {
+                try {
+                    if (fun == nullptr) {
+                        fun.reset(new ADFun<CGBase>());
+                        *fun = _fun;
+                    }
+                    gens[i].fun = fun.get();
+                    generate(items[i].first, *items[i].second, gens[i]);
+                    gens[i].fun = nullptr;
+                    done[i].set_value();
+                } catch (...) {
+                    stop = true;
+                    done[i].set_exception(std::current_exception());
+                }
+            }
+        };
+
+        {
+            CppADParallelSetup<Base> parallel(nThreads + 1);
+
+            std::vector<std::future<void> > workers(nThreads);
+            for (size_t t = 0; t < nThreads; ++t) {
+                workers[t] = std::async(std::launch::async, generateItems);
+            }
+
+            try {
+                for (size_t i = 0; i < nItems; ++i) {
+                    std::future<void> f = done[i].get_future();
+                    while (f.wait_for(std::chrono::milliseconds(20)) != std::future_status::ready) {
+                        if (_jobTimer != nullptr && _jobTimer->isCancelled()) {
+                            // interrupt the columns/rows being generated
+                            for (auto& t : timers)
+                                t->cancel();
+                        }
+                    }
+                    f.get();
+
+                    if (merged == i && atomicFunctions[i].size() == nAtomics) {
+                        merge(i);
+                        merged++;
+                    }
+                }
+            } catch (...) {
+                stop = true;
+                for (auto& w : workers) {
+                    w.wait();
+                }
+                if (_jobTimer != nullptr && _jobTimer->isCancelled()) {
+                    // throws a CGCancelledException and discards the running jobs
+                    _jobTimer->startingJob("", JobTimer::GRAPH);
+                }
+                throw;
+            }
+
+            for (auto& w : workers) {
+                w.get();
+            }
+        } // CppAD is back in sequential mode
+
+        // the original model is only used after all the copies were created
+        for (; merged < nItems; ++merged) {
+            if (atomicFunctions[merged].size() == nAtomics) {
+                merge(merged);
+            } else {
+                generate(items[merged].first, *items[merged].second, serial);
+            }
+        }
+    }
+
+    for (; merged < nItems; ++merged) {
+        generate(items[merged].first, *items[merged].second, serial);
+    }
+
+    _maxLiveTemporaries = serial.maxLiveTemporaries;
+    _workspaceSize = serial.workspaceSize;
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::startingJob(const std::string& jobName,
                                         const JobType& type) {
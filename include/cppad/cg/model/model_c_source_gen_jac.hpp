@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -52,43 +53,35 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType multiThreadingType) {
-    size_t m = _fun.Range();
-    size_t n = _fun.Domain();
-
     /**
      * Determine the sparsity pattern
      */
     determineJacobianSparsity();
 
-    bool forwardMode;
-
-    if (_jacMode == JacobianADMode::Automatic) {
-        if (_custom_jac.defined) {
-            forwardMode = estimateBestJacobianADMode(_jacSparsity.rows, _jacSparsity.cols);
-        } else {
-            forwardMode = n <= m;
-        }
-    } else {
-        forwardMode = _jacMode == JacobianADMode::Forward;
-    }
+    bool forwardMode = isSparseJacobianForwardMode();
 
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    if (_sparseJacobianColoring && _loopTapes.empty() && !_jacSparsity.rows.empty()) {
+        generateSparseJacobianColoredSource(forwardMode, multiThreadingType);
+    } else if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
     } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
@@ -110,6 +103,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -119,7 +113,30 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
         }
     }
 
-    vector<CGBase> jac(_jacSparsity.rows.size());
+    vector<CGBase> jac = prepareSparseJacobian(handler, indVars, forward);
+
+    finishedJob();
+
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+
+    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
+}
+
+template<class Base>
+std::vector<CG<Base>> ModelCSourceGen<Base>::prepareSparseJacobian(CodeHandler<Base>& handler,
+                                                                  std::vector<CGBase>& indVars,
+                                                                  bool forward) {
+    std::vector<CGBase> jac(_jacSparsity.rows.size());
     if (_loopTapes.empty()) {
         //printSparsityPattern(_jacSparsity.sparsity, "jac sparsity");
         CppAD::sparse_jacobian_work work;
@@ -133,18 +150,20 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
         jac = prepareSparseJacobianWithLoops(handler, indVars, forward);
     }
 
-    finishedJob();
-
-    LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
-    langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
-
-    std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+    return jac;
+}
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+template<class Base>
+bool ModelCSourceGen<Base>::isSparseJacobianForwardMode() {
+    if (_jacMode == JacobianADMode::Automatic) {
+        if (_custom_jac.defined) {
+            return estimateBestJacobianADMode(_jacSparsity.rows, _jacSparsity.cols);
+        } else {
+            return _fun.Domain() <= _fun.Range();
+        }
+    } else {
+        return _jacMode == JacobianADMode::Forward;
+    }
 }
 
 template<class Base>
@@ -226,12 +245,14 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
             generateSparseJacobianWithLoopsSourceFromForRev(jacInfo, maxCompressedSize,
                                                             FUNCTION_SPARSE_FORWARD_ONE, "indep", "jcol",
                                                             _nonLoopFor1Elements, _loopFor1Groups,
-                                                            generateFunctionNameLoopFor1);
+                                                            generateFunctionNameLoopFor1,
+                                                            multiThreadingType);
         } else {
             generateSparseJacobianWithLoopsSourceFromForRev(jacInfo, maxCompressedSize,
                                                             FUNCTION_SPARSE_REVERSE_ONE, "dep", "jrow",
                                                             _nonLoopRev1Elements, _loopRev1Groups,
-                                                            generateFunctionNameLoopRev1);
+                                                            generateFunctionNameLoopRev1,
+                                                            multiThreadingType);
         }
         return;
     }
@@ -241,9 +262,9 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
     string functionName(_cache.str());
 
     if(!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward);
+        _sink->addSource(functionName + ".c", generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward));
     } else {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType);
+        _sink->addSource(functionName + ".c", generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType));
     }
 
     _cache.str("");
@@ -441,11 +462,12 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         printFunctionStartPThreads(_cache, jacInfo.size());
         _cache << "\n"
                 "   for(i = 0; i < " << jacInfo.size() << "; ++i) {\n"
-                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
-                "      args[i]->func = p[i];\n"
-                "      args[i]->in = inLocal;\n"
-                "      args[i]->out[0] = &jac[offset[i]];\n"
-                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                "      args[i].func = p[i];\n"
+                "      args[i].in = inLocal;\n"
+                "      args[i].out[0] = &jac[offset[i]];\n"
+                "      args[i].atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                "      job_args[i] = &args[i];\n"
+                "      elapsed[i] = 0;\n"
                 "   }\n"
                 "\n";
         printFunctionEndPThreads(_cache, jacInfo.size());
@@ -482,7 +504,7 @@ void ModelCSourceGen<Base>::generateJacobianSparsitySource() {
     determineJacobianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY, _jacSparsity);
-    _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -0,0 +1,225 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_MULTI_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_MULTI_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseForwardOneMultiSource() {
+    const std::string jobName = "model (forward one) for multiple directions";
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+
+    determineJacobianSparsity();
+
+    std::string function = _name + "_" + FUNCTION_SPARSE_FORWARD_ONE_MULTI;
+    std::string valuesFunction = function + "_values";
+
+    if (!_jacSparsity.rows.empty()) {
+        startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+        std::vector<CGBase> indVars(n);
+        handler.makeVariables(indVars);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                indVars[i].setValue(_x[i]);
+            }
+        }
+
+        // the Jacobian is shared by all directions
+        std::vector<CGBase> jac = prepareSparseJacobian(handler, indVars, isSparseJacobianForwardMode());
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+        langC.setGenerateFunction(valuesFunction);
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+
+        handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize() + jac.size() * sizeof(Base));
+    }
+
+    generateGlobalMultiDirectionalFunctionSource(function, valuesFunction, m,
+                                                 _jacSparsity.rows, _jacSparsity.cols, false);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseReverseTwoMultiSource() {
+    const std::string jobName = "model (reverse two) for multiple directions";
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+
+    determineHessianSparsity();
+
+    std::vector<size_t> evalRows, evalCols;
+    determineSecondOrderElements4Eval(evalRows, evalCols);
+
+    std::string function = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO_MULTI;
+    std::string valuesFunction = function + "_values";
+
+    if (!evalRows.empty()) {
+        startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+        handler.setMinimizeLiveVariables(_minimizeLiveVariables);
+
+        // independent variables
+        std::vector<CGBase> indVars(n);
+        handler.makeVariables(indVars);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                indVars[i].setValue(_x[i]);
+            }
+        }
+
+        // multipliers
+        std::vector<CGBase> py2(m);
+        handler.makeVariables(py2);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < m; i++) {
+                py2[i].setValue(Base(1.0));
+            }
+        }
+
+        // the Hessian is shared by all directions
+        std::vector<CGBase> hess = prepareSparseHessian(handler, indVars, py2);
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+        langC.setGenerateFunction(valuesFunction);
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
+        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+
+        handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize() + hess.size() * sizeof(Base));
+    }
+
+    /**
+     * px2[j] = sum_l H(l, j) tx1[l]  where the elements of the Hessian
+     * are evaluated for each row in evalRows
+     */
+    generateGlobalMultiDirectionalFunctionSource(function, valuesFunction, n,
+                                                 evalCols, evalRows, true);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateGlobalMultiDirectionalFunctionSource(const std::string& function,
+                                                                         const std::string& valuesFunction,
+                                                                         size_t outSize,
+                                                                         const std::vector<size_t>& outIndexes,
+                                                                         const std::vector<size_t>& inIndexes,
+                                                                         bool multipliers) {
+    CPPADCG_ASSERT_UNKNOWN(outIndexes.size() == inIndexes.size());
+
+    size_t nnz = outIndexes.size();
+    const char* storage = _temporariesInWorkspace ? "static _Thread_local " : "";
+
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
+            "\n";
+    if (nnz > 0) {
+        _cache << "void " << valuesFunction << "(" << argsDcl << ");\n"
+                "\n";
+    }
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", function, {"unsigned long nDir",
+                                                                        _baseTypeName + " const *const * in",
+                                                                        _baseTypeName + "*const * out",
+                                                                        langC.generateArgumentAtomicDcl()});
+    _cache << " {\n";
+    if (nnz > 0) {
+        _cache << "   static const unsigned long outIdx[" << nnz << "] = {";
+        for (size_t e = 0; e < nnz; e++) {
+            if (e > 0) _cache << ",";
+            _cache << outIndexes[e];
+        }
+        _cache << "};\n"
+                "   static const unsigned long inIdx[" << nnz << "] = {";
+        for (size_t e = 0; e < nnz; e++) {
+            if (e > 0) _cache << ",";
+            _cache << inIndexes[e];
+        }
+        _cache << "};\n"
+                "   " << storage << _baseTypeName << " values[" << nnz << "];\n"
+                "   " << _baseTypeName << " const * inV[2];\n"
+                "   " << _baseTypeName << "* outV[1];\n"
+                "   " << _baseTypeName << " const * dirIn;\n"
+                "   " << _baseTypeName << "* dirOut;\n"
+                "   " << _baseTypeName << " v;\n"
+                "   unsigned long e, k;\n";
+    } else {
+        _cache << "   " << _baseTypeName << "* dirOut;\n"
+                "   unsigned long e;\n";
+    }
+    _cache << "\n"
+            "   dirOut = out[0];\n"
+            "   for (e = 0; e < " << outSize << " * nDir; e++)\n"
+            "      dirOut[e] = 0;\n";
+
+    if (nnz > 0) {
+        _cache << "\n"
+                "   if (nDir == 0)\n"
+                "      return 0; //nothing to do\n"
+                "\n"
+                "   // the derivative values are shared by all directions\n"
+                "   inV[0] = in[0];\n"
+                "   inV[1] = " << (multipliers ? "in[2]" : "0") << ";\n"
+                "   outV[0] = values;\n"
+                "   " << valuesFunction << "(inV, outV, " << langC.getArgumentAtomic() << ");\n"
+                "\n"
+                "   dirIn = in[1];\n"
+                "   for (e = 0; e < " << nnz << "; e++) {\n"
+                "      v = values[e];\n"
+                "      for (k = 0; k < nDir; k++)\n"
+                "         dirOut[outIdx[e] * nDir + k] += v * dirIn[inIdx[e] * nDir + k];\n"
+                "   }\n";
+    }
+    _cache << "\n"
+            "   return 0;\n"
+            "}\n";
+
+    _sink->addSource(function + ".c", _cache.str());
+    _cache.str("");
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -60,78 +60,81 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSources() {
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements) {
-    using std::vector;
-
     /**
      * Generate one function for each dependent variable
      */
-    size_t m = _fun.Range();
-    size_t n = _fun.Domain();
-
-    vector<CGBase> w(m);
-
-    /**
-     * Generate one function for each dependent variable
-     */
-    const std::string jobName = "model (reverse one)";
-    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+    generateDirectionalSources(elements, [this](size_t i, const std::vector<size_t>& cols, DirectionalSourceGen& gen) {
+        generateSparseReverseOneSourceWithAtomics(i, cols, gen);
+    });
+}
 
-    for (const auto& it : elements) {
-        size_t i = it.first;
-        const std::vector<size_t>& cols = it.second;
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseReverseOneSourceWithAtomics(size_t i,
+                                                                      const std::vector<size_t>& cols,
+                                                                      DirectionalSourceGen& gen) {
+    using std::vector;
 
-        _cache.str("");
-        _cache << "model (reverse one, dep " << i << ")";
-        const std::string subJobName = _cache.str();
+    ADFun<CGBase>& fun = *gen.fun;
+    size_t m = fun.Range();
+    size_t n = fun.Domain();
 
-        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+    std::ostringstream cache;
+    cache << "model (reverse one, dep " << i << ")";
+    const std::string subJobName = cache.str();
 
-        CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+    if (gen.timer != nullptr)
+        gen.timer->startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        vector<CGBase> indVars(_fun.Domain());
-        handler.makeVariables(indVars);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                indVars[i].setValue(_x[i]);
-            }
-        }
+    CodeHandler<Base> handler;
+    handler.setJobTimer(gen.timer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
-        CGBase py;
-        handler.makeVariable(py);
-        if (_x.size() > 0) {
-            py.setValue(Base(1.0));
+    vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t j = 0; j < n; j++) {
+            indVars[j].setValue(_x[j]);
         }
+    }
 
-        // TODO: consider caching the zero order coefficients somehow between calls
-        _fun.Forward(0, indVars);
-
-        w[i] = py;
-        vector<CGBase> dw = _fun.Reverse(1, w);
-        CPPADCG_ASSERT_UNKNOWN(dw.size() == n);
-        w[i] = Base(0);
+    CGBase py;
+    handler.makeVariable(py);
+    if (_x.size() > 0) {
+        py.setValue(Base(1.0));
+    }
 
-        vector<CGBase> dwCustom;
-        for (size_t it2 : cols) {
-            dwCustom.push_back(dw[it2]);
-        }
+    // TODO: consider caching the zero order coefficients somehow between calls
+    fun.Forward(0, indVars);
 
-        finishedJob();
+    vector<CGBase> w(m);
+    w[i] = py;
+    vector<CGBase> dw = fun.Reverse(1, w);
+    CPPADCG_ASSERT_UNKNOWN(dw.size() == n);
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
-        langC.setGenerateFunction(_cache.str());
+    vector<CGBase> dwCustom;
+    for (size_t it2 : cols) {
+        dwCustom.push_back(dw[it2]);
+    }
 
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
-        LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+    if (gen.timer != nullptr)
+        gen.timer->finishedJob();
 
-        handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
-    }
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, gen.sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    cache.str("");
+    cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
+    langC.setGenerateFunction(cache.str());
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("dw"));
+    LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
+
+    handler.generateCode(code, langC, dwCustom, nameGenHess, *gen.atomicFunctions, subJobName);
+    gen.maxLiveTemporaries = std::max(gen.maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(gen.workspaceSize, langC.getWorkspaceSize());
 }
 
 template<class Base>
@@ -146,6 +149,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -207,9 +211,10 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         const std::string subJobName = _cache.str();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
@@ -219,6 +224,8 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
 
         handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
     }
 }
 
@@ -319,7 +326,7 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "   free(pyPos);\n"
             "   return 0;\n"
             "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
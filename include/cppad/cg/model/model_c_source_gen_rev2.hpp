@@ -67,79 +67,88 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSources() {
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std::map<size_t, std::vector<size_t> >& elements) {
+    generateDirectionalSources(elements, [this](size_t j, const std::vector<size_t>& cols, DirectionalSourceGen& gen) {
+        generateSparseReverseTwoSourceWithAtomics(j, cols, gen);
+    });
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseReverseTwoSourceWithAtomics(size_t j,
+                                                                      const std::vector<size_t>& cols,
+                                                                      DirectionalSourceGen& gen) {
     using std::vector;
 
-    const size_t m = _fun.Range();
-    const size_t n = _fun.Domain();
+    ADFun<CGBase>& fun = *gen.fun;
+    const size_t m = fun.Range();
+    const size_t n = fun.Domain();
     //const size_t k = 1;
     const size_t p = 2;
 
-    vector<CGBase> tx1v(n);
-
-    for (const auto& it : elements) {
-        size_t j = it.first;
-        const std::vector<size_t>& cols = it.second;
-
-        _cache.str("");
-        _cache << "model (reverse two, indep " << j << ")";
-        const std::string subJobName = _cache.str();
-
-        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+    std::ostringstream cache;
+    cache << "model (reverse two, indep " << j << ")";
+    const std::string subJobName = cache.str();
 
-        CodeHandler<Base> handler;
-        handler.setJobTimer(_jobTimer);
+    if (gen.timer != nullptr)
+        gen.timer->startingJob("'" + subJobName + "'", JobTimer::GRAPH);
 
-        vector<CGBase> tx0(n);
-        handler.makeVariables(tx0);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < n; i++) {
-                tx0[i].setValue(_x[i]);
-            }
-        }
-
-        CGBase tx1;
-        handler.makeVariable(tx1);
-        if (_x.size() > 0) {
-            tx1.setValue(Base(1.0));
-        }
+    CodeHandler<Base> handler;
+    handler.setJobTimer(gen.timer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
-        vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
-        handler.makeVariables(py);
-        if (_x.size() > 0) {
-            for (size_t i = 0; i < m; i++) {
-                py[i].setValue(Base(1.0));
-            }
+    vector<CGBase> tx0(n);
+    handler.makeVariables(tx0);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < n; i++) {
+            tx0[i].setValue(_x[i]);
         }
+    }
 
-        _fun.Forward(0, tx0);
-
-        tx1v[j] = tx1;
-        _fun.Forward(1, tx1v);
-        tx1v[j] = Base(0);
-        vector<CGBase> px = _fun.Reverse(2, py);
-        CPPADCG_ASSERT_UNKNOWN(px.size() == 2 * n);
+    CGBase tx1;
+    handler.makeVariable(tx1);
+    if (_x.size() > 0) {
+        tx1.setValue(Base(1.0));
+    }
 
-        vector<CGBase> pxCustom;
-        for (size_t jj : cols) {
-            pxCustom.push_back(px[jj * p + 1]); // not interested in all values
+    vector<CGBase> py(m); // (k+1)*m is not used because we are not interested in all values
+    handler.makeVariables(py);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < m; i++) {
+            py[i].setValue(Base(1.0));
         }
+    }
 
-        finishedJob();
+    fun.Forward(0, tx0);
 
-        LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
-        _cache.str("");
-        _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
-        langC.setGenerateFunction(_cache.str());
+    vector<CGBase> tx1v(n);
+    tx1v[j] = tx1;
+    fun.Forward(1, tx1v);
+    vector<CGBase> px = fun.Reverse(2, py);
+    CPPADCG_ASSERT_UNKNOWN(px.size() == 2 * n);
+
+    vector<CGBase> pxCustom;
+    for (size_t jj : cols) {
+        pxCustom.push_back(px[jj * p + 1]); // not interested in all values
+    }
 
-        std::ostringstream code;
-        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
-        LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+    if (gen.timer != nullptr)
+        gen.timer->finishedJob();
 
-        handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
-    }
+    LanguageC<Base> langC(_baseTypeName);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, gen.sources);
+    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+    langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
+    cache.str("");
+    cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
+    langC.setGenerateFunction(cache.str());
+
+    std::ostringstream code;
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
+    LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
+
+    handler.generateCode(code, langC, pxCustom, nameGenRev2, *gen.atomicFunctions, subJobName);
+    gen.maxLiveTemporaries = std::max(gen.maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(gen.workspaceSize, langC.getWorkspaceSize());
 }
 
 template<class Base>
@@ -167,6 +176,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
     // we can use a new handler to reduce memory usage
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
 
     vector<CGBase> tx0(n);
     handler.makeVariables(tx0);
@@ -230,9 +240,10 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         }
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setTemporariesInWorkspace(_temporariesInWorkspace);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -242,6 +253,8 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+        addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
     }
 }
 
@@ -363,7 +376,7 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "   return 0;\n"
             "};\n";
 
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -64,6 +64,21 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * Folder where the sources of each model are saved together with
+     * the model fingerprint (empty if disabled)
+     */
+    std::string _incrementalFolder;
+    /**
+     * The number of threads used to generate the sources of the models
+     * (zero means the number of hardware threads)
+     */
+    size_t _sourceGenThreads;
+    /**
+     * Whether or not the sources of the models are provided to the model
+     * library processors as they are generated (without keeping them)
+     */
+    bool _streamModelSources;
     /**
      * temporary stream to generate source code
      */
@@ -78,7 +93,9 @@ public:
      *              this object)
      */
     inline ModelLibraryCSourceGen(ModelCSourceGen<Base>& model):
-        _multiThreading(MultiThreadingType::NONE) {
+        _multiThreading(MultiThreadingType::NONE),
+        _sourceGenThreads(1),
+        _streamModelSources(false) {
         CPPADCG_ASSERT_KNOWN(_models.find(model.getName()) == _models.end(),
                              "Another model with the same name was already registered")
 
@@ -158,6 +175,105 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Provides the folder where the generated sources of each model are
+     * saved for incremental generation.
+     *
+     * @return the folder path (empty if incremental generation is disabled)
+     */
+    inline const std::string& getIncrementalFolder() const {
+        return _incrementalFolder;
+    }
+
+    /**
+     * Defines a folder where the generated sources of each model are saved
+     * together with a fingerprint of the model
+     * (see ModelCSourceGen::getFingerprint()).
+     * Models whose fingerprint did not change since the last time their
+     * sources were saved reuse those sources instead of generating them
+     * again, and only the library level sources and the sources of the
+     * modified models are generated.
+     * Object files are also reused when the compiler caches object files
+     * (e.g. AbstractCCompiler::setCacheFolder()).
+     *
+     * @param folder path to the folder (created if it does not exist).
+     *               An empty path disables incremental generation.
+     */
+    inline void setIncrementalFolder(const std::string& folder) {
+        _incrementalFolder = folder;
+    }
+
+    /**
+     * Provides the number of threads used to generate the sources of the
+     * models.
+     *
+     * @return the number of threads (zero means the number of hardware
+     *         threads)
+     */
+    inline size_t getSourceGenerationThreadNumber() const {
+        return _sourceGenThreads;
+    }
+
+    /**
+     * Defines the number of threads used to generate the sources of the
+     * models.
+     * When more than one thread is used, the sources of all the models are
+     * generated concurrently (one model per thread) when the sources of
+     * the first model are requested.
+     * The generated sources do not depend on the number of threads.
+     * The jobs of each model are reported to the listeners of this object
+     * from the calling thread, in the order of the models, once the
+     * model is completed (with their original times).
+     *
+     * CppAD is placed in parallel mode while the sources are generated
+     * (see CppADParallelSetup), therefore CppAD must not be used by any
+     * other thread at the same time unless a CppADParallelSetup already
+     * exists (e.g. created before createDynamicLibraryAsync()),
+     * in which case that setup is used and its available thread numbers
+     * limit the number of threads.
+     * Each model must use its own ADFun (each thread evaluates its own copy
+     * of the tape) and atomic functions shared by several models must
+     * support concurrent evaluations.
+     *
+     * @param threads the number of threads (zero means the number of
+     *                hardware threads and one disables the concurrent
+     *                generation)
+     */
+    inline void setSourceGenerationThreadNumber(size_t threads) {
+        _sourceGenThreads = threads;
+    }
+
+    /**
+     * Whether or not the source files of the models are provided to the
+     * model library processors one at a time, as they are generated.
+     *
+     * @see setStreamModelSources()
+     */
+    inline bool isStreamModelSources() const {
+        return _streamModelSources;
+    }
+
+    /**
+     * Defines whether or not the source files of the models are provided
+     * to the model library processors one at a time, as they are
+     * generated, instead of keeping all the sources of a model in memory.
+     * The processors which support it (e.g. DynamicModelLibraryProcessor
+     * and SaveFilesModelLibraryProcessor) compile or save each file and
+     * release it right away, so that the peak memory usage depends on
+     * the largest files instead of all the sources of the model.
+     * The sources of the models are not kept and, therefore, they are
+     * generated again if they are requested later.
+     *
+     * The sources are still kept in memory when they are generated by
+     * several threads (see setSourceGenerationThreadNumber()) or when an
+     * incremental folder is used.
+     *
+     * @param stream whether or not to stream the model sources
+     */
+    inline void setStreamModelSources(bool stream) {
+        _streamModelSources = stream;
+    }
+
     /**
      * Saves the generated C source code into several files.
      * 
@@ -178,6 +294,62 @@ public:
     virtual const std::map<std::string, std::string>& getLibrarySources();
 protected:
 
+    /**
+     * Provides the sources of a model, which are either generated or
+     * loaded from the incremental folder.
+     */
+    virtual const std::map<std::string, std::string>& getModelSources(ModelCSourceGen<Base>& model);
+
+    /**
+     * Provides the sources of a model, which are either generated or
+     * loaded from the incremental folder, reporting the jobs to a given
+     * timer.
+     */
+    virtual const std::map<std::string, std::string>& getModelSources(ModelCSourceGen<Base>& model,
+                                                                       JobTimer& timer);
+
+    /**
+     * Provides each source file of a model to a sink.
+     * The files are generated directly into the sink if the model sources
+     * are streamed, otherwise they are copies of getModelSources().
+     */
+    virtual void streamModelSources(ModelCSourceGen<Base>& model,
+                                    SourceSink& sink);
+
+    /**
+     * Generates/loads the sources of all the models which were not
+     * generated yet using several threads.
+     */
+    virtual void generateModelSources();
+
+    /**
+     * Provides the sources of a model from a thread other than the one
+     * which created the tape of the model (used by generateModelSources()).
+     * The model is generated with a copy of its tape created by the
+     * current thread.
+     */
+    virtual void getModelSourcesWithLocalTape(ModelCSourceGen<Base>& model,
+                                              JobTimer& timer);
+
+    /**
+     * Loads the sources of a model from the incremental folder together
+     * with the information determined while they were generated (e.g.
+     * the workspace size).
+     *
+     * @return true if the sources were generated with the same fingerprint
+     */
+    virtual bool loadModelSources(ModelCSourceGen<Base>& model,
+                                  const std::string& folder,
+                                  const std::string& fingerprint);
+
+    /**
+     * Saves the sources of a model to the incremental folder together
+     * with the information determined while they were generated.
+     */
+    virtual void saveModelSources(const ModelCSourceGen<Base>& model,
+                                  const std::string& folder,
+                                  const std::string& fingerprint);
+
     virtual void generateVersionSource(std::map<std::string, std::string>& sources);
 
     virtual void generateModelsSource(std::map<std::string, std::string>& sources);
@@ -79,7 +79,7 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder)
 
     // save/generate model sources
     for (const auto& it : _models) {
-        saveSources(sourcesFolder, it.second->getSources());
+        saveSources(sourcesFolder, getModelSources(*it.second));
     }
 
     // save/generate library sources
@@ -102,6 +102,227 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder,
     }
 }
 
+template<class Base>
+const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getModelSources(ModelCSourceGen<Base>& model) {
+    if (model._sources.empty() && _sourceGenThreads != 1) {
+        generateModelSources();
+    }
+
+    return getModelSources(model, *this);
+}
+
+template<class Base>
+const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getModelSources(ModelCSourceGen<Base>& model,
+                                                                                       JobTimer& timer) {
+    if (_incrementalFolder.empty() || !model._sources.empty()) {
+        return model.getSources(_multiThreading, &timer);
+    }
+
+    std::string folder = system::createPath(_incrementalFolder, model.getName());
+    std::string fingerprint = model.getFingerprint(_multiThreading);
+
+    if (loadModelSources(model, folder, fingerprint)) {
+        timer.startingJob("'" + model.getName() + "'", JobTimer::REUSING_CACHED);
+        timer.finishedJob();
+        return model._sources;
+    }
+
+    const std::map<std::string, std::string>& sources = model.getSources(_multiThreading, &timer);
+    saveModelSources(model, folder, fingerprint);
+    return sources;
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::streamModelSources(ModelCSourceGen<Base>& model,
+                                                     SourceSink& sink) {
+    if (!_streamModelSources || !model._sources.empty() ||
+        !_incrementalFolder.empty() || _sourceGenThreads != 1) {
+        for (const auto& it : getModelSources(model)) {
+            sink.addSource(it.first, it.second);
+        }
+        return;
+    }
+
+    model.streamSources(_multiThreading, sink, this);
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateModelSources() {
+    std::vector<ModelCSourceGen<Base>*> models;
+    for (const auto& it : _models) {
+        if (it.second->_sources.empty())
+            models.push_back(it.second);
+    }
+
+    size_t nThreads = _sourceGenThreads;
+    if (nThreads == 0)
+        nThreads = std::thread::hardware_concurrency();
+    nThreads = std::min(nThreads, models.size());
+    nThreads = std::min(nThreads, CppADParallelSetup<Base>::getMaxThreads() - 1);
+
+    if (nThreads <= 1) {
+        return; // each model is generated when it is requested
+    }
+
+    /**
+     * the jobs of each model are recorded and only reported (from this
+     * thread) after the model is completed so that the output does not
+     * depend on the number of threads
+     */
+    std::vector<std::unique_ptr<JobTimer> > timers(models.size());
+    std::vector<JobRecorder> recorders(models.size());
+    std::vector<std::promise<void> > done(models.size());
+    for (size_t i = 0; i < models.size(); ++i) {
+        timers[i].reset(new JobTimer());
+        timers[i]->addListener(recorders[i]);
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> stop(false);
+
+    auto generate = [&]() {
+        size_t i;
+        while (!stop && (i = next++) < models.size()) {
+            try {
+                if (isCancelled()) {
+                    timers[i]->cancel(); // do not start new models
+                }
+                getModelSourcesWithLocalTape(*models[i], *timers[i]);
+                done[i].set_value();
+            } catch (...) {
+                stop = true;
+                done[i].set_exception(std::current_exception());
+            }
+        }
+    };
+
+    CppADParallelSetup<Base> parallel(nThreads + 1);
+
+    std::vector<std::future<void> > workers(nThreads);
+    for (size_t t = 0; t < nThreads; ++t) {
+        workers[t] = std::async(std::launch::async, generate);
+    }
+
+    try {
+        for (size_t i = 0; i < models.size(); ++i) {
+            std::future<void> f = done[i].get_future();
+            while (f.wait_for(std::chrono::milliseconds(20)) != std::future_status::ready) {
+                if (isCancelled()) {
+                    // interrupt the models being generated
+                    for (auto& t : timers)
+                        t->cancel();
+                }
+            }
+            f.get();
+
+            replayJobs(recorders[i]);
+        }
+    } catch (...) {
+        stop = true;
+        for (auto& w : workers) {
+            w.wait();
+        }
+        if (isCancelled()) {
+            // throws a CGCancelledException and discards the running jobs
+            startingJob("", JobTimer::SOURCE_FOR_MODEL);
+        }
+        throw;
+    }
+
+    for (auto& w : workers) {
+        w.get();
+    }
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::getModelSourcesWithLocalTape(ModelCSourceGen<Base>& model,
+                                                               JobTimer& timer) {
+    /**
+     * The memory of the original tape was allocated by the main thread and
+     * must not be released/reallocated by this thread (e.g. when new
+     * Taylor coefficients are required). A copy created by this thread is
+     * used instead and the original tape is placed back afterwards.
+     */
+    ADFun<CG<Base> > fun;
+    fun = model._fun;
+
+    model._fun.swap(fun);
+    try {
+        getModelSources(model, timer);
+    } catch (...) {
+        model._fun.swap(fun);
+        throw;
+    }
+    model._fun.swap(fun);
+}
+
+template<class Base>
+bool ModelLibraryCSourceGen<Base>::loadModelSources(ModelCSourceGen<Base>& model,
+                                                    const std::string& folder,
+                                                    const std::string& fingerprint) {
+    std::ifstream manifest(system::createPath(folder, "fingerprint").c_str());
+    std::string line;
+    if (!manifest || !std::getline(manifest, line) || line != fingerprint)
+        return false;
+
+    /**
+     * information determined while the sources were generated
+     */
+    if (!std::getline(manifest, line))
+        return false;
+    std::istringstream info(line);
+    std::string key;
+    bool loopsDetected;
+    size_t workspaceSize, maxLiveTemporaries;
+    if (!(info >> key >> loopsDetected >> workspaceSize >> maxLiveTemporaries) || key != "info")
+        return false;
+
+    std::map<std::string, std::string> loaded;
+    while (std::getline(manifest, line)) {
+        if (line.empty())
+            continue;
+        std::ifstream file(system::createPath(folder, line).c_str());
+        if (!file)
+            return false; // e.g. removed by the user
+        std::ostringstream content;
+        content << file.rdbuf();
+        loaded[line] = content.str();
+    }
+
+    if (loaded.empty())
+        return false;
+
+    model._sources.swap(loaded);
+    model._loopsDetected = loopsDetected;
+    model._workspaceSize = workspaceSize;
+    model._maxLiveTemporaries = maxLiveTemporaries;
+    return true;
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::saveModelSources(const ModelCSourceGen<Base>& model,
+                                                    const std::string& folder,
+                                                    const std::string& fingerprint) {
+    const std::map<std::string, std::string>& sources = model._sources;
+
+    system::createFolder(_incrementalFolder);
+    system::createFolder(folder);
+
+    // the fingerprint is only saved after all the sources
+    std::string manifestPath = system::createPath(folder, "fingerprint");
+    std::remove(manifestPath.c_str());
+
+    saveSources(folder, sources);
+
+    std::ofstream manifest(manifestPath.c_str());
+    manifest << fingerprint << "\n";
+    manifest << "info " << model._loopsDetected << " " << model._workspaceSize << " " << model._maxLiveTemporaries << "\n";
+    for (const auto& it : sources) {
+        manifest << it.first << "\n";
+    }
+    manifest.close();
+}
+
 template<class Base>
 const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibrarySources() {
     if (_libSources.empty()) {
@@ -312,7 +533,7 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
 
     } else {
         _cache.str("");
-        _cache << "enum ScheduleStrategy {SCHED_STATIC = 1, SCHED_DYNAMIC = 2, SCHED_GUIDED = 3};\n"
+        _cache << "enum ScheduleStrategy {SCHED_STATIC = 1, SCHED_DYNAMIC = 2, SCHED_GUIDED = 3, SCHED_WORK_STEALING = 4};\n"
                 "\n";
         _cache << "void " << FUNCTION_SETTHREADPOOLDISABLED << "(int disabled) {\n";
         _cache << "}\n\n";
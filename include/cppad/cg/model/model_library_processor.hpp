@@ -43,7 +43,16 @@ protected:
     }
 
     inline const std::map<std::string, std::string>& getSources(ModelCSourceGen<Base>& model) {
-        return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
+        return modelLibraryHelper_->getModelSources(model);
+    }
+
+    /**
+     * Provides each source file of a model to a sink (as soon as it is
+     * generated if the model library streams the model sources).
+     */
+    inline void streamSources(ModelCSourceGen<Base>& model,
+                              SourceSink& sink) {
+        modelLibraryHelper_->streamModelSources(model, sink);
     }
 
 };
@@ -249,13 +249,13 @@ inline void moveNonIndexedOutsideLoop(CodeHandler<Base>& handler,
     indexed.adjustSize();
     indexed.fill(0);
 
-    const std::vector<Argument<Base> >& endArgs = loopEnd.getArguments();
+    const ArenaVector<Argument<Base> >& endArgs = loopEnd.getArguments();
     for (size_t i = 0; i < endArgs.size(); i++) {
         CPPADCG_ASSERT_UNKNOWN(endArgs[i].getOperation() != nullptr);
         LoopNonIndexedLocator<Base>(handler, indexed, nonIndexed, loopIndex).findNonIndexedNodes(*endArgs[i].getOperation());
     }
 
-    std::vector<Argument<Base> >& startArgs = loopStart.getArguments();
+    ArenaVector<Argument<Base> >& startArgs = loopStart.getArguments();
 
     size_t sas = startArgs.size();
     startArgs.resize(sas + nonIndexed.size());
@@ -297,7 +297,7 @@ public:
             }
         }
 
-        const std::vector<Argument<Base> >& args = node.getArguments();
+        const ArenaVector<Argument<Base> >& args = node.getArguments();
         size_t size = args.size();
 
         bool indexedPath = false; // whether or not this node depends on indexed independents
@@ -887,16 +887,51 @@ inline void determineForRevUsagePatterns(const std::map<LoopModel<Base>*, std::m
 }
 
 /**
- * @param loopGroups Used elements from the arrays provided by the group
- *                   function calls (loop->group->{array->{compressed position} })
- * @param nonLoopElements Used elements from non loop function calls
- *                        ([array]{compressed position})
+ * Prints the source code which evaluates a sparse Jacobian or a sparse
+ * Hessian using the forward/reverse mode functions generated for the
+ * equations which belong (and do not belong) to loops.
+ * The calls to these functions can be printed all together in a single
+ * function or distributed through several functions (e.g. tasks which
+ * are executed by different threads).
  */
 template<class Base>
-void printForRevUsageFunction(std::ostringstream& out,
-                              const std::string& baseTypeName,
+class ForRevUsagePrinter {
+private:
+    const std::string _baseTypeName;
+    const std::string _modelName;
+    const std::string _localFunction;
+    const std::string _nlSuffix;
+    const std::string _keyIndexName;
+    const std::string _indexIt;
+    const std::string _resultName;
+    const size_t _inLocalSize;
+    const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& _loopGroups;
+    const std::map<size_t, CompressedVectorInfo>& _matrixInfo;
+    void (*_generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g);
+    const size_t _nnz;
+    const size_t _maxCompressedSize;
+    /**
+     * the non loop function calls ([array]{compressed position})
+     */
+    std::vector<std::pair<size_t, const std::set<size_t>*> > _nonLoopCalls;
+    /**
+     * the loop function calls grouped by the number of iterations
+     */
+    std::map<size_t, std::map<LoopModel<Base>*, std::map<size_t, ArrayGroup*> > > _loopCalls;
+    SmartVectorPointer<ArrayGroup> _garbage;
+    std::set<RandomIndexPattern*> _indexRandomPatterns;
+    std::string _loopFArgs;
+    std::string _argsLocal;
+public:
+
+    /**
+     * @param loopGroups Used elements from the arrays provided by the group
+     *                   function calls (loop->group->{array->{compressed position} })
+     * @param nonLoopElements Used elements from non loop function calls
+     *                        ([array]{compressed position})
+     */
+    inline ForRevUsagePrinter(const std::string& baseTypeName,
                               const std::string& modelName,
-                              const std::string& modelFunction,
                               size_t inLocalSize,
                               const std::string& localFunction,
                               const std::string& suffix,
@@ -908,173 +943,283 @@ void printForRevUsageFunction(std::ostringstream& out,
                               const std::map<size_t, CompressedVectorInfo>& matrixInfo,
                               void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
                               size_t nnz,
-                              size_t maxCompressedSize) {
-    using namespace std;
-
-    /**
-     * determine to which functions we can provide the Hessian row directly
-     * without needing a temporary array (compressed)
-     */
-    SmartVectorPointer<ArrayGroup> garbage;
-    map<size_t, map<LoopModel<Base>*, map<size_t, ArrayGroup*> > > loopCalls;
-
-    /**
-     * Determine jrow index patterns and
-     * Hessian row start patterns
-     */
-    determineForRevUsagePatterns(loopGroups, matrixInfo, loopCalls, garbage);
+                              size_t maxCompressedSize) :
+        _baseTypeName(baseTypeName),
+        _modelName(modelName),
+        _localFunction(localFunction),
+        _nlSuffix("noloop_" + suffix),
+        _keyIndexName(keyIndexName),
+        _indexIt(indexIt),
+        _resultName(resultName),
+        _inLocalSize(inLocalSize),
+        _loopGroups(loopGroups),
+        _matrixInfo(matrixInfo),
+        _generateLocalFunctionName(generateLocalFunctionName),
+        _nnz(nnz),
+        _maxCompressedSize(maxCompressedSize) {
+        CPPADCG_ASSERT_UNKNOWN(indexIt != "e" && keyIndexName != "e");
+
+        _nonLoopCalls.reserve(nonLoopElements.size());
+        for (const auto& it : nonLoopElements) {
+            _nonLoopCalls.emplace_back(it.first, &it.second);
+        }
 
-    string nlRev2Suffix = "noloop_" + suffix;
+        /**
+         * Determine jrow index patterns and
+         * Hessian row start patterns
+         */
+        determineForRevUsagePatterns(loopGroups, matrixInfo, _loopCalls, _garbage);
 
-    LanguageC<Base> langC(baseTypeName);
-    string loopFArgs = "inLocal, outLocal, " + langC.getArgumentAtomic();
-    string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
-    std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
+        /**
+         * Find random index patterns
+         */
+        for (const auto& itItlg : _loopCalls) {
 
-    LanguageC<Base>::printFunctionDeclaration(out, "void", modelFunction, argsDcl2);
-    out << " {\n";
+            for (const auto& itlg : itItlg.second) {
 
-    /**
-     * Find random index patterns
-     */
-    set<RandomIndexPattern*> indexRandomPatterns;
+                for (const auto& itg : itlg.second) {
+                    ArrayGroup* group = itg.second;
 
-    for (const auto& itItlg : loopCalls) {
+                    CodeHandler<Base>::findRandomIndexPatterns(group->pattern.get(), _indexRandomPatterns);
 
-        for (const auto& itlg : itItlg.second) {
+                    if (group->startLocPattern.get() != nullptr) {
+                        CodeHandler<Base>::findRandomIndexPatterns(group->startLocPattern.get(), _indexRandomPatterns);
 
-            for (const auto& itg : itlg.second) {
-                ArrayGroup* group = itg.second;
+                    } else {
+                        for (const auto& itc : group->elCount2elements) {
+                            const ArrayElementGroup* eg = itc.second;
 
-                CodeHandler<Base>::findRandomIndexPatterns(group->pattern.get(), indexRandomPatterns);
-
-                if (group->startLocPattern.get() != nullptr) {
-                    CodeHandler<Base>::findRandomIndexPatterns(group->startLocPattern.get(), indexRandomPatterns);
-
-                } else {
-                    for (const auto& itc : group->elCount2elements) {
-                        const ArrayElementGroup* eg = itc.second;
-
-                        for (const ArrayElementCopyPattern& ePos : eg->elements) {
-                            CodeHandler<Base>::findRandomIndexPatterns(ePos.resultPattern, indexRandomPatterns);
-                            CodeHandler<Base>::findRandomIndexPatterns(ePos.compressedPattern, indexRandomPatterns);
+                            for (const ArrayElementCopyPattern& ePos : eg->elements) {
+                                CodeHandler<Base>::findRandomIndexPatterns(ePos.resultPattern, _indexRandomPatterns);
+                                CodeHandler<Base>::findRandomIndexPatterns(ePos.compressedPattern, _indexRandomPatterns);
+                            }
                         }
                     }
                 }
             }
         }
+
+        LanguageC<Base>::generateNames4RandomIndexPatterns(_indexRandomPatterns);
+
+        LanguageC<Base> langC(baseTypeName);
+        _loopFArgs = "inLocal, outLocal, " + langC.getArgumentAtomic();
+        langC.setArgumentIn("inLocal");
+        langC.setArgumentOut("outLocal");
+        _argsLocal = langC.generateDefaultFunctionArguments();
     }
 
+    ForRevUsagePrinter(const ForRevUsagePrinter&) = delete;
+    ForRevUsagePrinter& operator=(const ForRevUsagePrinter&) = delete;
+
     /**
-     * static variables
+     * @return the number of function calls for equations which do not
+     *         belong to loops
      */
-    LanguageC<Base>::generateNames4RandomIndexPatterns(indexRandomPatterns);
-    LanguageC<Base>::printRandomIndexPatternDeclaration(out, "   ", indexRandomPatterns);
+    inline size_t getNonLoopCallCount() const {
+        return _nonLoopCalls.size();
+    }
 
     /**
-     * local variables
+     * @return the loop function calls grouped by the number of iterations
+     *         (iteration count->loop->group->array group)
      */
-    out << "   " << baseTypeName << " const * inLocal[" << inLocalSize << "];\n"
-            "   " << baseTypeName << " inLocal1 = 1;\n"
-            "   " << baseTypeName << " * outLocal[1];\n"
-            "   unsigned long " << indexIt << ";\n"
-            "   unsigned long " << keyIndexName << ";\n"
-            "   unsigned long e;\n";
-    CPPADCG_ASSERT_UNKNOWN(indexIt != "e" && keyIndexName != "e");
-    if (maxCompressedSize > 0) {
-        out << "   " << baseTypeName << " compressed[" << maxCompressedSize << "];\n";
+    inline const std::map<size_t, std::map<LoopModel<Base>*, std::map<size_t, ArrayGroup*> > >& getLoopCalls() const {
+        return _loopCalls;
     }
-    out << "   " << baseTypeName << " * " << resultName << " = out[0];\n"
-            "\n"
-            "   inLocal[0] = in[0];\n"
-            "   inLocal[1] = &inLocal1;\n";
-    for (size_t j = 2; j < inLocalSize; j++)
-        out << "   inLocal[" << j << "] = in[" << (j - 1) << "];\n";
 
-    out << "\n";
+    /**
+     * @return the number of elements in the result array
+     */
+    inline size_t getResultSize() const {
+        return _nnz;
+    }
 
     /**
-     * zero the output
+     * Prints a function which evaluates all the elements of the result.
      */
-    out << "   for(e = 0; e < " << nnz << "; e++) " << resultName << "[e] = 0;\n"
-            "\n";
+    inline void printFunction(std::ostringstream& out,
+                              const std::string& modelFunction) {
+        printFunctionStart(out, modelFunction, "   ");
+
+        /**
+         * zero the output
+         */
+        printZeroResult(out);
+
+        /**
+         * contributions from equations NOT belonging to loops
+         * (must come before the loop related values because of the assignments)
+         */
+        bool lastCompressed = false;
+        printNonLoopCalls(out, 0, _nonLoopCalls.size(), lastCompressed);
+
+        /**
+         * loop related values
+         */
+        for (const auto& itItlg : _loopCalls) {
+            printLoopCalls(out, itItlg.first, 0, itItlg.first, lastCompressed);
+        }
+
+        out << "\n"
+                "}\n";
+    }
 
     /**
-     * contributions from equations NOT belonging to loops
-     * (must come before the loop related values because of the assignments)
+     * Prints the function declaration and the local variables.
+     *
+     * @param randomPatternIndentation the indentation used for the random
+     *                                 index pattern declarations (these
+     *                                 declarations are not printed if the
+     *                                 indentation is empty)
      */
-    langC.setArgumentIn("inLocal");
-    langC.setArgumentOut("outLocal");
-    string argsLocal = langC.generateDefaultFunctionArguments();
+    inline void printFunctionStart(std::ostringstream& out,
+                                   const std::string& functionName,
+                                   const std::string& randomPatternIndentation,
+                                   const std::string& returnType = "void") {
+        LanguageC<Base> langC(_baseTypeName);
+        std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
 
-    bool lastCompressed = false;
-    for (const auto& it : nonLoopElements) {
-        size_t index = it.first;
-        const set<size_t>& elPos = it.second;
-        const std::vector<set<size_t> >& location = matrixInfo.at(index).locations;
-        CPPADCG_ASSERT_UNKNOWN(elPos.size() <= location.size()); // it can be lower because not all elements have to be assigned
-        CPPADCG_ASSERT_UNKNOWN(elPos.size() > 0);
-        bool rowOrdered = matrixInfo.at(index).ordered;
+        LanguageC<Base>::printFunctionDeclaration(out, returnType, functionName, argsDcl2);
+        out << " {\n";
 
-        out << "\n";
-        if (rowOrdered) {
-            out << "   outLocal[0] = &" << resultName << "[" << *location[0].begin() << "];\n";
-        } else if (!lastCompressed) {
-            out << "   outLocal[0] = compressed;\n";
+        /**
+         * static variables
+         */
+        if (!randomPatternIndentation.empty()) {
+            printRandomIndexPatternDeclaration(out, randomPatternIndentation);
+        }
+
+        /**
+         * local variables
+         */
+        out << "   " << _baseTypeName << " const * inLocal[" << _inLocalSize << "];\n"
+                "   " << _baseTypeName << " inLocal1 = 1;\n"
+                "   " << _baseTypeName << " * outLocal[1];\n"
+                "   unsigned long " << _indexIt << ";\n"
+                "   unsigned long " << _keyIndexName << ";\n"
+                "   unsigned long e;\n";
+        if (_maxCompressedSize > 0) {
+            out << "   " << _baseTypeName << " compressed[" << _maxCompressedSize << "];\n";
         }
-        out << "   " << localFunction << "_" << nlRev2Suffix << index << "(" << argsLocal << ");\n";
-        if (!rowOrdered) {
-            for (size_t e : elPos) {
-                out << "   ";
-                for (size_t itl : location[e]) {
-                    out << resultName << "[" << itl << "] += compressed[" << e << "];\n";
+        out << "   " << _baseTypeName << " * " << _resultName << " = out[0];\n"
+                "\n"
+                "   inLocal[0] = in[0];\n"
+                "   inLocal[1] = &inLocal1;\n";
+        for (size_t j = 2; j < _inLocalSize; j++)
+            out << "   inLocal[" << j << "] = in[" << (j - 1) << "];\n";
+
+        out << "\n";
+    }
+
+    inline void printRandomIndexPatternDeclaration(std::ostringstream& out,
+                                                   const std::string& indentation) const {
+        LanguageC<Base>::printRandomIndexPatternDeclaration(out, indentation, _indexRandomPatterns);
+    }
+
+    inline void printZeroResult(std::ostringstream& out) const {
+        out << "   for(e = 0; e < " << _nnz << "; e++) " << _resultName << "[e] = 0;\n"
+                "\n";
+    }
+
+    /**
+     * Prints the calls to the functions of equations which do not belong
+     * to loops.
+     *
+     * @param begin the position of the first call
+     * @param end the position after the last call
+     * @param lastCompressed whether or not the output of the last printed
+     *                       call was the compressed array
+     */
+    inline void printNonLoopCalls(std::ostringstream& out,
+                                  size_t begin,
+                                  size_t end,
+                                  bool& lastCompressed) const {
+        using namespace std;
+
+        for (size_t c = begin; c < end; ++c) {
+            size_t index = _nonLoopCalls[c].first;
+            const set<size_t>& elPos = *_nonLoopCalls[c].second;
+            const std::vector<set<size_t> >& location = _matrixInfo.at(index).locations;
+            CPPADCG_ASSERT_UNKNOWN(elPos.size() <= location.size()); // it can be lower because not all elements have to be assigned
+            CPPADCG_ASSERT_UNKNOWN(elPos.size() > 0);
+            bool rowOrdered = _matrixInfo.at(index).ordered;
+
+            out << "\n";
+            if (rowOrdered) {
+                out << "   outLocal[0] = &" << _resultName << "[" << *location[0].begin() << "];\n";
+            } else if (!lastCompressed) {
+                out << "   outLocal[0] = compressed;\n";
+            }
+            out << "   " << _localFunction << "_" << _nlSuffix << index << "(" << _argsLocal << ");\n";
+            if (!rowOrdered) {
+                for (size_t e : elPos) {
+                    out << "   ";
+                    for (size_t itl : location[e]) {
+                        out << _resultName << "[" << itl << "] += compressed[" << e << "];\n";
+                    }
                 }
             }
+            lastCompressed = !rowOrdered;
         }
-        lastCompressed = !rowOrdered;
     }
 
     /**
-     * loop related values
+     * Prints the calls to the functions of loops with a given number of
+     * iterations.
+     *
+     * @param itCount the number of iterations
+     * @param itBegin the first iteration
+     * @param itEnd the iteration after the last iteration
+     * @param lastCompressed whether or not the output of the last printed
+     *                       call was the compressed array
      */
-    for (const auto& itItlg : loopCalls) {
-        size_t itCount = itItlg.first;
+    inline void printLoopCalls(std::ostringstream& out,
+                               size_t itCount,
+                               size_t itBegin,
+                               size_t itEnd,
+                               bool& lastCompressed) const {
+        using namespace std;
+
+        CPPADCG_ASSERT_UNKNOWN(itBegin < itEnd && itEnd <= itCount);
+
+        const auto& itlgs = _loopCalls.at(itCount);
+
         if (itCount > 1) {
             lastCompressed = false;
-            out << "   for(" << indexIt << " = 0; " << indexIt << " < " << itCount << "; " << indexIt << "++) {\n";
+            out << "   for(" << _indexIt << " = " << itBegin << "; " << _indexIt << " < " << itEnd << "; " << _indexIt << "++) {\n";
         }
 
-        for (const auto& itlg : itItlg.second) {
+        for (const auto& itlg : itlgs) {
             LoopModel<Base>& loop = *itlg.first;
 
             for (const auto& itg : itlg.second) {
                 size_t g = itg.first;
                 ArrayGroup* group = itg.second;
 
-                const map<size_t, set<size_t> >& key2Compressed = loopGroups.at(&loop).at(g);
+                const map<size_t, set<size_t> >& key2Compressed = _loopGroups.at(&loop).at(g);
 
                 string indent = itCount == 1 ? "   " : "      "; //indentation
 
                 if (group->startLocPattern.get() != nullptr) {
                     // determine hessRowStart = f(it)
-                    out << indent << "outLocal[0] = &" << resultName << "[" << LanguageC<Base>::indexPattern2String(*group->startLocPattern, indexIt) << "];\n";
+                    out << indent << "outLocal[0] = &" << _resultName << "[" << LanguageC<Base>::indexPattern2String(*group->startLocPattern, _indexIt) << "];\n";
                 } else {
                     if (!lastCompressed) {
                         out << indent << "outLocal[0] = compressed;\n";
                     }
-                    out << indent << "for(e = 0; e < " << maxCompressedSize << "; e++)  compressed[e] = 0;\n";
+                    out << indent << "for(e = 0; e < " << _maxCompressedSize << "; e++)  compressed[e] = 0;\n";
                 }
 
                 if (itCount > 1) {
-                    out << indent << keyIndexName << " = " << LanguageC<Base>::indexPattern2String(*group->pattern, indexIt) << ";\n";
+                    out << indent << _keyIndexName << " = " << LanguageC<Base>::indexPattern2String(*group->pattern, _indexIt) << ";\n";
                     out << indent;
-                    (*generateLocalFunctionName)(out, modelName, loop, g);
-                    out << "(" << keyIndexName << ", " << loopFArgs << ");\n";
+                    (*_generateLocalFunctionName)(out, _modelName, loop, g);
+                    out << "(" << _keyIndexName << ", " << _loopFArgs << ");\n";
                 } else {
                     size_t key = key2Compressed.begin()->first; // only one jrow
                     out << indent;
-                    (*generateLocalFunctionName)(out, modelName, loop, g);
-                    out << "(" << key << ", " << loopFArgs << ");\n";
+                    (*_generateLocalFunctionName)(out, _modelName, loop, g);
+                    out << "(" << key << ", " << _loopFArgs << ");\n";
                 }
 
                 if (group->startLocPattern.get() == nullptr) {
@@ -1107,7 +1252,7 @@ void printForRevUsageFunction(std::ostringstream& out,
 
                                 size_t maxKey = key2Compressed.rbegin()->first;
                                 std::vector<size_t> info = createIndexConditionExpression(eg->keys, usedIter, maxKey);
-                                LanguageC<Base>::printIndexCondExpr(out, info, keyIndexName);
+                                LanguageC<Base>::printIndexCondExpr(out, info, _keyIndexName);
                                 out << ") ";
 
                                 usedIter.insert(eg->keys.begin(), eg->keys.end());
@@ -1119,10 +1264,10 @@ void printForRevUsageFunction(std::ostringstream& out,
                         for (size_t e = 0; e < eg->elements.size(); e++) {
                             const ArrayElementCopyPattern& ePos = eg->elements[e];
 
-                            out << indent2 << resultName << "["
-                                    << LanguageC<Base>::indexPattern2String(*ePos.resultPattern, indexIt)
+                            out << indent2 << _resultName << "["
+                                    << LanguageC<Base>::indexPattern2String(*ePos.resultPattern, _indexIt)
                                     << "] += compressed["
-                                    << LanguageC<Base>::indexPattern2String(*ePos.compressedPattern, indexIt)
+                                    << LanguageC<Base>::indexPattern2String(*ePos.compressedPattern, _indexIt)
                                     << "];\n";
                         }
                     }
@@ -1142,9 +1287,38 @@ void printForRevUsageFunction(std::ostringstream& out,
             out << "   }\n";
         }
     }
+};
 
-    out << "\n"
-            "}\n";
+/**
+ * @param loopGroups Used elements from the arrays provided by the group
+ *                   function calls (loop->group->{array->{compressed position} })
+ * @param nonLoopElements Used elements from non loop function calls
+ *                        ([array]{compressed position})
+ */
+template<class Base>
+void printForRevUsageFunction(std::ostringstream& out,
+                              const std::string& baseTypeName,
+                              const std::string& modelName,
+                              const std::string& modelFunction,
+                              size_t inLocalSize,
+                              const std::string& localFunction,
+                              const std::string& suffix,
+                              const std::string& keyIndexName,
+                              const std::string& indexIt,
+                              const std::string& resultName,
+                              const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& loopGroups,
+                              const std::map<size_t, std::set<size_t> >& nonLoopElements,
+                              const std::map<size_t, CompressedVectorInfo>& matrixInfo,
+                              void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
+                              size_t nnz,
+                              size_t maxCompressedSize) {
+    ForRevUsagePrinter<Base> printer(baseTypeName, modelName, inLocalSize,
+                                     localFunction, suffix,
+                                     keyIndexName, indexIt, resultName,
+                                     loopGroups, nonLoopElements, matrixInfo,
+                                     generateLocalFunctionName,
+                                     nnz, maxCompressedSize);
+    printer.printFunction(out, modelFunction);
 }
 
 /**
@@ -1277,6 +1451,204 @@ void generateFunctionDeclarationSourceLoopForRev(std::ostringstream& out,
 
 } // END loops namespace
 
+template<class Base>
+void ModelCSourceGen<Base>::printForRevUsageFunctionMultiThread(std::ostringstream& out,
+                                                                loops::ForRevUsagePrinter<Base>& printer,
+                                                                const std::string& modelFunction,
+                                                                MultiThreadingType multiThreadingType) {
+    using namespace std;
+
+    CPPADCG_ASSERT_UNKNOWN(multiThreadingType != MultiThreadingType::NONE);
+
+    /**
+     * the function calls are grouped into blocks which keep their original
+     * order: the non loop calls (zero iterations) and the calls of loops with
+     * the same number of iterations (each iteration has the same cost)
+     */
+    struct CallBlock {
+        size_t itCount; // zero for the non loop calls
+        size_t units; // the number of calls or iterations
+        size_t weight; // the number of calls per unit
+    };
+
+    std::vector<CallBlock> blocks;
+    if (printer.getNonLoopCallCount() > 0) {
+        blocks.push_back(CallBlock{0, printer.getNonLoopCallCount(), 1});
+    }
+    for (const auto& itItlg : printer.getLoopCalls()) {
+        size_t calls = 0;
+        for (const auto& itlg : itItlg.second) {
+            calls += itlg.second.size();
+        }
+        size_t itCount = itItlg.first;
+        blocks.push_back(CallBlock{itCount, itCount > 1 ? itCount : 1, calls});
+    }
+
+    size_t totalUnits = 0;
+    size_t totalWeight = 0;
+    for (const CallBlock& b : blocks) {
+        totalUnits += b.units;
+        totalWeight += b.units * b.weight;
+    }
+
+    size_t nTasks = std::min(_multiThreadingLoopTasks, totalUnits);
+
+    /**
+     * split the calls into tasks with a similar number of calls
+     * (each task is a contiguous range of calls/iterations)
+     */
+    struct TaskPart {
+        size_t itCount;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<std::vector<TaskPart> > tasks;
+    if (nTasks > 1 && totalWeight > 0) {
+        tasks.resize(nTasks);
+        size_t done = 0;
+        for (const CallBlock& b : blocks) {
+            for (size_t u = 0; u < b.units; ++u) {
+                size_t t = std::min(done * nTasks / totalWeight, nTasks - 1);
+                std::vector<TaskPart>& parts = tasks[t];
+                if (!parts.empty() && parts.back().itCount == b.itCount && parts.back().end == u) {
+                    parts.back().end++;
+                } else {
+                    parts.push_back(TaskPart{b.itCount, u, u + 1});
+                }
+                done += b.weight;
+            }
+        }
+
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+                                   [](const std::vector<TaskPart>& parts) { return parts.empty(); }),
+                    tasks.end());
+    }
+
+    if (tasks.size() <= 1) {
+        // nothing to split
+        printer.printFunction(out, modelFunction);
+        return;
+    }
+
+    nTasks = tasks.size();
+    size_t nnz = printer.getResultSize();
+
+    /**
+     * the tasks
+     */
+    printer.printRandomIndexPatternDeclaration(out, "");
+    out << "\n";
+
+    std::vector<std::string> taskNames(nTasks);
+    for (size_t t = 0; t < nTasks; ++t) {
+        taskNames[t] = modelFunction + "_task" + std::to_string(t);
+
+        printer.printFunctionStart(out, taskNames[t], "", "static void");
+
+        bool lastCompressed = false;
+        for (const TaskPart& part : tasks[t]) {
+            if (part.itCount == 0) {
+                printer.printNonLoopCalls(out, part.begin, part.end, lastCompressed);
+            } else {
+                printer.printLoopCalls(out, part.itCount, part.begin, part.end, lastCompressed);
+            }
+        }
+
+        out << "\n"
+                "}\n"
+                "\n";
+    }
+
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    langC.setArgumentOut("outLocal");
+    std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    out << "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
+
+    /**
+     * PThreads pool needs a function with a void pointer argument
+     */
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        out << "\n";
+        printFileStartOpenMP(out);
+        out << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+
+        printFileStartPThreads(out, _baseTypeName);
+    }
+
+    /**
+     * the function which executes the tasks and sums their contributions
+     */
+    out << "\n"
+            "void " << modelFunction << "(" << argsDcl << ") {\n"
+            "   static const cppadcg_function_type p[" << nTasks << "] = {";
+    for (size_t t = 0; t < nTasks; ++t) {
+        if (t != 0) out << ", ";
+        out << taskNames[t];
+    }
+    out << "};\n"
+            "   " << _baseTypeName << " * outLocal[1];\n"
+            "   " << _baseTypeName << " * result = out[0];\n"
+            "   " << _baseTypeName << " * tasksOut;\n"
+            "   long i;\n"
+            "   unsigned long e;\n"
+            "\n"
+            "   tasksOut = (" << _baseTypeName << "*) calloc(" << (nTasks * nnz) << ", sizeof(" << _baseTypeName << "));\n"
+            "   if(tasksOut == NULL) {\n"
+            "      // not enough memory for the results of each task: evaluate the tasks sequentially\n"
+            "      for(e = 0; e < " << nnz << "; e++) result[e] = 0;\n"
+            "      outLocal[0] = result;\n"
+            "      for(i = 0; i < " << nTasks << "; ++i) {\n"
+            "         (*p[i])(" << argsLocal << ");\n"
+            "      }\n"
+            "      return;\n"
+            "   }\n"
+            "\n";
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        printFunctionStartOpenMP(out, nTasks);
+        out << "\n";
+        printLoopStartOpenMP(out, nTasks);
+        out << "      outLocal[0] = &tasksOut[i * " << nnz << "];\n"
+                "      (*p[i])(" << argsLocal << ");\n";
+        printLoopEndOpenMP(out, nTasks);
+        out << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+
+        printFunctionStartPThreads(out, nTasks);
+        out << "\n"
+                "   for(i = 0; i < " << nTasks << "; ++i) {\n"
+                "      args[i].func = p[i];\n"
+                "      args[i].in = " << langC.getArgumentIn() << ";\n"
+                "      args[i].out[0] = &tasksOut[i * " << nnz << "];\n"
+                "      args[i].atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                "      job_args[i] = &args[i];\n"
+                "      elapsed[i] = 0;\n"
+                "   }\n"
+                "\n";
+        printFunctionEndPThreads(out, nTasks);
+        out << "\n";
+    }
+
+    /**
+     * sum the contributions of all tasks (always in the same order)
+     */
+    out << "   for(e = 0; e < " << nnz << "; e++) result[e] = tasksOut[e];\n"
+            "   for(i = 1; i < " << nTasks << "; ++i) {\n"
+            "      for(e = 0; e < " << nnz << "; e++) result[e] += tasksOut[i * " << nnz << " + e];\n"
+            "   }\n"
+            "\n"
+            "   free(tasksOut);\n"
+            "}\n";
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -32,6 +32,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
     
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
     handler.setZeroDependents(false);
 
     auto& indexJcolDcl = *handler.makeIndexDclrNode("jcol");
@@ -347,6 +348,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJcolDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setTemporariesInWorkspace(_temporariesInWorkspace);
 
             _cache.str("");
             std::ostringstream code;
@@ -360,6 +362,8 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             _cache << "model (forward one, loop " << lModel.getLoopId() << ", group " << g << ")";
             string jobName = _cache.str();
             handler.generateCode(code, langC, pxCustom, nameGenHess, _atomicFunctions, jobName);
+            _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+            addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 
             _cache.str("");
             generateFunctionNameLoopFor1(_cache, lModel, g);
@@ -388,7 +392,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             nameGenHess.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            _sink->addSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -405,16 +409,16 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
      * 
      */
     string functionFor1 = _name + "_" + FUNCTION_SPARSE_FORWARD_ONE;
-    _sources[functionFor1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
-                                                                                _loopFor1Groups, _nonLoopFor1Elements,
-                                                                                functionFor1, _name, _baseTypeName, "indep",
-                                                                                generateFunctionNameLoopFor1);
+    _sink->addSource(functionFor1 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
+                                                                                      _loopFor1Groups, _nonLoopFor1Elements,
+                                                                                      functionFor1, _name, _baseTypeName, "indep",
+                                                                                      generateFunctionNameLoopFor1));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -429,8 +433,9 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
     const std::string jobName = _cache.str();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_noloop_indep" << j;
     langC.setGenerateFunction(_cache.str());
@@ -440,6 +445,8 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
     handler.generateCode(code, langC, jacCol, nameGenHess, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 
     handler.resetNodes();
 }
@@ -20,7 +20,8 @@ namespace cg {
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseHessianWithLoopsSourceFromRev2(const std::map<size_t, CompressedVectorInfo>& hessInfo,
-                                                                         size_t maxCompressedSize) {
+                                                                         size_t maxCompressedSize,
+                                                                         MultiThreadingType multiThreadingType) {
     using namespace std;
     using namespace CppAD::cg::loops;
 
@@ -45,19 +46,24 @@ void ModelCSourceGen<Base>::generateSparseHessianWithLoopsSourceFromRev2(const s
 
     _cache << "\n";
 
-    printForRevUsageFunction(_cache, _baseTypeName, _name,
-                             model_function, 3,
-                             functionRev2, suffix,
-                             "jrow", "it", "hess",
-                             _loopRev2Groups,
-                             _nonLoopRev2Elements,
-                             hessInfo,
-                             generateFunctionNameLoopRev2,
-                             _hessSparsity.rows.size(), maxCompressedSize);
+    ForRevUsagePrinter<Base> printer(_baseTypeName, _name, 3,
+                                     functionRev2, suffix,
+                                     "jrow", "it", "hess",
+                                     _loopRev2Groups,
+                                     _nonLoopRev2Elements,
+                                     hessInfo,
+                                     generateFunctionNameLoopRev2,
+                                     _hessSparsity.rows.size(), maxCompressedSize);
+
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        printer.printFunction(_cache, model_function);
+    } else {
+        printForRevUsageFunctionMultiThread(_cache, printer, model_function, multiThreadingType);
+    }
 
     finishedJob();
 
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -26,7 +26,8 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
                                                                             const std::string& keyName,
                                                                             const std::map<size_t, std::set<size_t> >& nonLoopElements,
                                                                             const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& loopGroups,
-                                                                            void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g)) {
+                                                                            void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
+                                                                            MultiThreadingType multiThreadingType) {
     using namespace std;
     using namespace CppAD::cg::loops;
 
@@ -50,19 +51,24 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
     generateFunctionDeclarationSourceLoopForRev(_cache, langC, _name, keyName, loopGroups, generateLocalFunctionName);
 
     _cache << "\n";
-    printForRevUsageFunction(_cache, _baseTypeName, _name,
-            model_function, 2,
-            localFunction, suffix,
-            keyName, "it", "jac",
-            loopGroups,
-            nonLoopElements,
-            jacInfo,
-            generateLocalFunctionName,
-            _jacSparsity.rows.size(), maxCompressedSize);
+    ForRevUsagePrinter<Base> printer(_baseTypeName, _name, 2,
+                                     localFunction, suffix,
+                                     keyName, "it", "jac",
+                                     loopGroups,
+                                     nonLoopElements,
+                                     jacInfo,
+                                     generateLocalFunctionName,
+                                     _jacSparsity.rows.size(), maxCompressedSize);
+
+    if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
+        printer.printFunction(_cache, model_function);
+    } else {
+        printForRevUsageFunctionMultiThread(_cache, printer, model_function, multiThreadingType);
+    }
 
     finishedJob();
 
-    _sources[model_function + ".c"] = _cache.str();
+    _sink->addSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -38,6 +38,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
     handler.setZeroDependents(false);
 
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -282,6 +283,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setTemporariesInWorkspace(_temporariesInWorkspace);
 
             _cache.str("");
             std::ostringstream code;
@@ -295,6 +297,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             _cache << "model (reverse one, loop " << lModel.getLoopId() << ", group " << tapeI << ")";
             string jobName = _cache.str();
             handler.generateCode(code, langC, pxCustom, nameGenHess, _atomicFunctions, jobName);
+            _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+            addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 
             _cache.str("");
             generateFunctionNameLoopRev1(_cache, lModel, tapeI);
@@ -323,7 +327,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             nameGenHess.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            _sink->addSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -340,16 +344,16 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
      * 
      */
     string functionRev1 = _name + "_" + FUNCTION_SPARSE_REVERSE_ONE;
-    _sources[functionRev1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
-                                                                                _loopRev1Groups, _nonLoopRev1Elements,
-                                                                                functionRev1, _name, _baseTypeName, "dep",
-                                                                                generateFunctionNameLoopRev1);
+    _sink->addSource(functionRev1 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
+                                                                                      _loopRev1Groups, _nonLoopRev1Elements,
+                                                                                      functionRev1, _name, _baseTypeName, "dep",
+                                                                                      generateFunctionNameLoopRev1));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -364,8 +368,9 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     const std::string jobName = _cache.str();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setTemporariesInWorkspace(_temporariesInWorkspace);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_noloop_dep" << i;
     langC.setGenerateFunction(_cache.str());
@@ -375,6 +380,8 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dy", n);
 
     handler.generateCode(code, langC, jacRow, nameGenHess, _atomicFunctions, jobName);
+    _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+    addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 
     handler.resetNodes();
 }
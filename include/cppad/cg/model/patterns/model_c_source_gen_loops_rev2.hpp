@@ -68,6 +68,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
     
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setMinimizeLiveVariables(_minimizeLiveVariables);
     handler.setZeroDependents(false);
     
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -383,6 +384,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setTemporariesInWorkspace(_temporariesInWorkspace);
 
             std::ostringstream code;
             std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -395,6 +397,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             _cache << "model (reverse two, loop " << lModel.getLoopId() << ", group " << g << ")";
             string jobName = _cache.str();
             handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, jobName);
+            _maxLiveTemporaries = std::max(_maxLiveTemporaries, handler.getMaxLiveTemporaryVariables());
+            addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
 
             _cache.str("");
             generateFunctionNameLoopRev2(_cache, lModel, g);
@@ -423,7 +427,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             nameGenRev2.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            _sink->addSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -455,6 +459,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             // we can use a new handler to reduce memory usage
             CodeHandler<Base> handlerNL;
             handlerNL.setJobTimer(_jobTimer);
+            handlerNL.setMinimizeLiveVariables(_minimizeLiveVariables);
 
             std::vector<CGBase> tx0(n);
             handlerNL.makeVariables(tx0);
@@ -523,9 +528,10 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 }
 
                 LanguageC<Base> langC(_baseTypeName);
-                langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+                langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, _sink);
                 langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
                 langC.setParameterPrecision(_parameterPrecision);
+                langC.setTemporariesInWorkspace(_temporariesInWorkspace);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -536,6 +542,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
                 handlerNL.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+                _maxLiveTemporaries = std::max(_maxLiveTemporaries, handlerNL.getMaxLiveTemporaryVariables());
+                addWorkspaceSize(_workspaceSize, langC.getWorkspaceSize());
             }
 
             finishedJob();
@@ -547,16 +555,16 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
      * 
      */
     string functionRev2 = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO;
-    _sources[functionRev2 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
-                                                                                _loopRev2Groups, _nonLoopRev2Elements,
-                                                                                functionRev2, _name, _baseTypeName, "indep",
-                                                                                generateFunctionNameLoopRev2);
+    _sink->addSource(functionRev2 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
+                                                                                      _loopRev2Groups, _nonLoopRev2Elements,
+                                                                                      functionRev2, _name, _baseTypeName, "indep",
+                                                                                      generateFunctionNameLoopRev2));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY + ".c"] = _cache.str();
+    _sink->addSource(_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
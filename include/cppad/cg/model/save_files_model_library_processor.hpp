@@ -40,33 +40,20 @@ public:
     }
 
     inline void saveSourcesTo(const std::string& sourcesFolder) {
-
-        auto saveFile = [&](const std::string& filename, const std::string& source){
-            std::ofstream sourceFile;
-            std::string file = system::createPath(sourcesFolder, filename);
-            sourceFile.open(file.c_str());
-            sourceFile << source;
-            sourceFile.close();
-        };
-
-        system::createFolder(sourcesFolder);
+        SourceFileSink sink(sourcesFolder);
 
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
 
         for (const auto& itm : models) {
-            const std::map<std::string, std::string>& sources = this->getSources(*itm.second);
-
-            for (const auto& it : sources) {
-                saveFile(it.first, it.second);
-            }
+            this->streamSources(*itm.second, sink); // files are saved as they are generated
         }
 
         for (const auto& it : this->modelLibraryHelper_->getLibrarySources()) {
-            saveFile(it.first, it.second);
+            sink.addSource(it.first, it.second);
         }
 
         for (const auto& it : this->modelLibraryHelper_->getCustomSources()) {
-            saveFile(it.first, it.second);
+            sink.addSource(it.first, it.second);
         }
     }
 
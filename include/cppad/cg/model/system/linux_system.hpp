@@ -18,6 +18,7 @@
 
 #if CPPAD_CG_SYSTEM_LINUX
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
@@ -70,9 +71,22 @@ public:
 
     inline void create() {
         int fd[2]; /** file descriptors used to communicate between processes*/
+        /**
+         * the file descriptors are closed on exec so that they do not leak
+         * into processes forked at the same time by other threads
+         * (which would prevent the end of file from being detected)
+         */
+#ifndef CPPAD_CG_SYSTEM_APPLE
+        if (pipe2(fd, O_CLOEXEC) < 0) {
+            throw CGException("Failed to create pipe");
+        }
+#else
         if (pipe(fd) < 0) {
             throw CGException("Failed to create pipe");
         }
+        fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+#endif
         read.fd = fd[0];
         read.closed = false;
         write.fd = fd[1];
@@ -195,6 +209,25 @@ inline bool isFile(const std::string& path) {
     return false;
 }
 
+inline void copyFile(const std::string& source,
+                     const std::string& destination) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in) {
+        throw CGException("Failed to open file '", source, "'");
+    }
+
+    std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw CGException("Failed to create file '", destination, "'");
+    }
+
+    out << in.rdbuf();
+    out.close();
+    if (!out) {
+        throw CGException("Failed to copy file '", source, "' to '", destination, "'");
+    }
+}
+
 inline void callExecutable(const std::string& executable,
                            const std::vector<std::string>& args,
                            std::string* stdOutErrMessage,
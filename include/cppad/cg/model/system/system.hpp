@@ -96,6 +96,16 @@ inline bool isDirectory(const std::string& path);
  */
 inline bool isFile(const std::string& path);
 
+/**
+ * Copies the content of a file (replaces the destination if it exists)
+ *
+ * @param source the path of the file to be copied
+ * @param destination the path of the new file
+ * @throws CGException on failure to copy the file
+ */
+inline void copyFile(const std::string& source,
+                     const std::string& destination);
+
 /**
  * Calls an external executable (system dependent).
  * In the case of an error during execution an exception will be thrown.
@@ -20,7 +20,8 @@ extern "C" {
 
 enum ScheduleStrategy {SCHED_STATIC = 1, // omp_sched_static
                        SCHED_DYNAMIC = 2, // omp_sched_dynamic with chunk size 1
-                       SCHED_GUIDED = 3 // omp_sched_guided
+                       SCHED_GUIDED = 3, // omp_sched_guided
+                       SCHED_WORK_STEALING = 4 // omp_sched_dynamic with chunk size 1 (not available in OpenMP)
                        };
 
 
@@ -34,7 +34,8 @@
 
 enum ScheduleStrategy {SCHED_STATIC = 1,
                        SCHED_DYNAMIC = 2,
-                       SCHED_GUIDED = 3
+                       SCHED_GUIDED = 3,
+                       SCHED_WORK_STEALING = 4
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
@@ -43,7 +44,17 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
 
+typedef struct cppadcg_thpool_schedule {
+    int n_jobs;                          /* number of jobs                        */
+    float* ref_elapsed;                  /* reference elapsed time of each job    */
+    int* order;                          /* the order in which jobs are submitted */
+    int* job2Thread;                     /* the thread of each job (static only)  */
+    unsigned int n_meas;                 /* number of time measurements so far    */
+    int last_elapsed_changed;            /* whether or not ref_elapsed changed    */
+} cppadcg_thpool_schedule;
+
 static ThPool* volatile cppadcg_pool = NULL;
+static pthread_mutex_t cppadcg_pool_mutex = PTHREAD_MUTEX_INITIALIZER; /* pool creation and schedules */
 static int cppadcg_pool_n_threads = 2;
 static int cppadcg_pool_disabled = 0; // false
 static int cppadcg_pool_verbose = 0; // false
@@ -107,6 +118,23 @@ typedef struct WorkGroup {
     struct timespec endTime;             /* final time (verbose only)      */
 } WorkGroup;
 
+/* Range of jobs in a work stealing batch which were not taken yet */
+typedef struct WSDeque {
+    volatile unsigned long long range;   /* (first << 32) | end                    */
+    char padding[56];                    /* avoid false sharing between threads    */
+} WSDeque;
+
+/* Jobs added at once with the work stealing strategy (reused) */
+typedef struct WSBatch {
+    struct WSBatch* next;                /* next batch in the queue or free list   */
+    Job* jobs;                           /* job records                            */
+    int capacity;                        /* allocated size of jobs                 */
+    WSDeque* deques;                     /* the jobs initially given to each thread */
+    int n_deques;                        /* number of deques (threads)             */
+    int n_active;                        /* threads currently using this batch     */
+    int queued;                          /* whether or not it is still in the queue */
+} WSBatch;
+
 /* Job queue */
 typedef struct JobQueue {
     pthread_mutex_t rwmutex;             /* used for queue r/w access */
@@ -117,6 +145,8 @@ typedef struct JobQueue {
     int   len;                           /* number of jobs in queue   */
     float total_time;                    /* total expected time to complete the work */
     float highest_expected_return;       /* the time when the last running thread is expected to request new work */
+    WSBatch* ws_front;                   /* batches with jobs not taken yet (SCHED_WORK_STEALING only) */
+    WSBatch* ws_free;                    /* batches which can be reused (SCHED_WORK_STEALING only) */
 } JobQueue;
 
 
@@ -233,7 +263,11 @@ int cppadcg_thpool_is_verbose() {
 
 void cppadcg_thpool_prepare() {
     if(cppadcg_pool == NULL) {
-        cppadcg_pool = thpool_init(cppadcg_pool_n_threads);
+        pthread_mutex_lock(&cppadcg_pool_mutex);
+        if(cppadcg_pool == NULL) {
+            cppadcg_pool = thpool_init(cppadcg_pool_n_threads);
+        }
+        pthread_mutex_unlock(&cppadcg_pool_mutex);
     }
 }
 
@@ -353,6 +387,63 @@ void cppadcg_thpool_update_order(float refElapsed[],
 
 }
 
+/**
+ * Copies the current scheduling information so that it can be used by a
+ * single call to cppadcg_thpool_add_jobs().
+ *
+ * @return whether or not the elapsed time of the jobs should be measured
+ */
+int cppadcg_thpool_schedule_load(cppadcg_thpool_schedule* schedule,
+                                 float refElapsed[],
+                                 int order[],
+                                 int job2Thread[],
+                                 int* lastElapsedChanged) {
+    int i;
+    int doBenchmark;
+
+    pthread_mutex_lock(&cppadcg_pool_mutex);
+
+    for (i = 0; i < schedule->n_jobs; ++i) {
+        refElapsed[i] = schedule->ref_elapsed[i];
+        order[i] = schedule->order[i];
+        job2Thread[i] = schedule->job2Thread[i];
+    }
+    *lastElapsedChanged = schedule->last_elapsed_changed;
+    doBenchmark = schedule->n_jobs > 0 && schedule->n_meas < cppadcg_pool_time_meas && !cppadcg_pool_disabled;
+
+    pthread_mutex_unlock(&cppadcg_pool_mutex);
+
+    return doBenchmark;
+}
+
+/**
+ * Updates the scheduling information after the jobs have been completed.
+ *
+ * @param elapsed the measured elapsed time of each job or NULL if no
+ *                measurements were performed
+ * @param job2Thread the thread assigned to each job
+ */
+void cppadcg_thpool_schedule_store(cppadcg_thpool_schedule* schedule,
+                                   const float elapsed[],
+                                   const int job2Thread[]) {
+    int i;
+
+    pthread_mutex_lock(&cppadcg_pool_mutex);
+
+    for (i = 0; i < schedule->n_jobs; ++i) {
+        schedule->job2Thread[i] = job2Thread[i];
+    }
+
+    if (elapsed != NULL) {
+        cppadcg_thpool_update_order(schedule->ref_elapsed, schedule->n_meas, elapsed, schedule->order, schedule->n_jobs);
+        schedule->n_meas++;
+    } else {
+        schedule->last_elapsed_changed = 0;
+    }
+
+    pthread_mutex_unlock(&cppadcg_pool_mutex);
+}
+
 void cppadcg_thpool_shutdown() {
     if(cppadcg_pool != NULL) {
         thpool_destroy(cppadcg_pool);
@@ -384,8 +475,19 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
                                      int nJobs,
                                      int lastElapsedChanged);
 static WorkGroup* jobqueue_pull(ThPool* thpool, int id);
+static int jobqueue_push_ws_jobs(ThPool* thpool,
+                                 thpool_function_type functions[],
+                                 void* args[],
+                                 const float avgElapsed[],
+                                 float elapsed[],
+                                 const int order[],
+                                 int nJobs);
+static int jobqueue_process_ws(ThPool* thpool,
+                               Thread* thread);
 static void  jobqueue_destroy(ThPool* thpool);
 
+static void job_execute(Job* job);
+
 static void  bsem_init(BSem *bsem, int value);
 static void  bsem_reset(BSem *bsem);
 static void  bsem_post(BSem *bsem);
@@ -581,6 +683,10 @@ static int thpool_add_jobs(ThPool* thpool,
     int i;
     int j;
 
+    if (schedule_strategy == SCHED_WORK_STEALING) {
+        return jobqueue_push_ws_jobs(thpool, functions, args, avgElapsed, elapsed, order, nJobs);
+    }
+
     for (i = 0; i < nJobs; ++i) {
         newjobs[i] = (Job*) malloc(sizeof(Job));
         if (newjobs[i] == NULL) {
@@ -793,7 +899,7 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
  */
 static void thpool_wait(ThPool* thpool) {
     pthread_mutex_lock(&thpool->thcount_lock);
-    while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
+    while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->jobqueue->ws_front || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
         pthread_cond_wait(&thpool->threads_all_idle, &thpool->thcount_lock);
     }
     thpool->jobqueue->total_time = 0;
@@ -960,14 +1066,8 @@ static int thread_init(ThPool* thpool,
 * @return nothing
 */
 static void* thread_do(Thread* thread) {
-    float elapsed;
-    int info;
-    struct timespec cputime;
     JobQueue* queue;
     WorkGroup* workGroup;
-    Job* job;
-    thpool_function_type func_buff;
-    void* arg_buff;
     int i;
 
     /* Set thread name for profiling and debugging */
@@ -1006,6 +1106,10 @@ static void* thread_do(Thread* thread) {
         pthread_mutex_unlock(&thpool->thcount_lock);
 
         while (thpool->threads_keepalive) {
+            /* Jobs added with the work stealing strategy */
+            if (jobqueue_process_ws(thpool, thread))
+                continue;
+
             /* Read job from queue and execute it */
             pthread_mutex_lock(&queue->rwmutex);
             workGroup = jobqueue_pull(thpool, thread->id);
@@ -1019,32 +1123,7 @@ static void* thread_do(Thread* thread) {
             }
 
             for (i = 0; i < workGroup->size; ++i) {
-                job = &workGroup->jobs[i];
-
-                if (cppadcg_pool_verbose) {
-                    get_monotonic_time2(&job->startTime);
-                }
-
-                int do_benchmark = job->elapsed != NULL;
-                if (do_benchmark) {
-                    elapsed = -get_thread_time(&cputime, &info);
-                }
-
-                /* Execute the job */
-                func_buff = job->function;
-                arg_buff = job->arg;
-                func_buff(arg_buff);
-
-                if (do_benchmark && info == 0) {
-                    elapsed += get_thread_time(&cputime, &info);
-                    if (info == 0) {
-                        (*job->elapsed) = elapsed;
-                    }
-                }
-
-                if (cppadcg_pool_verbose) {
-                    get_monotonic_time2(&job->endTime);
-                }
+                job_execute(&workGroup->jobs[i]);
             }
 
             if (cppadcg_pool_verbose) {
@@ -1065,7 +1144,7 @@ static void* thread_do(Thread* thread) {
         pthread_mutex_lock(&thpool->thcount_lock);
         thpool->num_threads_working--;
         if (!thpool->num_threads_working) {
-            pthread_cond_signal(&thpool->threads_all_idle);
+            pthread_cond_broadcast(&thpool->threads_all_idle); // there might be several threads waiting
         }
         pthread_mutex_unlock(&thpool->thcount_lock);
     }
@@ -1078,6 +1157,36 @@ static void* thread_do(Thread* thread) {
 }
 
 
+/* Executes a single job (and measures its duration if requested) */
+static void job_execute(Job* job) {
+    float elapsed;
+    int info;
+    struct timespec cputime;
+
+    if (cppadcg_pool_verbose) {
+        get_monotonic_time2(&job->startTime);
+    }
+
+    int do_benchmark = job->elapsed != NULL;
+    if (do_benchmark) {
+        elapsed = -get_thread_time(&cputime, &info);
+    }
+
+    /* Execute the job */
+    (*job->function)(job->arg);
+
+    if (do_benchmark && info == 0) {
+        elapsed += get_thread_time(&cputime, &info);
+        if (info == 0) {
+            (*job->elapsed) = elapsed;
+        }
+    }
+
+    if (cppadcg_pool_verbose) {
+        get_monotonic_time2(&job->endTime);
+    }
+}
+
 /* Frees a thread  */
 static void thread_destroy(Thread* thread) {
     free(thread);
@@ -1101,6 +1210,8 @@ static int jobqueue_init(ThPool* thpool) {
     queue->group_front = NULL;
     queue->total_time = 0;
     queue->highest_expected_return = 0;
+    queue->ws_front = NULL;
+    queue->ws_free = NULL;
 
     queue->has_jobs = (BSem*) malloc(sizeof(BSem));
     if (queue->has_jobs == NULL) {
@@ -1117,6 +1228,7 @@ static int jobqueue_init(ThPool* thpool) {
 /* Clear the queue */
 static void jobqueue_clear(ThPool* thpool) {
     WorkGroup* group;
+    WSBatch* batch;
     int size;
 
     do {
@@ -1130,6 +1242,20 @@ static void jobqueue_clear(ThPool* thpool) {
         }
     } while (size > 0);
 
+    while (thpool->jobqueue->ws_front != NULL) {
+        batch = thpool->jobqueue->ws_front;
+        thpool->jobqueue->ws_front = batch->next;
+        batch->next = thpool->jobqueue->ws_free;
+        thpool->jobqueue->ws_free = batch;
+    }
+    while (thpool->jobqueue->ws_free != NULL) {
+        batch = thpool->jobqueue->ws_free;
+        thpool->jobqueue->ws_free = batch->next;
+        free(batch->jobs);
+        free(batch->deques);
+        free(batch);
+    }
+
     thpool->jobqueue->front = NULL;
     thpool->jobqueue->rear = NULL;
     bsem_reset(thpool->jobqueue->has_jobs);
@@ -1358,6 +1484,233 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
 }
 
 
+/* ======================= WORK STEALING QUEUE ======================= */
+
+#define WS_RANGE(first, end) ((((unsigned long long) (first)) << 32u) | ((unsigned long long) (end)))
+#define WS_FIRST(range) ((int) ((range) >> 32u))
+#define WS_END(range) ((int) ((range) & 0xFFFFFFFFull))
+
+/**
+ * Takes the next job from the front of a deque (used by its owner).
+ *
+ * @return the index of the job or -1 if there are no more jobs
+ */
+static int ws_deque_pop(WSDeque* deque) {
+    unsigned long long range = __atomic_load_n(&deque->range, __ATOMIC_ACQUIRE);
+    int first;
+    int end;
+
+    for (;;) {
+        first = WS_FIRST(range);
+        end = WS_END(range);
+        if (first >= end)
+            return -1;
+        if (__atomic_compare_exchange_n(&deque->range, &range, WS_RANGE(first + 1, end), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return first;
+    }
+}
+
+/**
+ * Takes a job from the back of a deque (used by other threads).
+ *
+ * @return the index of the job or -1 if there are no more jobs
+ */
+static int ws_deque_steal(WSDeque* deque) {
+    unsigned long long range = __atomic_load_n(&deque->range, __ATOMIC_ACQUIRE);
+    int first;
+    int end;
+
+    for (;;) {
+        first = WS_FIRST(range);
+        end = WS_END(range);
+        if (first >= end)
+            return -1;
+        if (__atomic_compare_exchange_n(&deque->range, &range, WS_RANGE(first, end - 1), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return end - 1;
+    }
+}
+
+/**
+ * Adds jobs which will be split among all threads. Each thread executes
+ * the jobs initially given to it and then steals jobs from the other
+ * threads. The job records are reused between calls and the jobs are only
+ * taken with atomic operations.
+ */
+static int jobqueue_push_ws_jobs(ThPool* thpool,
+                                 thpool_function_type functions[],
+                                 void* args[],
+                                 const float avgElapsed[],
+                                 float elapsed[],
+                                 const int order[],
+                                 int nJobs) {
+    JobQueue* queue = thpool->jobqueue;
+    WSBatch* batch;
+    WSBatch* last;
+    Job* job;
+    int n_deques = thpool->num_threads;
+    int i, j, d;
+    int start;
+
+    if (nJobs == 0)
+        return 0;
+
+    /* reuse a previous batch */
+    pthread_mutex_lock(&queue->rwmutex);
+    batch = queue->ws_free;
+    if (batch != NULL) {
+        queue->ws_free = batch->next;
+    }
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    if (batch == NULL) {
+        batch = (WSBatch*) malloc(sizeof(WSBatch));
+        if (batch == NULL) {
+            fprintf(stderr, "jobqueue_push_ws_jobs(): Could not allocate memory\n");
+            return -1;
+        }
+        batch->jobs = NULL;
+        batch->capacity = 0;
+        batch->n_deques = n_deques;
+        batch->deques = (WSDeque*) malloc(n_deques * sizeof(WSDeque));
+        if (batch->deques == NULL) {
+            fprintf(stderr, "jobqueue_push_ws_jobs(): Could not allocate memory\n");
+            free(batch);
+            return -1;
+        }
+    }
+
+    if (batch->capacity < nJobs) {
+        job = (Job*) realloc(batch->jobs, nJobs * sizeof(Job));
+        if (job == NULL) {
+            fprintf(stderr, "jobqueue_push_ws_jobs(): Could not allocate memory for new jobs\n");
+            pthread_mutex_lock(&queue->rwmutex);
+            batch->next = queue->ws_free;
+            queue->ws_free = batch;
+            pthread_mutex_unlock(&queue->rwmutex);
+            return -1;
+        }
+        batch->jobs = job;
+        batch->capacity = nJobs;
+    }
+
+    /**
+     * the jobs (sorted by the expected duration) are dealt to the threads
+     * so that each thread starts with a similar amount of work
+     */
+    start = 0;
+    for (d = 0; d < n_deques; ++d) {
+        int size = nJobs / n_deques + (d < nJobs % n_deques ? 1 : 0);
+        batch->deques[d].range = WS_RANGE(start, start + size);
+        start += size;
+    }
+
+    for (i = 0; i < nJobs; ++i) {
+        d = i % n_deques;
+        job = &batch->jobs[WS_FIRST(batch->deques[d].range) + i / n_deques];
+
+        j = order != NULL ? order[i] : i;
+        job->prev = NULL;
+        job->function = functions[j];
+        job->arg = args[j];
+        job->id = i;
+        job->avgElapsed = avgElapsed != NULL ? &avgElapsed[j] : NULL;
+        job->elapsed = elapsed != NULL ? &elapsed[j] : NULL;
+    }
+
+    batch->n_active = 0;
+    batch->queued = 1;
+    batch->next = NULL;
+
+    /* add to the queue */
+    pthread_mutex_lock(&queue->rwmutex);
+
+    if (queue->ws_front == NULL) {
+        queue->ws_front = batch;
+    } else {
+        last = queue->ws_front;
+        while (last->next != NULL)
+            last = last->next;
+        last->next = batch;
+    }
+
+    bsem_post_all(queue->has_jobs);
+
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    return 0;
+}
+
+/**
+ * Executes jobs from the oldest work stealing batch until there are no
+ * more jobs in it.
+ *
+ * @return 1 if a batch was processed, 0 if there were no batches
+ */
+static int jobqueue_process_ws(ThPool* thpool,
+                               Thread* thread) {
+    JobQueue* queue = thpool->jobqueue;
+    WSBatch* batch;
+    WSBatch** prev;
+    WorkGroup* group;
+    Job* job;
+    int own, d, k;
+
+    pthread_mutex_lock(&queue->rwmutex);
+    batch = queue->ws_front;
+    if (batch == NULL) {
+        pthread_mutex_unlock(&queue->rwmutex);
+        return 0;
+    }
+    batch->n_active++;
+    bsem_post(queue->has_jobs); // wake up other threads to help
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    own = thread->id % batch->n_deques;
+
+    for (;;) {
+        k = ws_deque_pop(&batch->deques[own]);
+        for (d = 1; k < 0 && d < batch->n_deques; ++d) {
+            k = ws_deque_steal(&batch->deques[(own + d) % batch->n_deques]);
+        }
+        if (k < 0)
+            break; // all jobs in this batch were taken
+
+        job = &batch->jobs[k];
+        job_execute(job);
+
+        if (cppadcg_pool_verbose) {
+            group = (WorkGroup*) malloc(sizeof(WorkGroup));
+            group->size = 1;
+            group->jobs = (Job*) malloc(sizeof(Job));
+            group->jobs[0] = *job; // copy
+            group->startTime = job->startTime;
+            group->endTime = job->endTime;
+            group->prev = thread->processed_groups;
+            thread->processed_groups = group;
+        }
+    }
+
+    pthread_mutex_lock(&queue->rwmutex);
+    if (batch->queued) {
+        // no other thread will start using it
+        prev = &queue->ws_front;
+        while (*prev != batch)
+            prev = &(*prev)->next;
+        *prev = batch->next;
+        batch->queued = 0;
+    }
+    batch->n_active--;
+    if (batch->n_active == 0) {
+        // all jobs were completed
+        batch->next = queue->ws_free;
+        queue->ws_free = batch;
+    }
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    return 1;
+}
+
+
 /* Free all queue resources back to the system */
 static void jobqueue_destroy(ThPool* thpool) {
     jobqueue_clear(thpool);
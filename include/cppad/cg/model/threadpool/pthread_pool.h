@@ -21,7 +21,8 @@ extern "C" {
 
 enum ScheduleStrategy {SCHED_STATIC = 1,
                        SCHED_DYNAMIC = 2,
-                       SCHED_GUIDED = 3
+                       SCHED_GUIDED = 3,
+                       SCHED_WORK_STEALING = 4
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
@@ -29,6 +30,22 @@ enum ElapsedTimeReference {ELAPSED_TIME_AVG,
 
 typedef void (*cppadcg_thpool_function_type)(void*);
 
+/**
+ * Scheduling information shared by all the calls to the same function
+ * which adds a fixed set of jobs to the thread pool.
+ * It must only be accessed through cppadcg_thpool_schedule_load() and
+ * cppadcg_thpool_schedule_store() so that the function can be called
+ * simultaneously from several threads.
+ */
+typedef struct cppadcg_thpool_schedule {
+    int n_jobs;                          /* number of jobs                        */
+    float* ref_elapsed;                  /* reference elapsed time of each job    */
+    int* order;                          /* the order in which jobs are submitted */
+    int* job2Thread;                     /* the thread of each job (static only)  */
+    unsigned int n_meas;                 /* number of time measurements so far    */
+    int last_elapsed_changed;            /* whether or not ref_elapsed changed    */
+} cppadcg_thpool_schedule;
+
 
 void cppadcg_thpool_set_threads(int n);
 
@@ -89,6 +106,16 @@ void cppadcg_thpool_update_order(float refElapsed[],
                                  int order[],
                                  int nJobs);
 
+int cppadcg_thpool_schedule_load(cppadcg_thpool_schedule* schedule,
+                                 float refElapsed[],
+                                 int order[],
+                                 int job2Thread[],
+                                 int* lastElapsedChanged);
+
+void cppadcg_thpool_schedule_store(cppadcg_thpool_schedule* schedule,
+                                   const float elapsed[],
+                                   const int job2Thread[]);
+
 void cppadcg_thpool_shutdown();
 
 #ifdef __cplusplus
@@ -34,7 +34,7 @@ private:
 public:
 
     inline OperationNode<Base>& getIndex() const {
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
         CPPADCG_ASSERT_KNOWN(!args.empty(), "Invalid number of arguments");
 
         OperationNode<Base>* aNode = args[0].getOperation();
@@ -54,7 +54,7 @@ public:
     inline std::vector<const OperationNode<Base>*> getIndexPatternIndexes() const {
         std::vector<const OperationNode<Base>*> iargs;
 
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
 
         CPPADCG_ASSERT_KNOWN(args[1].getOperation() != nullptr &&
                              args[1].getOperation()->getOperationType() == CGOpCode::Index, "Invalid argument operation type");
@@ -36,14 +36,14 @@ public:
     }
 
     inline OperationNode<Base>& getIndexCreationNode() const {
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
         CPPADCG_ASSERT_KNOWN(!args.empty(), "Invalid number of arguments");
         CPPADCG_ASSERT_KNOWN(args.back().getOperation() != nullptr, "Invalid argument type");
         return *args.back().getOperation();
     }
 
     inline const OperationNode<Base>& getIndex() const {
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
         CPPADCG_ASSERT_KNOWN(!args.empty(), "Invalid number of arguments");
 
         OperationNode<Base>* aNode = args[0].getOperation();
@@ -53,7 +53,7 @@ public:
     }
 
     inline void makeAssigmentDependent(IndexAssignOperationNode<Base>& indexAssign) {
-        std::vector<Argument<Base> >& args = this->getArguments();
+        ArenaVector<Argument<Base> >& args = this->getArguments();
 
         args.resize(2);
         args[0] = indexAssign.getIndex();
@@ -33,7 +33,7 @@ class LoopEndOperationNode : public OperationNode<Base> {
 public:
 
     inline const LoopStartOperationNode<Base>& getLoopStart() const {
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
         CPPADCG_ASSERT_KNOWN(args.size() > 0, "There must be at least one argument")
 
         OperationNode<Base>* aNode = args[0].getOperation();
@@ -33,7 +33,7 @@ class LoopStartOperationNode : public OperationNode<Base> {
 public:
 
     inline OperationNode<Base>& getIndex() const {
-        const std::vector<Argument<Base> >& args = this->getArguments();
+        const ArenaVector<Argument<Base> >& args = this->getArguments();
         CPPADCG_ASSERT_KNOWN(!args.empty(), "Invalid number of arguments")
 
         OperationNode<Base>* aNode = args[0].getOperation();
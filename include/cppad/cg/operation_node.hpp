@@ -28,10 +28,10 @@ template<class Base>
 class OperationNode {
     friend class CodeHandler<Base>;
 public:
-    using iterator = typename std::vector<Argument<Base> >::iterator;
-    using const_iterator = typename std::vector<Argument<Base> >::const_iterator;
-    using const_reverse_iterator = typename std::vector<Argument<Base> >::const_reverse_iterator;
-    using reverse_iterator = typename std::vector<Argument<Base> >::reverse_iterator;
+    using iterator = typename ArenaVector<Argument<Base> >::iterator;
+    using const_iterator = typename ArenaVector<Argument<Base> >::const_iterator;
+    using const_reverse_iterator = typename ArenaVector<Argument<Base> >::const_reverse_iterator;
+    using reverse_iterator = typename ArenaVector<Argument<Base> >::reverse_iterator;
 public:
     static const std::set<CGOpCode> CUSTOM_NODE_CLASS;
 private:
@@ -44,16 +44,28 @@ private:
      * the operation type represented by this node
      */
     CGOpCode operation_;
+    /**
+     * whether or not the memory of this node was provided by the
+     * memory arena of its CodeHandler (instead of the heap)
+     */
+    bool inArena_;
+    /**
+     * whether or not this node was registered by its CodeHandler as a node
+     * which can be reused for identical operations
+     */
+    bool identical_;
     /**
      * additional information/options associated with the operation type
+     * (placed in the memory arena of the CodeHandler when it is used)
      */
-    std::vector<size_t> info_;
+    ArenaVector<size_t> info_;
     /**
      * arguments required by the operation
      * (empty for independent variables and possibly for the 1st assignment
      *  of a dependent variable)
+     * (placed in the memory arena of the CodeHandler when it is used)
      */
-    std::vector<Argument<Base> > arguments_;
+    ArenaVector<Argument<Base> > arguments_;
     /**
      * index in the CodeHandler managed nodes array
      */
@@ -102,7 +114,7 @@ public:
      * @param arguments the arguments for the new operation
      */
     inline void setOperation(CGOpCode op,
-                             const std::vector<Argument<Base> >& arguments = std::vector<Argument<Base> >()) {
+                             const ArenaVector<Argument<Base> >& arguments = ArenaVector<Argument<Base> >()) {
         CPPADCG_ASSERT_UNKNOWN(op == operation_ || CUSTOM_NODE_CLASS.find(op) == CUSTOM_NODE_CLASS.end()); // cannot transform into a node with a custom class
 
         operation_ = op;
@@ -114,7 +126,7 @@ public:
      * node.
      * @return the arguments for the operation in this node (read-only)
      */
-    inline const std::vector<Argument<Base> >& getArguments() const {
+    inline const ArenaVector<Argument<Base> >& getArguments() const {
         return arguments_;
     }
 
@@ -123,7 +135,7 @@ public:
      * node.
      * @return the arguments for the operation in this node
      */
-    inline std::vector<Argument<Base> >& getArguments() {
+    inline ArenaVector<Argument<Base> >& getArguments() {
         return arguments_;
     }
 
@@ -131,7 +143,7 @@ public:
      * Provides additional information used in the operation.
      * @return the additional operation information/options  (read-only)
      */
-    inline const std::vector<size_t>& getInfo() const {
+    inline const ArenaVector<size_t>& getInfo() const {
         return info_;
     }
 
@@ -139,7 +151,7 @@ public:
      * Provides additional information used in the operation.
      * @return the additional operation information/options
      */
-    inline std::vector<size_t>& getInfo() {
+    inline ArenaVector<size_t>& getInfo() {
         return info_;
     }
 
@@ -239,8 +251,10 @@ protected:
     inline OperationNode(const OperationNode& orig) :
         handler_(orig.handler_),
         operation_(orig.operation_),
-        info_(orig.info_),
-        arguments_(orig.arguments_),
+        inArena_(false),
+        identical_(false),
+        info_(orig.info_.begin(), orig.info_.end()),
+        arguments_(orig.arguments_.begin(), orig.arguments_.end()),
         pos_((std::numeric_limits<size_t>::max)()),
         name_(orig.name_ != nullptr ? new std::string(*orig.name_) : nullptr) {
     }
@@ -249,6 +263,10 @@ protected:
                          CGOpCode op) :
         handler_(handler),
         operation_(op),
+        inArena_(false),
+        identical_(false),
+        info_(makeAllocator<size_t>(handler)),
+        arguments_(makeAllocator<Argument<Base> >(handler)),
         pos_((std::numeric_limits<size_t>::max)()) {
     }
 
@@ -257,7 +275,22 @@ protected:
                          const Argument<Base>& arg) :
         handler_(handler),
         operation_(op),
-        arguments_ {arg},
+        inArena_(false),
+        identical_(false),
+        info_(makeAllocator<size_t>(handler)),
+        arguments_(1, arg, makeAllocator<Argument<Base> >(handler)),
+        pos_((std::numeric_limits<size_t>::max)()) {
+    }
+
+    inline OperationNode(CodeHandler<Base>* handler,
+                         CGOpCode op,
+                         std::initializer_list<Argument<Base> > args) :
+        handler_(handler),
+        operation_(op),
+        inArena_(false),
+        identical_(false),
+        info_(makeAllocator<size_t>(handler)),
+        arguments_(args, makeAllocator<Argument<Base> >(handler)),
         pos_((std::numeric_limits<size_t>::max)()) {
     }
 
@@ -266,7 +299,10 @@ protected:
                          std::vector<Argument<Base> >&& args) :
         handler_(handler),
         operation_(op),
-        arguments_(std::move(args)),
+        inArena_(false),
+        identical_(false),
+        info_(makeAllocator<size_t>(handler)),
+        arguments_(args.begin(), args.end(), makeAllocator<Argument<Base> >(handler)),
         pos_((std::numeric_limits<size_t>::max)()) {
     }
 
@@ -276,19 +312,23 @@ protected:
                          std::vector<Argument<Base> >&& args) :
         handler_(handler),
         operation_(op),
-        info_(std::move(info)),
-        arguments_(std::move(args)),
+        inArena_(false),
+        identical_(false),
+        info_(info.begin(), info.end(), makeAllocator<size_t>(handler)),
+        arguments_(args.begin(), args.end(), makeAllocator<Argument<Base> >(handler)),
         pos_((std::numeric_limits<size_t>::max)()) {
     }
 
     inline OperationNode(CodeHandler<Base>* handler,
                          CGOpCode op,
-                         const std::vector<size_t>& info,
-                         const std::vector<Argument<Base> >& args) :
+                         ArrayView<const size_t> info,
+                         ArrayView<const Argument<Base> > args) :
         handler_(handler),
         operation_(op),
-        info_(info),
-        arguments_(args),
+        inArena_(false),
+        identical_(false),
+        info_(info.begin(), info.end(), makeAllocator<size_t>(handler)),
+        arguments_(args.begin(), args.end(), makeAllocator<Argument<Base> >(handler)),
         pos_((std::numeric_limits<size_t>::max)()) {
     }
 
@@ -304,14 +344,23 @@ public:
      * @warning This node should never be provided to a CodeHandler.
      */
     static std::unique_ptr<OperationNode<Base>> makeTemporaryNode(CGOpCode op,
-                                                                  const std::vector<size_t>& info,
-                                                                  const std::vector<Argument<Base> >& args) {
+                                                                  const ArenaVector<size_t>& info,
+                                                                  const ArenaVector<Argument<Base> >& args) {
         return std::unique_ptr<OperationNode<Base>> (new OperationNode<Base>(nullptr, op, info, args));
     }
 
 protected:
     static inline std::set<CGOpCode> makeCustomNodeClassesSet() noexcept;
 
+    /**
+     * Provides an allocator for the memory arena of a CodeHandler, if it
+     * places new nodes in its arena, or for the heap otherwise.
+     */
+    template<class T>
+    static inline ArenaAllocator<T> makeAllocator(CodeHandler<Base>* handler) {
+        return ArenaAllocator<T>(handler != nullptr ? handler->getNodeArena() : nullptr);
+    }
+
 };
 
 template<class Base>
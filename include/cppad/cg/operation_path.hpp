@@ -148,7 +148,7 @@ inline void CodeHandler<Base>::findPaths(SourceCodePath& currPath,
         return;
     }
 
-    const std::vector<Argument<Base> >& args = currNode->getArguments();
+    const ArenaVector<Argument<Base> >& args = currNode->getArguments();
     if (args.empty())
         return; // nothing to look in
 
@@ -44,6 +44,22 @@ inline bool operator<(const UniqueEquationPair<Base>& p1, const UniqueEquationPa
     return p1.eq1->depRefIndex < p2.eq1->depRefIndex || (!(p2.eq1->depRefIndex < p1.eq1->depRefIndex) && p1.eq2->depRefIndex < p2.eq2->depRefIndex);
 }
 
+template<class Base>
+inline bool operator==(const UniqueEquationPair<Base>& p1, const UniqueEquationPair<Base>& p2) {
+    return p1.eq1 == p2.eq1 && p1.eq2 == p2.eq2;
+}
+
+template<class Base>
+class UniqueEquationPairHash {
+public:
+
+    inline size_t operator()(const UniqueEquationPair<Base>& p) const {
+        size_t h = p.eq1->depRefIndex;
+        h ^= p.eq2->depRefIndex + 0x9e3779b9 + (h << 6u) + (h >> 2u);
+        return h;
+    }
+};
+
 /**
  * Finds common patterns in operation graphs
  */
@@ -59,11 +75,14 @@ private:
         BOTH
     };
     using Indexed2OpCountType = std::pair<INDEXED_OPERATION_TYPE, size_t>;
-    using Dep1Dep2SharedType = std::map<size_t, std::map<size_t, std::map<OperationNode<Base>*, Indexed2OpCountType> > >;
+    using SharedNodesType = std::map<OperationNode<Base>*, Indexed2OpCountType>;
+    using Dep2SharedType = std::unordered_map<size_t, SharedNodesType>;
+    using Dep1Dep2SharedType = std::unordered_map<size_t, Dep2SharedType>;
     using DepPairType = std::pair<size_t, size_t>;
-    using TotalOps2validDepsType = std::map<size_t, std::map<DepPairType, const std::map<OperationNode<Base>*, Indexed2OpCountType>* > >;
+    using TotalOps2validDepsType = std::map<size_t, std::map<DepPairType, const SharedNodesType*> >;
     using Eq2totalOps2validDepsType = std::map<UniqueEquationPair<Base>, TotalOps2validDepsType*>;
     using MaxOps2eq2totalOps2validDepsType = std::map<size_t, Eq2totalOps2validDepsType>;
+    using EquationBlackListType = std::unordered_map<EquationPattern<Base>*, std::unordered_set<EquationPattern<Base>*> >;
 
 private:
     CodeHandler<Base>* handler_;
@@ -75,16 +94,17 @@ private:
     std::vector<EquationPattern<Base>*> equations_;
     EquationPattern<Base>* eqCurr_;
     std::map<size_t, EquationPattern<Base>*> dep2Equation_;
-    std::map<EquationPattern<Base>*, Loop<Base>*> equation2Loop_;
+    std::unordered_map<EquationPattern<Base>*, Loop<Base>*> equation2Loop_;
     std::vector<Loop<Base>*> loops_;
     /**
      * Equations which cannot be in the same loop
      */
-    std::map<EquationPattern<Base>*, std::set<EquationPattern<Base>*> > incompatible_;
+    EquationBlackListType incompatible_;
     /**
-     *
+     * the temporary variables shared by the dependents of two equation
+     * patterns
      */
-    std::map<UniqueEquationPair<Base>, Dep1Dep2SharedType> equationShared_;
+    std::unordered_map<UniqueEquationPair<Base>, Dep1Dep2SharedType, UniqueEquationPairHash<Base> > equationShared_;
     /**
      * maps the original model nodes used as temporary non-indexed variables
      * by the loops to an index k
@@ -97,6 +117,10 @@ private:
      * reproducibility between different runs
      */
     CodeHandlerVector<Base, size_t> origShareNodeId_;
+    /**
+     * the expression signature of each node (zero if not determined yet)
+     */
+    CodeHandlerVector<Base, size_t> signature_;
     /// used to mark visited nodes and indexed nodes
     size_t color_;
 public:
@@ -121,6 +145,7 @@ public:
         independents_(independents),
         idCounter_(0),
         origShareNodeId_(*handler_),
+        signature_(*handler_),
         color_(0) {
         CPPADCG_ASSERT_UNKNOWN(independents_.size() > 0)
         CPPADCG_ASSERT_UNKNOWN(independents_[0].getCodeHandler() != nullptr)
@@ -149,7 +174,7 @@ public:
                                std::set<LoopModel<Base>*>& loopTapes) {
 
         for (size_t j = 0; j < independents_.size(); j++) {
-            std::vector<size_t>& info = independents_[j].getOperationNode()->getInfo();
+            ArenaVector<size_t>& info = independents_[j].getOperationNode()->getInfo();
             info.resize(1);
             info[0] = j;
         }
@@ -315,12 +340,12 @@ private:
                  **************************************************/
                 for (const auto& itDep1Dep2 : dep1Dep2Shared) {
                     size_t dep1 = itDep1Dep2.first;
-                    const map<size_t, map<OperationNode<Base>*, Indexed2OpCountType> >& dep2Shared = itDep1Dep2.second;
+                    const Dep2SharedType& dep2Shared = itDep1Dep2.second;
 
                     // multiple deps2 means multiple choices for a relation (only one dep1<->dep2 can be chosen)
                     for (const auto& itDep2 : dep2Shared) {
                         size_t dep2 = itDep2.first;
-                        const map<OperationNode<Base>*, Indexed2OpCountType>& sharedTmps = itDep2.second;
+                        const SharedNodesType& sharedTmps = itDep2.second;
 
                         size_t totalOps = 0; // the total number of operations performed by shared variables with dep2
                         for (const auto& itShared : sharedTmps) {
@@ -547,7 +572,7 @@ private:
                  * attempt to combine dependents which share the
                  * highest number of operations first
                  **************************************************/
-                typename map<size_t, map<DepPairType, const map<OperationNode<Base>*, Indexed2OpCountType>* > >::const_reverse_iterator itOp2Dep2Shared;
+                typename TotalOps2validDepsType::const_reverse_iterator itOp2Dep2Shared;
                 for (itOp2Dep2Shared = totalOps2validDeps.rbegin(); itOp2Dep2Shared != totalOps2validDeps.rend(); ++itOp2Dep2Shared) {
 #ifdef CPPADCG_PRINT_DEBUG
                     std::cout << "    operation count: " << itOp2Dep2Shared->first << "  relations: " << itOp2Dep2Shared->second.size() << std::endl;
@@ -557,7 +582,7 @@ private:
                         size_t dep1 = depRel.first;
                         size_t dep2 = depRel.second;
 
-                        const map<OperationNode<Base>*, Indexed2OpCountType>& shared = *itDep2Shared.second;
+                        const SharedNodesType& shared = *itDep2Shared.second;
                         /**
                          * this dep1 <-> dep2 is used as a reference to combine
                          * the two equations in the same loop
@@ -647,7 +672,7 @@ private:
                           size_t dep1,
                           EquationPattern<Base>* eq2,
                           size_t dep2,
-                          const std::map<OperationNode<Base>*, Indexed2OpCountType>& sharedNodes,
+                          const SharedNodesType& sharedNodes,
                           std::vector<std::set<size_t>* >& dep2Relations,
                           std::map<size_t, std::set<size_t> >& dependentBlackListRelations,
                           SmartSetPointer<std::set<size_t> >& dependentRelations) {
@@ -791,15 +816,32 @@ private:
         varColor.adjustSize();
         varColor.fill(0);
 
+        signature_.adjustSize();
+        signature_.fill(0);
+
         size_t rSize = relatedDepCandidates_.size();
         for (size_t r = 0; r < rSize; r++) {
             const std::set<size_t>& candidates = relatedDepCandidates_[r];
-            std::set<size_t> used;
+            std::unordered_set<size_t> used;
+
+            /**
+             * only dependents with the same signature can have the same
+             * expression pattern (dependents are only compared with the
+             * following candidates with the same signature)
+             */
+            std::vector<size_t> signatures;
+            signatures.reserve(candidates.size());
+            std::unordered_map<size_t, std::vector<size_t> > signature2Deps;
+            for (size_t iDep : candidates) {
+                size_t sig = findSignature(dependents_[iDep]);
+                signatures.push_back(sig);
+                signature2Deps[sig].push_back(iDep); // sorted
+            }
 
             eqCurr_ = nullptr;
 
-            std::set<size_t>::const_iterator itRef;
-            for (itRef = candidates.begin(); itRef != candidates.end(); ++itRef) {
+            size_t k = 0;
+            for (auto itRef = candidates.begin(); itRef != candidates.end(); ++itRef, ++k) {
                 size_t iDepRef = *itRef;
 
                 // check if it has already been used
@@ -812,8 +854,9 @@ private:
                     equations_.push_back(eqCurr_);
                 }
 
-                auto it = itRef;
-                for (++it; it != candidates.end(); ++it) {
+                const std::vector<size_t>& similar = signature2Deps.at(signatures[k]);
+                auto it = std::upper_bound(similar.begin(), similar.end(), iDepRef);
+                for (; it != similar.end(); ++it) {
                     size_t iDep = *it;
                     // check if it has already been used
                     if (used.find(iDep) != used.end()) {
@@ -845,6 +888,73 @@ private:
         return equations_;
     }
 
+    /**
+     * Determines a hash of the expression of a dependent variable which
+     * does not depend on the independent variables it uses.
+     * Dependents with different signatures cannot have the same equation
+     * pattern (see EquationPattern::testAdd()).
+     *
+     * @param dep The dependent variable value
+     * @return the signature
+     */
+    inline size_t findSignature(const CG<Base>& dep) {
+        OperationNode<Base>* node = dep.getOperationNode();
+        if (node == nullptr)
+            return 0x51ed27; // parameter
+
+        return findSignature(*node);
+    }
+
+    /**
+     * Determines a hash of an expression which does not depend on the
+     * independent variables it uses.
+     * Aliases are ignored (except for aliases of independents) and
+     * parameters only contribute with their position since Base might not
+     * be hashable.
+     *
+     * @param node The node to visit
+     * @return the signature (never zero)
+     */
+    inline size_t findSignature(OperationNode<Base>& node) {
+        OperationNode<Base>* n = &node;
+        while (n->getOperationType() == CGOpCode::Alias) {
+            CPPADCG_ASSERT_KNOWN(n->getArguments().size() == 1, "Invalid number of arguments for alias")
+            OperationNode<Base>* a = n->getArguments()[0].getOperation();
+            if (a == nullptr || a->getOperationType() == CGOpCode::Inv) break;  // an alias is used to distinguish between indexed dependents and indexed independents
+            n = a;
+        }
+
+        if (n->getOperationType() == CGOpCode::Inv)
+            return 0x1d3f5b; // any independent
+
+        size_t& sig = signature_[*n];
+        if (sig != 0)
+            return sig;
+
+        auto combine = [](size_t& h, size_t v) {
+            h ^= v + 0x9e3779b9 + (h << 6u) + (h >> 2u);
+        };
+
+        size_t h = size_t(n->getOperationType());
+        for (size_t i : n->getInfo())
+            combine(h, i);
+
+        const ArenaVector<Argument<Base> >& args = n->getArguments();
+        combine(h, args.size());
+        for (const Argument<Base>& a : args) {
+            if (a.getOperation() != nullptr)
+                combine(h, findSignature(*a.getOperation()));
+            else
+                combine(h, 0x51ed27);
+        }
+
+        if (h == 0)
+            h = 1;
+
+        signature_[*n] = h; // the reference might have been invalidated
+        return h;
+    }
+
     /**
      * Finds nodes which can be shared with other equation patterns
      *
@@ -888,7 +998,7 @@ private:
         bool indexedOperation = false;
 
         size_t localOpCount = 1;
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         size_t arg_size = args.size();
         for (size_t a = 0; a < arg_size; a++) {
             OperationNode<Base>*argOp = args[a].getOperation();
@@ -922,14 +1032,14 @@ private:
                     UniqueEquationPair<Base> eqPair(eqCurr_, otherEquation);
                     Dep1Dep2SharedType& relation = equationShared_[eqPair];
 
-                    std::map<OperationNode<Base>*, Indexed2OpCountType>* reldepdep;
+                    SharedNodesType* reldepdep;
                     if (eqPair.eq1 == eqCurr_)
                         reldepdep = &relation[depIndex][otherDep];
                     else
                         reldepdep = &relation[otherDep][depIndex];
 
                     INDEXED_OPERATION_TYPE expected = indexedOperation ? INDEXED_OPERATION_TYPE::INDEXED : INDEXED_OPERATION_TYPE::NONINDEXED;
-                    typename std::map<OperationNode<Base>*, Indexed2OpCountType>::iterator itIndexedType = reldepdep->find(node);
+                    auto itIndexedType = reldepdep->find(node);
                     if (itIndexedType == reldepdep->end()) {
                         (*reldepdep)[node] = Indexed2OpCountType(expected, localOpCount);
                     } else if (itIndexedType->second.first != expected) {
@@ -969,7 +1079,7 @@ private:
             }
         }
 
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         size_t arg_size = args.size();
         for (size_t i = 0; i < arg_size; i++) {
             markOperationsWithDependent(args[i].getOperation(), dep);
@@ -998,7 +1108,7 @@ private:
         origShareNodeId_[*node] = idCounter_;
         idCounter_++;
 
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         size_t arg_size = args.size();
         for (size_t i = 0; i < arg_size; i++) {
             assignIds(args[i].getOperation());
@@ -1023,7 +1133,7 @@ private:
         varId_[*node] = 0;
         origShareNodeId_[*node] = 0;
 
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         size_t arg_size = args.size();
         for (size_t i = 0; i < arg_size; i++) {
             resetHandlerCounters(args[i].getOperation());
@@ -1031,7 +1141,7 @@ private:
     }
 
     static bool find(Loop<Base>* loop1, Loop<Base>* loop2,
-                     const std::map<EquationPattern<Base>*, std::set<EquationPattern<Base>*> >& blackList) {
+                     const EquationBlackListType& blackList) {
         for (EquationPattern<Base>* iteq1 : loop1->equations) {
 
             const auto itBlack = blackList.find(iteq1);
@@ -1048,10 +1158,10 @@ private:
         return false;
     }
 
-    template<class T>
-    static inline bool contains(const std::map<T, std::set<T> >& map, T eq1, T eq2) {
-        typename std::map<T, std::set<T> >::const_iterator itb1;
-        itb1 = map.find(eq1);
+    static inline bool contains(const EquationBlackListType& map,
+                                EquationPattern<Base>* eq1,
+                                EquationPattern<Base>* eq2) {
+        auto itb1 = map.find(eq1);
         if (itb1 != map.end()) {
             if (itb1->second.find(eq2) != itb1->second.end()) {
                 return true;
@@ -157,7 +157,7 @@ public:
 
         varIndexed[*node] = false;
 
-        const std::vector<Argument<Base> >& args = node->getArguments();
+        const ArenaVector<Argument<Base> >& args = node->getArguments();
         size_t size = args.size();
         for (size_t a = 0; a < size; a++) {
             uncolor(args[a].getOperation(), varIndexed);
@@ -309,8 +309,8 @@ private:
 
         CPPADCG_ASSERT_UNKNOWN(scRef->getOperationType() != CGOpCode::Inv)
 
-        const std::vector<size_t>& info1 = scRef->getInfo();
-        const std::vector<size_t>& info2 = sc2->getInfo();
+        const ArenaVector<size_t>& info1 = scRef->getInfo();
+        const ArenaVector<size_t>& info2 = sc2->getInfo();
         if (info1.size() != info2.size()) {
             return false;
         }
@@ -321,8 +321,8 @@ private:
             }
         }
 
-        const std::vector<Argument<Base> >& args1 = scRef->getArguments();
-        const std::vector<Argument<Base> >& args2 = sc2->getArguments();
+        const ArenaVector<Argument<Base> >& args1 = scRef->getArguments();
+        const ArenaVector<Argument<Base> >& args2 = sc2->getArguments();
         size_t size = args1.size();
         if (size != args2.size()) {
             return false;
@@ -432,7 +432,7 @@ private:
 
         CPPADCG_ASSERT_UNKNOWN(scRef->getOperationType() == sc2->getOperationType())
 
-        const std::vector<Argument<Base> >& argsRef = scRef->getArguments();
+        const ArenaVector<Argument<Base> >& argsRef = scRef->getArguments();
 
         typename std::map<const OperationNode<Base>*, OperationIndexedIndependents<Base> >::iterator itop2a;
         bool searched = false;
@@ -459,7 +459,7 @@ private:
                 }
 
                 if (!indexedArg) {
-                    const std::vector<Argument<Base> >& args2 = sc2->getArguments();
+                    const ArenaVector<Argument<Base> >& args2 = sc2->getArguments();
                     CPPADCG_ASSERT_UNKNOWN(size == args2.size())
                     indexedDependentPath |= findIndexedPath(argsRef[a].getOperation(), args2[a].getOperation(), varIndexed, indexedOperations);
                 }
@@ -481,7 +481,7 @@ private:
 
         handler_->markVisited(node);
 
-        const std::vector<Argument<Base> >& args = node.getArguments();
+        const ArenaVector<Argument<Base> >& args = node.getArguments();
         size_t size = args.size();
         for (size_t a = 0; a < size; a++) {
             OperationNode<Base>* argOp = args[a].getOperation();
@@ -959,7 +959,7 @@ private:
              * part of the operation path that depends on the loop indexes
              * or its an array with constant elements
              */
-            const std::vector<Argument<Base> >& args = node.getArguments();
+            const ArenaVector<Argument<Base> >& args = node.getArguments();
             size_t arg_size = args.size();
             std::vector<Argument<Base> > cloneArgs(arg_size);
 
@@ -61,9 +61,9 @@ inline void combineNonOverlapingIterationRanges(std::vector<size_t>& iterRegions
  * @param newIterRegions the iteration regions to be added
  */
 inline void combineOverlapingIterationRanges(std::vector<size_t>& iterRegions,
-                                             const std::vector<size_t>& newIterRegions) {
+                                             ArrayView<const size_t> newIterRegions) {
     if (iterRegions.empty()) {
-        iterRegions = newIterRegions;
+        iterRegions.assign(newIterRegions.begin(), newIterRegions.end());
         return;
     } else if (newIterRegions.empty()) {
         return;
@@ -169,7 +169,8 @@ inline std::vector<size_t> ifBranchIterationRanges(const OperationNode<Base>* bS
         CPPADCG_ASSERT_UNKNOWN(cond->getArguments()[0].getOperation() != nullptr);
         CPPADCG_ASSERT_UNKNOWN(cond->getArguments()[0].getOperation()->getOperationType() == CGOpCode::Index);
         iterationIndexOp = static_cast<IndexOperationNode<Base>*> (cond->getArguments()[0].getOperation());
-        return cond->getInfo();
+        const ArenaVector<size_t>& info = cond->getInfo();
+        return std::vector<size_t>(info.begin(), info.end());
 
     } else {
         // else
@@ -87,7 +87,7 @@ inline CG<Base> CodeHandler<Base>::solveFor(const SourceCodePath& path) {
     for (size_t n = 0; n < path.size() - 1; ++n) {
         const OperationPathNode<Base>& pnodeOp = path[n];
         size_t argIndex = path[n].argIndex;
-        const std::vector<Argument<Base> >& args = pnodeOp.node->getArguments();
+        const ArenaVector<Argument<Base> >& args = pnodeOp.node->getArguments();
 
         CGOpCode op = pnodeOp.node->getOperationType();
         switch (op) {
@@ -218,7 +218,7 @@ inline bool CodeHandler<Base>::isSolvable(const SourceCodePath& path) const {
     for (size_t n = 0; n < path.size() - 1; ++n) {
         const OperationPathNode<Base>& pnodeOp = path[n];
         size_t argIndex = path[n].argIndex;
-        const std::vector<Argument<Base> >& args = pnodeOp.node->getArguments();
+        const ArenaVector<Argument<Base> >& args = pnodeOp.node->getArguments();
 
         CGOpCode op = pnodeOp.node->getOperationType();
         switch (op) {
@@ -0,0 +1,106 @@
+#ifndef CPPAD_CG_SOURCE_SINK_INCLUDED
+#define CPPAD_CG_SOURCE_SINK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Receives generated source files, one at a time, as soon as each file is
+ * complete.
+ * It allows the source files to be written or compiled and released while
+ * the remaining files are still being generated.
+ *
+ * @author Joao Leal
+ */
+class SourceSink {
+public:
+
+    /**
+     * Receives a complete source file.
+     *
+     * @param name the file name
+     * @param source the file content
+     */
+    virtual void addSource(const std::string& name,
+                           std::string source) = 0;
+
+    inline virtual ~SourceSink() = default;
+};
+
+/**
+ * Keeps all the source files in a map (file name to content).
+ */
+class SourceMapSink : public SourceSink {
+private:
+    std::map<std::string, std::string>& _sources;
+public:
+
+    /**
+     * @param sources where the source files are placed (files with the
+     *                same name are replaced)
+     */
+    inline explicit SourceMapSink(std::map<std::string, std::string>& sources) :
+        _sources(sources) {
+    }
+
+    inline void addSource(const std::string& name,
+                          std::string source) override {
+        _sources[name] = std::move(source);
+    }
+
+    inline std::map<std::string, std::string>& getSources() const {
+        return _sources;
+    }
+};
+
+/**
+ * Saves each source file into a folder as soon as it is received.
+ */
+class SourceFileSink : public SourceSink {
+private:
+    std::string _folder;
+public:
+
+    /**
+     * @param folder the folder where the files are created (it is created
+     *               if it does not exist and existing files with the same
+     *               names are replaced)
+     */
+    inline explicit SourceFileSink(std::string folder) :
+        _folder(std::move(folder)) {
+        system::createFolder(_folder);
+    }
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    inline void addSource(const std::string& name,
+                          std::string source) override {
+        std::string file = system::createPath(_folder, name);
+        std::ofstream sourceFile(file.c_str());
+        sourceFile << source;
+        sourceFile.close();
+        if (!sourceFile)
+            throw CGException("Failed to save source file '", file, "'");
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -38,7 +38,7 @@ inline bool CG<Base>::isParameter() const {
 
 template<class Base>
 inline bool CG<Base>::isValueDefined() const {
-    return value_ != nullptr;
+    return valueDefined_;
 }
 
 template<class Base>
@@ -47,16 +47,13 @@ inline const Base& CG<Base>::getValue() const {
         throw CGException("No value defined for this variable");
     }
 
-    return *value_;
+    return value_;
 }
 
 template<class Base>
 inline void CG<Base>::setValue(const Base& b) {
-    if (value_ != nullptr) {
-        *value_ = b;
-    } else {
-        value_.reset(new Base(b)); // to replace with value_ = std::make_unique once c++14 is used
-    }
+    value_ = b;
+    valueDefined_ = true;
 }
 
 template<class Base>
@@ -78,14 +75,19 @@ inline void CG<Base>::makeParameter(const Base &b) {
 template<class Base>
 inline void CG<Base>::makeVariable(OperationNode<Base>& operation) {
     node_ = &operation;
-    value_.reset();
+    valueDefined_ = false;
 }
 
 template<class Base>
 inline void CG<Base>::makeVariable(OperationNode<Base>& operation,
-                                   std::unique_ptr<Base>& value) {
+                                   const Base* value) {
     node_ = &operation;
-    value_ = std::move(value);
+    if (value != nullptr) {
+        value_ = *value;
+        valueDefined_ = true;
+    } else {
+        valueDefined_ = false;
+    }
 }
 
 template<class Base>
@@ -98,7 +100,7 @@ inline Argument<Base> CG<Base>::argument() const {
     if (node_ != nullptr)
         return Argument<Base> (*node_);
     else
-        return Argument<Base> (*value_);
+        return Argument<Base> (value_);
 }
 
 } // END cg namespace
@@ -0,0 +1,132 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Compares the creation of operation graphs with and without the memory
+ * arena of the CodeHandler (taping time, destruction time and peak
+ * resident memory).
+ * The peak memory can only be compared between different processes and
+ * therefore each execution only uses one of the options.
+ */
+
+#include <sys/resource.h>
+#include <iomanip>
+#include <cppad/cg/cppadcg.hpp>
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+using VectorSet = std::vector<std::set<size_t> >;
+
+namespace {
+
+/**
+ * @return the peak resident memory of this process (in KB)
+ */
+long getPeakMemory() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+std::unique_ptr<ADFun<CGD> > tapeModel(const std::string& model,
+                                       size_t size,
+                                       std::vector<Base>& x) {
+    std::vector<ADCGD> u;
+    std::vector<ADCGD> y;
+
+    if (model == "plugflow") {
+        x = PlugFlowModel<Base>::getTypicalValues(size);
+        u.assign(x.begin(), x.end());
+        Independent(u);
+        PlugFlowModel<CGD> m;
+        y = m.model2(u, size);
+    } else if (model == "distillation") {
+        x.assign(56, 1.0);
+        u.assign(x.begin(), x.end());
+        Independent(u);
+        y = distillationFunc<CGD>(u);
+    } else {
+        throw CGException("Unknown model '", model, "'");
+    }
+
+    std::unique_ptr<ADFun<CGD> > fun(new ADFun<CGD>());
+    fun->Dependent(u, y);
+    return fun;
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string model = argc > 1 ? argv[1] : "plugflow";
+    bool useArena = argc > 2 ? std::atoi(argv[2]) != 0 : true;
+    size_t size = argc > 3 ? std::atoi(argv[3]) : 50; // elements (plugflow) or copies (distillation)
+
+    std::vector<Base> x;
+    std::unique_ptr<ADFun<CGD> > fun = tapeModel(model, size, x);
+    size_t n = fun->Domain();
+    size_t m = fun->Range();
+    size_t copies = model == "distillation" ? size : 1;
+
+    VectorSet jacSparsity = jacobianSparsitySet<VectorSet, CGD>(*fun);
+    VectorSet hessSparsity = hessianSparsitySet<VectorSet, CGD>(*fun);
+
+    long memoryBefore = getPeakMemory();
+    size_t nodes;
+
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> dtTape, dtDestroy;
+    {
+        CodeHandler<Base> handler(100000);
+        handler.setUseNodeArena(useArena);
+
+        std::vector<CGD> results;
+        for (size_t c = 0; c < copies; ++c) {
+            std::vector<CGD> indVars(n);
+            handler.makeVariables(indVars);
+
+            std::vector<CGD> w(m, Base(1.0));
+
+            std::vector<CGD> dep = fun->Forward(0, indVars);
+            std::vector<CGD> jac = fun->SparseJacobian(indVars, jacSparsity);
+            std::vector<CGD> hess = fun->SparseHessian(indVars, w, hessSparsity);
+
+            results.insert(results.end(), dep.begin(), dep.end());
+            results.insert(results.end(), jac.begin(), jac.end());
+            results.insert(results.end(), hess.begin(), hess.end());
+        }
+
+        nodes = handler.getManagedNodesCount();
+        dtTape = std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+    }
+    dtDestroy = std::chrono::steady_clock::now() - start;
+
+    long memoryAfter = getPeakMemory();
+
+    std::cout << "model:           " << model << " (" << size << ")\n"
+              << "arena:           " << (useArena ? "yes" : "no") << "\n"
+              << "nodes:           " << nodes << "\n"
+              << std::scientific << std::setprecision(3)
+              << "taping time:     " << dtTape.count() << " s\n"
+              << "destroy time:    " << dtDestroy.count() << " s\n"
+              << "peak memory:     " << memoryAfter << " KB (graph: " << (memoryAfter - memoryBefore) << " KB)"
+              << std::endl;
+}
@@ -81,6 +81,7 @@ public:
     bool cppADCG;
     bool cppADCGLoops;
     bool cppADCGLoopsLlvm;
+    bool minimizeLiveVariables;
 protected:
     std::string libName_;
     bool testJacobian_;
@@ -107,6 +108,7 @@ private:
     std::vector<duration> dynLibComp_; /// compilation of the dynamic library
     std::vector<duration> jit_; /// compilation of the dynamic library
     std::vector<duration> total_; /// total time
+    std::vector<size_t> maxLiveTemporaries_; /// peak number of live temporary variables
 public:
 
     inline PatternSpeedTest(const std::string& libName,
@@ -119,6 +121,7 @@ public:
         cppADCG(true),
         cppADCGLoops(true),
         cppADCGLoopsLlvm(true),
+        minimizeLiveVariables(false),
         libName_(libName),
         testJacobian_(true),
         testHessian_(true),
@@ -356,6 +359,12 @@ protected:
         if (!jit_.empty())
             printStat("JIT library preparation", jit_);
         printStat("total", total_);
+        if (!maxLiveTemporaries_.empty()) {
+            std::cout << std::setw(30) << "peak live temporaries" << ": ";
+            for (size_t t : maxLiveTemporaries_)
+                std::cout << std::setw(12) << t << " ";
+            std::cout << std::endl;
+        }
 
         patternDection_.clear();
         graphGen_.clear();
@@ -364,6 +373,7 @@ protected:
         dynLibComp_.clear();
         jit_.clear();
         total_.clear();
+        maxLiveTemporaries_.clear();
     }
 
     static void printStat(const std::string& title,
@@ -566,6 +576,7 @@ protected:
         modelSourceGen_->setCreateReverseTwo(reverseTwo);
         modelSourceGen_->setRelatedDependents(relatedDepCandidates);
         modelSourceGen_->setTypicalIndependentValues(xTypical);
+        modelSourceGen_->setMinimizeLiveVariables(minimizeLiveVariables);
 
         if (!customJacSparsity_.empty())
             modelSourceGen_->setCustomSparseJacobianElements(customJacSparsity_);
@@ -583,6 +594,7 @@ protected:
             patternDection_.push_back(listener_.patternDection);
         graphGen_.push_back(listener_.graphGen);
         srcCodeGen_.push_back(listener_.srcCodeGen);
+        maxLiveTemporaries_.push_back(modelSourceGen_->getMaxLiveTemporaryVariables());
     }
 
     inline void createDynamicLib(const std::string& libBaseName,
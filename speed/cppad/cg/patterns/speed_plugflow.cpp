@@ -43,6 +43,7 @@ public:
 
 int main(int argc, char **argv) {
     size_t nEles = PatternSpeedTest::parseProgramArguments(1, argc, argv, 10);
+    bool minimizeLive = PatternSpeedTest::parseProgramArguments(2, argc, argv, 0) != 0; // reorder operations to reduce live temporaries
 
     std::vector<Base> x = PlugFlowModel<Base>::getTypicalValues(nEles);
     std::vector<std::set<size_t> > relations = PlugFlowModel<Base>::getRelatedCandidates(nEles);
@@ -59,6 +60,7 @@ int main(int argc, char **argv) {
     //speed.sparseJacobian = false;
     //speed.sparseHessian = false;
     speed.setNumberOfExecutions(30);
+    speed.minimizeLiveVariables = minimizeLive;
     speed.setCompileFlags(flags);
     speed.measureSpeed(relations, nEles, x);
 }
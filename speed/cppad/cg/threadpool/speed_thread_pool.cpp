@@ -0,0 +1,143 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Compares the scheduling strategies of the thread pool used by the
+ * generated multithreaded sparse Jacobians and Hessians.
+ * Each job mimics the evaluation of a small group of columns/rows.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cppad/cg/model/threadpool/pthread_pool.h>
+
+namespace {
+
+struct JobArg {
+    const double* x;
+    double* out;
+    int work;
+};
+
+void execJob(void* arg) {
+    auto* a = static_cast<JobArg*>(arg);
+    double v = a->x[0];
+    for (int k = 0; k < a->work; ++k) {
+        v = std::sin(v) * a->x[1] + std::cos(v);
+    }
+    a->out[0] = v;
+}
+
+/**
+ * Executes all the jobs in the thread pool the same way the generated
+ * sources do.
+ */
+void evaluate(std::vector<cppadcg_thpool_function_type>& functions,
+              std::vector<JobArg>& args,
+              std::vector<void*>& argsPtr,
+              cppadcg_thpool_schedule& schedule) {
+    int n = int(args.size());
+    std::vector<float> refElapsed(n), elapsed(n, 0);
+    std::vector<int> order(n), job2Thread(n);
+    int lastElapsedChanged;
+
+    int doBenchmark = cppadcg_thpool_schedule_load(&schedule, refElapsed.data(), order.data(), job2Thread.data(), &lastElapsedChanged);
+    float* elapsedPtr = doBenchmark ? elapsed.data() : nullptr;
+
+    cppadcg_thpool_add_jobs(functions.data(), argsPtr.data(), refElapsed.data(), elapsedPtr, order.data(), job2Thread.data(), n, lastElapsedChanged);
+
+    cppadcg_thpool_wait();
+
+    cppadcg_thpool_schedule_store(&schedule, elapsedPtr, job2Thread.data());
+}
+
+double measure(enum ScheduleStrategy strategy,
+               int nJobs,
+               int work,
+               int repetitions) {
+    std::vector<double> x{0.5, 1.5};
+    std::vector<double> out(nJobs);
+    std::vector<cppadcg_thpool_function_type> functions(nJobs, &execJob);
+    std::vector<JobArg> args(nJobs);
+    std::vector<void*> argsPtr(nJobs);
+    for (int i = 0; i < nJobs; ++i) {
+        args[i] = JobArg{x.data(), &out[i], work * (1 + i % 4)}; // uneven work
+        argsPtr[i] = &args[i];
+    }
+
+    std::vector<float> schedRefElapsed(nJobs, 0);
+    std::vector<int> schedOrder(nJobs), schedJob2Thread(nJobs, -1);
+    for (int i = 0; i < nJobs; ++i)
+        schedOrder[i] = i;
+    cppadcg_thpool_schedule schedule = {nJobs, schedRefElapsed.data(), schedOrder.data(), schedJob2Thread.data(), 0, 1};
+
+    cppadcg_thpool_set_scheduler_strategy(strategy);
+
+    // time measurements used by the pool
+    for (unsigned int r = 0; r <= cppadcg_thpool_get_n_time_meas(); ++r) {
+        evaluate(functions, args, argsPtr, schedule);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        evaluate(functions, args, argsPtr, schedule);
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+    return dt.count() / repetitions;
+}
+
+}
+
+int main(int argc, char** argv) {
+    int nThreads = 4;
+    int repetitions = 200;
+    if (argc > 1)
+        nThreads = std::atoi(argv[1]);
+    if (argc > 2)
+        repetitions = std::atoi(argv[2]);
+
+    cppadcg_thpool_set_threads(nThreads);
+    cppadcg_thpool_set_n_time_meas(5);
+
+    std::vector<std::pair<enum ScheduleStrategy, std::string>> strategies{{SCHED_STATIC, "static"},
+                                                                          {SCHED_DYNAMIC, "dynamic"},
+                                                                          {SCHED_GUIDED, "guided"},
+                                                                          {SCHED_WORK_STEALING, "work stealing"}};
+
+    std::cout << "threads: " << nThreads << "\n";
+    std::cout << std::setw(8) << "jobs" << std::setw(8) << "work";
+    for (const auto& s : strategies)
+        std::cout << std::setw(16) << s.second;
+    std::cout << "   (s per evaluation)" << std::endl;
+
+    for (int nJobs : {16, 256, 4096}) {
+        for (int work : {1, 10, 100}) {
+            std::cout << std::setw(8) << nJobs << std::setw(8) << work;
+            for (const auto& s : strategies) {
+                double t = measure(s.first, nJobs, work, repetitions);
+                std::cout << std::setw(16) << std::scientific << std::setprecision(3) << t;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    cppadcg_thpool_shutdown();
+}
@@ -25,6 +25,24 @@
 namespace CppAD {
 namespace cg {
 
+/**
+ * Provides the source files generated for a model of a library.
+ */
+class ModelSourcesCollector : public ModelLibraryProcessor<double> {
+public:
+
+    inline explicit ModelSourcesCollector(ModelLibraryCSourceGen<double>& modelLibraryHelper) :
+            ModelLibraryProcessor<double>(modelLibraryHelper) {
+    }
+
+    inline std::map<std::string, std::string> collect(ModelCSourceGen<double>& model) {
+        std::map<std::string, std::string> sources;
+        SourceMapSink sink(sources);
+        this->streamSources(model, sink);
+        return sources;
+    }
+};
+
 class CppADCGDynamicTest : public CppADCGModelTest {
 public:
     using CGD = CG<double>;
@@ -53,6 +71,8 @@ protected:
     std::vector<size_t> _jacCol;
     std::vector<size_t> _hessRow;
     std::vector<size_t> _hessCol;
+    std::vector<std::set<size_t> > _relatedDepCandidates;
+    std::map<std::string, std::string> _modelSources;
 public:
 
     explicit CppADCGDynamicTest(std::string testName,
@@ -131,11 +151,16 @@ public:
         if (!_hessRow.empty())
             modelSourceGen.setCustomSparseHessianElements(_hessRow, _hessCol);
 
+        if (!_relatedDepCandidates.empty())
+            modelSourceGen.setRelatedDependents(_relatedDepCandidates);
+
         ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
         libSourceGen.setMultiThreading(_multithread);
 
         SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
 
+        _modelSources = ModelSourcesCollector(libSourceGen).collect(modelSourceGen);
+
         DynamicModelLibraryProcessor<double> p(libSourceGen);
 
         // some additional tests
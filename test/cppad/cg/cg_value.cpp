@@ -0,0 +1,74 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST(CppADCGValueTest, Parameters) {
+    using CGD = CG<double>;
+
+    CGD p0;
+    ASSERT_TRUE(p0.isParameter());
+    ASSERT_TRUE(p0.isValueDefined());
+    ASSERT_EQ(p0.getValue(), 0.0);
+
+    CGD p1(2.0);
+    CGD p2(p1);
+    ASSERT_EQ(p2.getValue(), 2.0);
+
+    CGD p3(std::move(p2));
+    ASSERT_TRUE(p3.isValueDefined());
+    ASSERT_EQ(p3.getValue(), 2.0);
+
+    p0 = 3.0;
+    p1 += p0;
+    ASSERT_EQ(p1.getValue(), 5.0);
+    p1 *= p0;
+    ASSERT_EQ(p1.getValue(), 15.0);
+}
+
+TEST(CppADCGValueTest, Variables) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+    ASSERT_TRUE(x[0].isVariable());
+    ASSERT_FALSE(x[0].isValueDefined());
+    ASSERT_THROW(x[0].getValue(), CGException);
+
+    CGD y = x[0] + x[1];
+    ASSERT_FALSE(y.isValueDefined());
+
+    x[0].setValue(1.0);
+    x[1].setValue(2.0);
+    CGD z = x[0];
+    z *= x[1];
+    ASSERT_TRUE(z.isVariable());
+    ASSERT_TRUE(z.isValueDefined());
+    ASSERT_EQ(z.getValue(), 2.0);
+
+    // a variable without a value replaces the value of a parameter
+    CGD p(4.0);
+    p = y;
+    ASSERT_TRUE(p.isVariable());
+    ASSERT_FALSE(p.isValueDefined());
+
+    p = std::move(z);
+    ASSERT_TRUE(p.isValueDefined());
+    ASSERT_EQ(p.getValue(), 2.0);
+}
@@ -0,0 +1,69 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * A 3x4 matrix with the elements in an arbitrary order
+ */
+const std::vector<size_t> rows = {2, 0, 1, 0, 2, 1};
+const std::vector<size_t> cols = {1, 3, 0, 0, 3, 2};
+const std::vector<double> values = {21, 3, 10, 0, 23, 12}; // 10 * row + col
+
+}
+
+TEST_F(CppADCGTest, CompressedSparsityRow) {
+    CompressedSparsity<int> csr(CompressedSparsityFormat::Row);
+    csr.setPattern(3, 4, rows.data(), cols.data(), rows.size());
+
+    ASSERT_EQ(csr.getNonZeros(), rows.size());
+    ASSERT_EQ(csr.getOuterStarts(), std::vector<int>({0, 2, 4, 6}));
+    ASSERT_EQ(csr.getInnerIndexes(), std::vector<int>({0, 3, 0, 2, 1, 3}));
+    ASSERT_FALSE(csr.isIdentityPermutation());
+
+    std::vector<double> v = values;
+    csr.permute(v.data());
+    ASSERT_EQ(v, std::vector<double>({0, 3, 10, 12, 21, 23}));
+}
+
+TEST_F(CppADCGTest, CompressedSparsityColumn) {
+    CompressedSparsity<long> csc(CompressedSparsityFormat::Column);
+    csc.setPattern(3, 4, rows.data(), cols.data(), rows.size());
+
+    ASSERT_EQ(csc.getOuterStarts(), std::vector<long>({0, 2, 3, 4, 6}));
+    ASSERT_EQ(csc.getInnerIndexes(), std::vector<long>({0, 1, 2, 1, 0, 2}));
+
+    std::vector<double> v = values;
+    csc.permute(v.data());
+    ASSERT_EQ(v, std::vector<double>({0, 10, 21, 12, 3, 23}));
+}
+
+TEST_F(CppADCGTest, CompressedSparsityIdentity) {
+    std::vector<size_t> r = {0, 0, 1, 2};
+    std::vector<size_t> c = {0, 2, 1, 2};
+
+    CompressedSparsity<> csr;
+    csr.setPattern(3, 3, r.data(), c.data(), r.size());
+    ASSERT_TRUE(csr.isIdentityPermutation());
+
+    // repeated elements
+    r.push_back(1);
+    c.push_back(1);
+    ASSERT_THROW(csr.setPattern(3, 3, r.data(), c.data(), r.size()), CGException);
+}
@@ -0,0 +1,170 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST(CppADCGIdenticalNodesTest, ReuseNodes) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+    ASSERT_FALSE(handler.isReuseIdenticalNodes());
+    handler.setReuseIdenticalNodes(true);
+    ASSERT_TRUE(handler.isReuseIdenticalNodes());
+
+    std::vector<CGD> x(3);
+    handler.makeVariables(x);
+
+    size_t nodes = handler.getManagedNodesCount();
+
+    CGD s1 = sin(x[0]);
+    CGD s2 = sin(x[0]);
+    ASSERT_EQ(s1.getOperationNode(), s2.getOperationNode());
+
+    // commutative operations
+    CGD m1 = x[0] * x[1];
+    CGD m2 = x[1] * x[0];
+    ASSERT_EQ(m1.getOperationNode(), m2.getOperationNode());
+
+    CGD a1 = x[2] + 2.0;
+    CGD a2 = 2.0 + x[2];
+    ASSERT_EQ(a1.getOperationNode(), a2.getOperationNode());
+
+    // non-commutative operations
+    CGD d1 = x[0] / x[1];
+    CGD d2 = x[1] / x[0];
+    ASSERT_NE(d1.getOperationNode(), d2.getOperationNode());
+
+    // different parameters
+    CGD a3 = x[2] + 3.0;
+    ASSERT_NE(a1.getOperationNode(), a3.getOperationNode());
+
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 6);
+}
+
+TEST(CppADCGIdenticalNodesTest, ParameterRepresentation) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+    handler.setReuseIdenticalNodes(true);
+
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+
+    // -0.0 == 0.0 but the results are different
+    CGD d1 = x[0] / 0.0;
+    CGD d2 = x[0] / -0.0;
+    ASSERT_NE(d1.getOperationNode(), d2.getOperationNode());
+
+    CGD d3 = x[0] / 0.0;
+    ASSERT_EQ(d1.getOperationNode(), d3.getOperationNode());
+
+    // NaN != NaN but the results are the same
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    CGD n1 = x[0] + nan;
+    CGD n2 = x[0] + nan;
+    ASSERT_EQ(n1.getOperationNode(), n2.getOperationNode());
+}
+
+TEST(CppADCGIdenticalNodesTest, DeleteNodes) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+    handler.setReuseIdenticalNodes(true);
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    size_t nodes = handler.getManagedNodesCount();
+
+    CGD s1 = sin(x[0]);
+    CGD c1 = cos(x[1]);
+    CGD m1 = x[0] * x[1];
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 3);
+
+    handler.deleteManagedNodes(nodes + 1, nodes + 2); // cos
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 2);
+
+    CGD s2 = sin(x[0]);
+    ASSERT_EQ(s1.getOperationNode(), s2.getOperationNode());
+
+    CGD c2 = cos(x[1]);
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 3);
+    ASSERT_EQ(c2.getOperationNode()->getOperationType(), CGOpCode::Cos);
+
+    // a node modified after being created
+    OperationNode<double>* mul = m1.getOperationNode();
+    mul->makeAlias(Argument<double>(*x[0].getOperationNode()));
+    size_t pos = mul->getHandlerPosition();
+    handler.deleteManagedNodes(pos, pos + 1);
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 2);
+
+    CGD m2 = x[0] * x[1];
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 3);
+    ASSERT_EQ(m2.getOperationNode()->getOperationType(), CGOpCode::Mul);
+
+    // everything
+    handler.deleteManagedNodes(0, handler.getManagedNodesCount());
+    ASSERT_EQ(handler.getManagedNodesCount(), 0u);
+}
+
+TEST(CppADCGIdenticalNodesTest, GeneratedCode) {
+    using CGD = CG<double>;
+    using ADCGD = AD<CGD>;
+
+    std::vector<ADCGD> u(2);
+    u[0] = 1;
+    u[1] = 2;
+    Independent(u);
+
+    std::vector<ADCGD> Z(2);
+    Z[0] = sin(u[0]) * u[1];
+    Z[1] = u[1] * sin(u[0]) + cos(u[1]);
+
+    ADFun<CGD> f(u, Z);
+
+    auto generate = [&](bool reuse) {
+        CodeHandler<double> handler;
+        handler.setReuseIdenticalNodes(reuse);
+
+        std::vector<CGD> indVars(2);
+        handler.makeVariables(indVars);
+
+        std::vector<CGD> dep = f.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, dep, nameGen);
+
+        return std::make_pair(handler.getManagedNodesCount(), code.str());
+    };
+
+    auto countSin = [](const std::string& code) {
+        size_t n = 0;
+        for (size_t pos = code.find("sin("); pos != std::string::npos; pos = code.find("sin(", pos + 1))
+            n++;
+        return n;
+    };
+
+    auto noReuse = generate(false);
+    auto reuse = generate(true);
+
+    ASSERT_LT(reuse.first, noReuse.first);
+    ASSERT_EQ(countSin(noReuse.second), 2u);
+    ASSERT_EQ(countSin(reuse.second), 1u);
+}
@@ -0,0 +1,182 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Counts the started jobs and requests a cancellation when a job of a
+ * given type starts
+ */
+class CancellingListener : public JobListener {
+public:
+    JobTimer& timer;
+    const JobType* cancelAt;
+    std::atomic<size_t> started;
+
+    CancellingListener(JobTimer& timer,
+                       const JobType* cancelAt) :
+        timer(timer),
+        cancelAt(cancelAt),
+        started(0) {
+    }
+
+    void jobStarted(const std::vector<Job>& jobs) override {
+        started++;
+        if (&jobs.back().getType() == cancelAt)
+            timer.cancel();
+    }
+
+    void jobEndended(const std::vector<Job>& jobs,
+                     duration elapsed) override {
+    }
+};
+
+std::unique_ptr<ADFun<CG<double>>> createModel() {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(2);
+    x[0] = 1;
+    x[1] = 1;
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = 2.0 * x[0] * x[1];
+    y[1] = sin(x[0]) + x[1];
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+}
+
+TEST(CppADCGDynamicAsyncTest, CreateInBackground) {
+    std::unique_ptr<ADFun<CG<double>>> fun = createModel();
+
+    ModelCSourceGen<double> modelSourceGen(*fun, "async");
+    modelSourceGen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+    CancellingListener listener(libSourceGen, nullptr);
+    libSourceGen.addListener(listener);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_async");
+    std::future<std::unique_ptr<DynamicLib<double>>> future = p.createDynamicLibraryAsync(compiler);
+
+    std::unique_ptr<DynamicLib<double>> lib = future.get();
+    ASSERT_TRUE(lib != nullptr);
+    ASSERT_GT(listener.started, 0u);
+
+    std::vector<double> x{2.0, 3.0};
+    std::vector<double> y = lib->model("async")->ForwardZero(x);
+    ASSERT_NEAR(y[0], 12.0, 1e-10);
+}
+
+TEST(CppADCGDynamicAsyncTest, Cancel) {
+    std::unique_ptr<ADFun<CG<double>>> fun = createModel();
+
+    ModelCSourceGen<double> modelSourceGen(*fun, "async_cancel");
+    modelSourceGen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_async_cancel");
+
+    // cancelled during the source generation
+    CancellingListener listener(libSourceGen, &JobTimer::SOURCE_FOR_MODEL);
+    libSourceGen.addListener(listener);
+
+    std::future<std::unique_ptr<DynamicLib<double>>> future = p.createDynamicLibraryAsync(compiler);
+    ASSERT_THROW(future.get(), CGCancelledException);
+    ASSERT_EQ(libSourceGen.getJobCount(), 0u);
+    ASSERT_FALSE(libSourceGen.isCancelled());
+
+    // it must still be possible to create the library
+    libSourceGen.removeListener(listener);
+
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibraryAsync(compiler).get();
+    ASSERT_TRUE(lib != nullptr);
+
+    std::vector<double> x{2.0, 3.0};
+    std::vector<double> y = lib->model("async_cancel")->ForwardZero(x);
+    ASSERT_NEAR(y[0], 12.0, 1e-10);
+    ASSERT_NEAR(y[1], std::sin(2.0) + 3.0, 1e-10);
+}
+
+TEST(CppADCGDynamicAsyncTest, ConcurrentEvaluation) {
+    using ADD = AD<double>;
+
+    // models with their own tapes so that the sources can be generated by several threads
+    std::unique_ptr<ADFun<CG<double>>> fun1 = createModel();
+    std::unique_ptr<ADFun<CG<double>>> fun2 = createModel();
+
+    ModelCSourceGen<double> modelSourceGen1(*fun1, "async_concurrent1");
+    modelSourceGen1.setCreateSparseJacobian(true);
+    ModelCSourceGen<double> modelSourceGen2(*fun2, "async_concurrent2");
+    modelSourceGen2.setCreateSparseHessian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen1, modelSourceGen2);
+    libSourceGen.setSourceGenerationThreadNumber(2);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_async_concurrent");
+
+    // a model evaluated by this thread while the library is created
+    std::vector<ADD> u(2, ADD(1.0));
+    CppAD::Independent(u);
+    std::vector<ADD> v(1);
+    v[0] = u[0] * exp(u[1]);
+    ADFun<double> g(u, v);
+
+    std::unique_ptr<DynamicLib<double>> lib;
+    size_t evaluations = 0;
+    {
+        CppADParallelSetup<double> parallel(CppADParallelSetup<double>::getMaxThreads());
+        ASSERT_TRUE(thread_alloc::in_parallel());
+
+        std::future<std::unique_ptr<DynamicLib<double>>> future = p.createDynamicLibraryAsync(compiler);
+
+        std::vector<double> xd{0.5, 0.0};
+        do {
+            xd[1] += 0.001;
+            std::vector<double> yd = g.Forward(0, xd);
+            ASSERT_NEAR(yd[0], xd[0] * std::exp(xd[1]), 1e-10);
+            evaluations++;
+        } while (future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready);
+
+        lib = future.get();
+    }
+    ASSERT_FALSE(thread_alloc::in_parallel());
+    ASSERT_GT(evaluations, 0u);
+    ASSERT_TRUE(lib != nullptr);
+
+    std::vector<double> x{2.0, 3.0};
+    std::vector<double> y = lib->model("async_concurrent1")->ForwardZero(x);
+    ASSERT_NEAR(y[0], 12.0, 1e-10);
+    y = lib->model("async_concurrent2")->ForwardZero(x);
+    ASSERT_NEAR(y[1], std::sin(2.0) + 3.0, 1e-10);
+}
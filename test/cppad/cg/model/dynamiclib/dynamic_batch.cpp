@@ -0,0 +1,147 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 3;
+const size_t m = 2;
+
+std::unique_ptr<DynamicLib<double>> createLibrary(bool batch,
+                                                  const std::string& name) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+
+    std::vector<ADCG> Z(m);
+    Z[0] = u[0] * u[1] + sin(u[2]);
+    Z[1] = exp(u[0]) * u[2] + 2.0;
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelSourceGen(fun, name);
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setCreateBatch(batch);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_" + name);
+    return p.createDynamicLibrary(compiler);
+}
+
+/**
+ * Compares the evaluations at multiple points with the evaluations
+ * at each individual point
+ */
+void testBatch(GenericModel<double>& model) {
+    const size_t nPoints = 37; // not a multiple of the vector size
+
+    std::vector<double> x(n * nPoints), w(m * nPoints);
+    for (size_t p = 0; p < nPoints; ++p) {
+        for (size_t j = 0; j < n; ++j)
+            x[j * nPoints + p] = 0.1 * p + 0.5 * j - 0.3;
+        for (size_t i = 0; i < m; ++i)
+            w[i * nPoints + p] = 1.0 + 0.2 * p - i;
+    }
+
+    // forward zero
+    std::vector<double> y;
+    model.ForwardZeroBatch(x, nPoints, y);
+    ASSERT_EQ(y.size(), m * nPoints);
+
+    // sparse Jacobian
+    std::vector<double> jacP;
+    std::vector<size_t> jacRow, jacCol;
+    model.SparseJacobian(std::vector<double>(n), jacP, jacRow, jacCol);
+
+    std::vector<double> jac(jacRow.size() * nPoints);
+    size_t const* row;
+    size_t const* col;
+    model.SparseJacobianBatch(x, nPoints, jac, &row, &col);
+    for (size_t e = 0; e < jacRow.size(); ++e) {
+        ASSERT_EQ(row[e], jacRow[e]);
+        ASSERT_EQ(col[e], jacCol[e]);
+    }
+
+    // sparse Hessian
+    std::vector<double> hessP;
+    std::vector<size_t> hessRow, hessCol;
+    model.SparseHessian(std::vector<double>(n), std::vector<double>(m), hessP, hessRow, hessCol);
+
+    std::vector<double> hess(hessRow.size() * nPoints);
+    model.SparseHessianBatch(x, w, nPoints, hess, &row, &col);
+    for (size_t e = 0; e < hessRow.size(); ++e) {
+        ASSERT_EQ(row[e], hessRow[e]);
+        ASSERT_EQ(col[e], hessCol[e]);
+    }
+
+    // compare with the evaluation of each point
+    std::vector<double> xp(n), wp(m), yp;
+    for (size_t p = 0; p < nPoints; ++p) {
+        for (size_t j = 0; j < n; ++j)
+            xp[j] = x[j * nPoints + p];
+        for (size_t i = 0; i < m; ++i)
+            wp[i] = w[i * nPoints + p];
+
+        model.ForwardZero(xp, yp);
+        for (size_t i = 0; i < m; ++i)
+            ASSERT_NEAR(y[i * nPoints + p], yp[i], 1e-10);
+
+        model.SparseJacobian(xp, jacP, jacRow, jacCol);
+        for (size_t e = 0; e < jacP.size(); ++e)
+            ASSERT_NEAR(jac[e * nPoints + p], jacP[e], 1e-10);
+
+        model.SparseHessian(xp, wp, hessP, hessRow, hessCol);
+        for (size_t e = 0; e < hessP.size(); ++e)
+            ASSERT_NEAR(hess[e * nPoints + p], hessP[e], 1e-10);
+    }
+}
+
+}
+
+TEST(CppADCGDynamicBatchTest, GeneratedKernels) {
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(true, "batch");
+    std::unique_ptr<GenericModel<double>> model = lib->model("batch");
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_TRUE(model->isForwardZeroBatchAvailable());
+    ASSERT_TRUE(model->isSparseJacobianBatchAvailable());
+    ASSERT_TRUE(model->isSparseHessianBatchAvailable());
+
+    testBatch(*model);
+}
+
+TEST(CppADCGDynamicBatchTest, PointByPoint) {
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(false, "nobatch");
+    std::unique_ptr<GenericModel<double>> model = lib->model("nobatch");
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_FALSE(model->isForwardZeroBatchAvailable());
+    ASSERT_FALSE(model->isSparseJacobianBatchAvailable());
+    ASSERT_FALSE(model->isSparseHessianBatchAvailable());
+
+    testBatch(*model);
+}
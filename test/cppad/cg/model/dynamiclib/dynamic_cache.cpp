@@ -0,0 +1,142 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <dirent.h>
+#include <unistd.h>
+
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Counts the jobs of each type
+ */
+class JobTypeCounter : public JobListener {
+public:
+    std::map<const JobType*, size_t> started;
+
+    void jobStarted(const std::vector<Job>& jobs) override {
+        started[&jobs.back().getType()]++;
+    }
+
+    void jobEndended(const std::vector<Job>& jobs,
+                     duration elapsed) override {
+    }
+};
+
+/**
+ * Removes a cache folder and the files inside it (the cache does not
+ * have sub-folders)
+ */
+void removeFolder(const std::string& folder) {
+    DIR* dir = opendir(folder.c_str());
+    if (dir == nullptr)
+        return; // does not exist
+
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..")
+            std::remove(system::createPath(folder, name).c_str());
+    }
+    closedir(dir);
+
+    rmdir(folder.c_str());
+}
+
+std::unique_ptr<DynamicLib<double>> createLibrary(double coefficient,
+                                                  const std::string& cacheFolder,
+                                                  JobTypeCounter& counter) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(2);
+    x[0] = 1;
+    x[1] = 1;
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = coefficient * x[0] * x[1];
+    y[1] = sin(x[0]) + x[1];
+
+    ADFun<CGD> fun(x, y);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "cached");
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setMaxAssignmentsPerFunc(1);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+    libSourceGen.addListener(counter);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    compiler.setCacheFolder(cacheFolder);
+    compiler.setCompileJobs(2);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_cached");
+    return p.createDynamicLibrary(compiler);
+}
+
+}
+
+class CppADCGDynamicCacheTest : public CppADCGTest {
+protected:
+    const std::string cacheFolder_ = "dynamic_cache_test";
+public:
+
+    void SetUp() override {
+        // must start with an empty cache
+        removeFolder(cacheFolder_);
+    }
+
+    void TearDown() override {
+        removeFolder(cacheFolder_);
+        CppADCGTest::TearDown();
+    }
+};
+
+TEST_F(CppADCGDynamicCacheTest, ReuseObjectFilesAndLibrary) {
+    std::vector<double> x{2.0, 3.0};
+
+    JobTypeCounter counter1;
+    std::unique_ptr<DynamicLib<double>> lib1 = createLibrary(2.0, cacheFolder_, counter1);
+    ASSERT_TRUE(lib1 != nullptr);
+    std::vector<double> y1 = lib1->model("cached")->ForwardZero(x);
+    ASSERT_NEAR(y1[0], 12.0, 1e-10);
+    lib1.reset();
+
+    // the same model must reuse everything
+    JobTypeCounter counter2;
+    std::unique_ptr<DynamicLib<double>> lib2 = createLibrary(2.0, cacheFolder_, counter2);
+    ASSERT_TRUE(lib2 != nullptr);
+    ASSERT_EQ(counter2.started[&JobTimer::COMPILING], 0u);
+    ASSERT_EQ(counter2.started[&JobTimer::COMPILING_DYNAMIC_LIBRARY], 0u);
+    ASSERT_EQ(counter2.started[&JobTimer::REUSING_CACHED], counter1.started[&JobTimer::COMPILING] + 1);
+    std::vector<double> y2 = lib2->model("cached")->ForwardZero(x);
+    ASSERT_NEAR(y2[0], 12.0, 1e-10);
+    lib2.reset();
+
+    // a different model must only compile the modified sources and link again
+    JobTypeCounter counter3;
+    std::unique_ptr<DynamicLib<double>> lib3 = createLibrary(3.0, cacheFolder_, counter3);
+    ASSERT_TRUE(lib3 != nullptr);
+    ASSERT_GT(counter3.started[&JobTimer::COMPILING], 0u);
+    ASSERT_LT(counter3.started[&JobTimer::COMPILING], counter1.started[&JobTimer::COMPILING]);
+    ASSERT_EQ(counter3.started[&JobTimer::COMPILING_DYNAMIC_LIBRARY], 1u);
+    std::vector<double> y3 = lib3->model("cached")->ForwardZero(x);
+    ASSERT_NEAR(y3[0], 18.0, 1e-10);
+}
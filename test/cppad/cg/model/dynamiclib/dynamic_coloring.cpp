@@ -0,0 +1,211 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 8;
+const size_t m = n - 2;
+
+/**
+ * A banded model (similar to a collocation model) with a tridiagonal
+ * Hessian or a model with an arrow shaped Hessian (the first variable
+ * multiplies all the others)
+ */
+template<class T>
+std::vector<AD<T>> modelFunction(const std::vector<AD<T>>& x,
+                                 bool arrow) {
+    std::vector<AD<T>> y(m);
+    for (size_t i = 0; i < m; ++i) {
+        if (arrow) {
+            y[i] = x[0] * x[i + 1] - sin(x[i + 2]);
+        } else {
+            y[i] = x[i] * x[i + 1] - sin(x[i + 2]) + x[i + 1] * x[i + 1] * x[i + 2];
+        }
+    }
+    return y;
+}
+
+/**
+ * Provides the source files generated for a model
+ */
+class SourceCollector : public ModelLibraryProcessor<double> {
+public:
+
+    explicit SourceCollector(ModelLibraryCSourceGen<double>& libSourceGen) :
+        ModelLibraryProcessor<double>(libSourceGen) {
+    }
+
+    const std::map<std::string, std::string>& getSources(ModelCSourceGen<double>& model) {
+        return ModelLibraryProcessor<double>::getSources(model);
+    }
+};
+
+/**
+ * Counts the generated functions for the colors of a sparse Jacobian or
+ * Hessian (e.g. model_sparse_jacobian_color0)
+ */
+size_t countColorFunctions(const std::map<std::string, std::string>& sources,
+                           const std::string& function) {
+    const std::string prefix = function + "_color";
+    size_t count = 0;
+    for (const auto& it : sources) {
+        const std::string& file = it.first;
+        if (file.compare(0, prefix.size(), prefix) != 0)
+            continue;
+        std::string suffix = file.substr(prefix.size());
+        if (suffix.size() > 2 && suffix.compare(suffix.size() - 2, 2, ".c") == 0 &&
+            suffix.find_first_not_of("0123456789") == suffix.size() - 2) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Compares the sparse Jacobian and Hessian from a model generated with
+ * coloring with the results from CppAD
+ */
+void testColoring(JacobianADMode mode,
+                  MultiThreadingType multiThreading,
+                  const std::string& name,
+                  bool arrow = false) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+    std::vector<ADCG> Z = modelFunction(u, arrow);
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelSourceGen(fun, name);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setSparseJacobianColoring(true);
+    modelSourceGen.setSparseHessianColoring(true);
+    modelSourceGen.setJacobianADMode(mode);
+
+    ASSERT_EQ(modelSourceGen.isJacobianMultiThreadingEnabled(), true);
+    ASSERT_EQ(modelSourceGen.isHessianMultiThreadingEnabled(), true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+    libSourceGen.setMultiThreading(multiThreading);
+
+    /**
+     * one function for each color (less than the number of variables for
+     * these models)
+     */
+    const auto& sources = SourceCollector(libSourceGen).getSources(modelSourceGen);
+    size_t jacFunctions = countColorFunctions(sources, name + "_sparse_jacobian");
+    size_t hessFunctions = countColorFunctions(sources, name + "_sparse_hessian");
+    ASSERT_GT(jacFunctions, 0u);
+    if (mode == JacobianADMode::Forward || !arrow) {
+        ASSERT_LE(jacFunctions, 3u);
+    } else {
+        ASSERT_EQ(jacFunctions, m); // all equations depend on the first variable
+    }
+    ASSERT_GT(hessFunctions, 0u);
+    if (arrow) {
+        // a column intersection coloring would require n colors
+        ASSERT_EQ(hessFunctions, 2u);
+    } else {
+        ASSERT_LE(hessFunctions, 3u);
+    }
+    ASSERT_LT(hessFunctions, n);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_" + name);
+
+    if (multiThreading == MultiThreadingType::OPENMP) {
+        compiler.addCompileFlag("-fopenmp");
+        compiler.addCompileFlag("-pthread");
+        compiler.addCompileLibFlag("-fopenmp");
+
+#ifdef CPPAD_CG_SYSTEM_LINUX
+        // this is required because the OpenMP implementation in GCC causes a segmentation fault on dlclose
+        p.getOptions()["dlOpenMode"] = std::to_string(RTLD_NOW | RTLD_NODELETE);
+#endif
+    } else if (multiThreading == MultiThreadingType::PTHREADS) {
+        compiler.addCompileFlag("-pthread");
+    }
+
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = lib->model(name);
+    ASSERT_TRUE(model != nullptr);
+
+    std::vector<double> x(n);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = 0.5 + 0.1 * j;
+    std::vector<double> w(m);
+    for (size_t i = 0; i < m; ++i)
+        w[i] = 1.0 - 0.3 * i;
+
+    std::vector<AD<double>> xa(n);
+    CppAD::Independent(xa);
+    std::vector<AD<double>> ya = modelFunction(xa, arrow);
+    ADFun<double> f(xa, ya);
+
+    std::vector<double> jacDense = f.Jacobian(x);
+    std::vector<double> hessDense = f.Hessian(x, w);
+
+    std::vector<double> jac;
+    std::vector<size_t> row, col;
+    model->SparseJacobian(x, jac, row, col);
+    ASSERT_EQ(jac.size(), 3 * m);
+    for (size_t e = 0; e < jac.size(); ++e) {
+        ASSERT_NEAR(jac[e], jacDense[row[e] * n + col[e]], 1e-10) << "(" << row[e] << ", " << col[e] << ")";
+    }
+
+    std::vector<double> hess;
+    model->SparseHessian(x, w, hess, row, col);
+    for (size_t e = 0; e < hess.size(); ++e) {
+        ASSERT_NEAR(hess[e], hessDense[row[e] * n + col[e]], 1e-10) << "(" << row[e] << ", " << col[e] << ")";
+    }
+}
+
+}
+
+TEST(CppADCGDynamicColoringTest, Forward) {
+    testColoring(JacobianADMode::Forward, MultiThreadingType::NONE, "coloring_for");
+}
+
+TEST(CppADCGDynamicColoringTest, Reverse) {
+    testColoring(JacobianADMode::Reverse, MultiThreadingType::NONE, "coloring_rev");
+}
+
+TEST(CppADCGDynamicColoringTest, ForwardOpenMP) {
+    testColoring(JacobianADMode::Forward, MultiThreadingType::OPENMP, "coloring_omp");
+}
+
+TEST(CppADCGDynamicColoringTest, ReverseOpenMP) {
+    testColoring(JacobianADMode::Reverse, MultiThreadingType::OPENMP, "coloring_rev_omp");
+}
+
+TEST(CppADCGDynamicColoringTest, ReversePThreads) {
+    testColoring(JacobianADMode::Reverse, MultiThreadingType::PTHREADS, "coloring_rev_pthreads");
+}
+
+TEST(CppADCGDynamicColoringTest, StarColoring) {
+    testColoring(JacobianADMode::Forward, MultiThreadingType::NONE, "coloring_star", true);
+}
+
+TEST(CppADCGDynamicColoringTest, StarColoringReverseOpenMP) {
+    testColoring(JacobianADMode::Reverse, MultiThreadingType::OPENMP, "coloring_star_omp", true);
+}
@@ -0,0 +1,134 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 4;
+const size_t m = 3;
+
+/**
+ * The elements of the Jacobian and of the Hessian in an order which is
+ * neither row nor column major
+ */
+const std::vector<size_t> jacRow = {2, 0, 1, 2, 0, 1, 0, 2};
+const std::vector<size_t> jacCol = {3, 1, 2, 1, 0, 0, 3, 2};
+const std::vector<size_t> hessRow = {3, 2, 1, 0, 2, 1, 3, 0, 1};
+const std::vector<size_t> hessCol = {3, 0, 3, 2, 2, 1, 1, 1, 0};
+
+/**
+ * Compares the values of a compressed matrix with the ones of the same
+ * matrix in a dense format (row major)
+ */
+template<class Index>
+void compareWithDense(const CompressedSparsity<Index>& sparsity,
+                      const std::vector<double>& values,
+                      const std::vector<double>& dense) {
+    bool byRow = sparsity.getFormat() == CompressedSparsityFormat::Row;
+    const std::vector<Index>& starts = sparsity.getOuterStarts();
+    const std::vector<Index>& inner = sparsity.getInnerIndexes();
+
+    ASSERT_EQ(values.size(), sparsity.getNonZeros());
+    ASSERT_EQ(starts.size(), (byRow ? sparsity.getRows() : sparsity.getCols()) + 1);
+
+    for (size_t o = 0; o + 1 < starts.size(); ++o) {
+        for (Index e = starts[o]; e < starts[o + 1]; ++e) {
+            if (e > starts[o]) {
+                ASSERT_LT(inner[e - 1], inner[e]); // sorted inner indexes
+            }
+            size_t i = byRow ? o : size_t(inner[e]);
+            size_t j = byRow ? size_t(inner[e]) : o;
+            ASSERT_EQ(values[e], dense[i * sparsity.getCols() + j]) << "element (" << i << ", " << j << ")";
+        }
+    }
+}
+
+template<class Index>
+void testCompressed(GenericModel<double>& model,
+                    CompressedSparsityFormat format) {
+    std::vector<double> x = {0.5, 1.5, -0.7, 2.0};
+    std::vector<double> w = {1.0, 2.5, -0.5};
+
+    std::vector<double> jacDense = model.SparseJacobian(x);
+    std::vector<double> hessDense = model.SparseHessian(x, w);
+
+    /**
+     * Jacobian
+     */
+    CompressedSparsity<Index> jacSparsity(format);
+    model.JacobianSparsity(jacSparsity);
+    ASSERT_EQ(jacSparsity.getRows(), m);
+    ASSERT_EQ(jacSparsity.getCols(), n);
+    ASSERT_EQ(jacSparsity.getNonZeros(), jacRow.size());
+    ASSERT_FALSE(jacSparsity.isIdentityPermutation());
+
+    std::vector<double> jac(jacSparsity.getNonZeros());
+    model.SparseJacobian(x, jacSparsity, jac);
+    compareWithDense(jacSparsity, jac, jacDense);
+
+    /**
+     * Hessian
+     */
+    CompressedSparsity<Index> hessSparsity(format);
+    model.HessianSparsity(hessSparsity);
+    ASSERT_EQ(hessSparsity.getRows(), n);
+    ASSERT_EQ(hessSparsity.getCols(), n);
+    ASSERT_EQ(hessSparsity.getNonZeros(), hessRow.size());
+    ASSERT_FALSE(hessSparsity.isIdentityPermutation());
+
+    std::vector<double> hess(hessSparsity.getNonZeros());
+    model.SparseHessian(x, w, hessSparsity, hess);
+    compareWithDense(hessSparsity, hess, hessDense);
+}
+
+}
+
+TEST(CppADCGDynamicCompressedTest, CompressedSparsity) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+
+    std::vector<ADCG> Z(m);
+    Z[0] = u[0] * u[1] + sin(u[3]);
+    Z[1] = exp(u[2]) * u[0];
+    Z[2] = u[1] * u[1] * u[3] + u[2];
+
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "compressed");
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setCustomSparseJacobianElements(jacRow, jacCol);
+    modelSourceGen.setCustomSparseHessianElements(hessRow, hessCol);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_compressed");
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model("compressed");
+    ASSERT_TRUE(model != nullptr);
+
+    testCompressed<int>(*model, CompressedSparsityFormat::Row);
+    testCompressed<size_t>(*model, CompressedSparsityFormat::Column);
+}
@@ -0,0 +1,240 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Counts the jobs of each type
+ */
+class JobTypeCounter : public JobListener {
+public:
+    std::map<const JobType*, size_t> started;
+
+    void jobStarted(const std::vector<Job>& jobs) override {
+        started[&jobs.back().getType()]++;
+    }
+
+    void jobEndended(const std::vector<Job>& jobs,
+                     duration elapsed) override {
+    }
+};
+
+std::unique_ptr<ADFun<CG<double>>> createModel(double coefficient) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(2);
+    x[0] = 1;
+    x[1] = 1;
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = coefficient * x[0] * x[1];
+    y[1] = sin(x[0]) + x[1];
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+/**
+ * A model with 3 equations with the same pattern (a loop)
+ */
+std::unique_ptr<ADFun<CG<double>>> createLoopModel() {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> x(6, 1.0);
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(3);
+    for (size_t i = 0; i < 3; ++i)
+        y[i] = x[i] * sin(x[i + 3]) + exp(x[i]);
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+/**
+ * Generates the sources of a model without compiling them
+ */
+class SourceGenerator : public ModelLibraryProcessor<double> {
+public:
+
+    explicit SourceGenerator(ModelLibraryCSourceGen<double>& libSourceGen) :
+        ModelLibraryProcessor<double>(libSourceGen) {
+    }
+
+    void generate(ModelCSourceGen<double>& model) {
+        this->getSources(model);
+    }
+};
+
+std::unique_ptr<DynamicLib<double>> createLibrary(double coefficientB,
+                                                  const std::string& folder,
+                                                  JobTypeCounter& counter) {
+    std::unique_ptr<ADFun<CG<double>>> funA = createModel(2.0);
+    std::unique_ptr<ADFun<CG<double>>> funB = createModel(coefficientB);
+
+    ModelCSourceGen<double> modelA(*funA, "incremental_a");
+    modelA.setCreateSparseJacobian(true);
+    ModelCSourceGen<double> modelB(*funB, "incremental_b");
+    modelB.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelA, modelB);
+    libSourceGen.setIncrementalFolder(folder);
+    libSourceGen.addListener(counter);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_incremental");
+    return p.createDynamicLibrary(compiler);
+}
+
+}
+
+TEST(CppADCGDynamicIncrementalTest, ModelFingerprint) {
+    std::unique_ptr<ADFun<CG<double>>> fun1 = createModel(2.0);
+    std::unique_ptr<ADFun<CG<double>>> fun2 = createModel(2.0);
+    std::unique_ptr<ADFun<CG<double>>> fun3 = createModel(3.0);
+
+    ModelCSourceGen<double> model1(*fun1, "model");
+    ModelCSourceGen<double> model2(*fun2, "model");
+    ModelCSourceGen<double> model3(*fun3, "model");
+
+    std::string f1 = model1.getFingerprint(MultiThreadingType::NONE);
+    ASSERT_EQ(f1, model2.getFingerprint(MultiThreadingType::NONE));
+    ASSERT_NE(f1, model3.getFingerprint(MultiThreadingType::NONE));
+
+    model2.setCreateSparseJacobian(true);
+    ASSERT_NE(f1, model2.getFingerprint(MultiThreadingType::NONE));
+}
+
+TEST(CppADCGDynamicIncrementalTest, AtomicFingerprint) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    auto createInner = [](bool dense) {
+        std::vector<ADCG> x(2, ADCG(1.0));
+        CppAD::Independent(x);
+        std::vector<ADCG> y(1);
+        y[0] = dense ? x[0] * x[1] : x[0] * x[0];
+        return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+    };
+
+    auto createOuter = [](CGAtomicFunBridge<double>& atomic) {
+        std::vector<ADCG> x(2, ADCG(1.0));
+        CppAD::Independent(x);
+        std::vector<ADCG> y(1);
+        atomic(x, y);
+        return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+    };
+
+    // atomic functions with the same name but a different sparsity
+    std::unique_ptr<ADFun<CGD>> inner1 = createInner(true);
+    std::unique_ptr<ADFun<CGD>> inner2 = createInner(true);
+    std::unique_ptr<ADFun<CGD>> inner3 = createInner(false);
+    CGAtomicFunBridge<double> atomic1("inner", *inner1, true);
+    CGAtomicFunBridge<double> atomic2("inner", *inner2, true);
+    CGAtomicFunBridge<double> atomic3("inner", *inner3, true);
+    ASSERT_EQ(atomic1.getFingerprint(), atomic2.getFingerprint());
+    ASSERT_NE(atomic1.getFingerprint(), atomic3.getFingerprint());
+
+    std::unique_ptr<ADFun<CGD>> fun1 = createOuter(atomic1);
+    std::unique_ptr<ADFun<CGD>> fun2 = createOuter(atomic2);
+    std::unique_ptr<ADFun<CGD>> fun3 = createOuter(atomic3);
+
+    ModelCSourceGen<double> model1(*fun1, "model");
+    ModelCSourceGen<double> model2(*fun2, "model");
+    ModelCSourceGen<double> model3(*fun3, "model");
+
+    std::string f1 = model1.getFingerprint(MultiThreadingType::NONE);
+    ASSERT_EQ(f1, model2.getFingerprint(MultiThreadingType::NONE));
+    ASSERT_NE(f1, model3.getFingerprint(MultiThreadingType::NONE));
+}
+
+TEST(CppADCGDynamicIncrementalTest, RegenerateModifiedModels) {
+    std::vector<double> x{2.0, 3.0};
+
+    // must start with an empty folder
+    std::string folder = "tmp/incremental_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+
+    JobTypeCounter counter1;
+    std::unique_ptr<DynamicLib<double>> lib1 = createLibrary(2.0, folder, counter1);
+    ASSERT_TRUE(lib1 != nullptr);
+    ASSERT_EQ(counter1.started[&JobTimer::SOURCE_FOR_MODEL], 2u);
+    ASSERT_EQ(counter1.started[&JobTimer::REUSING_CACHED], 0u);
+    ASSERT_NEAR(lib1->model("incremental_b")->ForwardZero(x)[0], 12.0, 1e-10);
+    lib1.reset();
+
+    // only the modified model is generated again
+    JobTypeCounter counter2;
+    std::unique_ptr<DynamicLib<double>> lib2 = createLibrary(3.0, folder, counter2);
+    ASSERT_TRUE(lib2 != nullptr);
+    ASSERT_EQ(counter2.started[&JobTimer::SOURCE_FOR_MODEL], 1u);
+    ASSERT_EQ(counter2.started[&JobTimer::REUSING_CACHED], 1u);
+    ASSERT_NEAR(lib2->model("incremental_a")->ForwardZero(x)[0], 12.0, 1e-10);
+    ASSERT_NEAR(lib2->model("incremental_b")->ForwardZero(x)[0], 18.0, 1e-10);
+    lib2.reset();
+
+    // nothing changed
+    JobTypeCounter counter3;
+    std::unique_ptr<DynamicLib<double>> lib3 = createLibrary(3.0, folder, counter3);
+    ASSERT_TRUE(lib3 != nullptr);
+    ASSERT_EQ(counter3.started[&JobTimer::SOURCE_FOR_MODEL], 0u);
+    ASSERT_EQ(counter3.started[&JobTimer::REUSING_CACHED], 2u);
+    ASSERT_NEAR(lib3->model("incremental_b")->ForwardZero(x)[0], 18.0, 1e-10);
+}
+
+TEST(CppADCGDynamicIncrementalTest, ReuseGenerationInfo) {
+    // must start with an empty folder
+    std::string folder = "tmp/incremental_info_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+
+    std::unique_ptr<ADFun<CG<double>>> fun = createLoopModel();
+
+    size_t workspaceSize[2], maxLiveTemporaries[2];
+    bool jacobianMultiThreading[2];
+    JobTypeCounter counter[2];
+    for (size_t k = 0; k < 2; ++k) {
+        ModelCSourceGen<double> model(*fun, "incremental_info");
+        model.setCreateSparseJacobian(true);
+        model.setSparseJacobianColoring(true); // not used with loops
+        model.setMultiThreading(true);
+        model.setRelatedDependents({{0, 1, 2}});
+        model.setTemporariesInWorkspace(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(model);
+        libSourceGen.setIncrementalFolder(folder);
+        libSourceGen.addListener(counter[k]);
+        SourceGenerator(libSourceGen).generate(model);
+
+        workspaceSize[k] = model.getWorkspaceSize();
+        maxLiveTemporaries[k] = model.getMaxLiveTemporaryVariables();
+        jacobianMultiThreading[k] = model.isJacobianMultiThreadingEnabled();
+    }
+
+    ASSERT_EQ(counter[0].started[&JobTimer::REUSING_CACHED], 0u);
+    ASSERT_EQ(counter[1].started[&JobTimer::REUSING_CACHED], 1u);
+
+    // the reused sources must provide the same information
+    ASSERT_GT(workspaceSize[0], 0u);
+    ASSERT_EQ(workspaceSize[0], workspaceSize[1]);
+    ASSERT_EQ(maxLiveTemporaries[0], maxLiveTemporaries[1]);
+    ASSERT_FALSE(jacobianMultiThreading[0]);
+    ASSERT_FALSE(jacobianMultiThreading[1]);
+}
@@ -0,0 +1,90 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST(CppADCGDynamicLazyTest, LazyFunctionLoading) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> ax(2);
+    ax[0] = 1;
+    ax[1] = 1;
+    CppAD::Independent(ax);
+
+    std::vector<ADCG> ay(2);
+    ay[0] = 2.0 * ax[0] * ax[1];
+    ay[1] = sin(ax[0]) + ax[1];
+
+    ADFun<CGD> fun(ax, ay);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "lazy");
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_lazy");
+#if CPPAD_CG_SYSTEM_LINUX
+    p.getOptions()["dlOpenMode"] = std::to_string(RTLD_LAZY);
+#endif
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+    ASSERT_GT(lib->getLoadDurations().count("validation"), 0u);
+
+    lib->setLazyFunctionLoading(true);
+    std::unique_ptr<FunctorGenericModel<double>> model = lib->modelFunctor("lazy");
+    ASSERT_TRUE(model != nullptr);
+    ASSERT_TRUE(model->isLazyFunctionLoading());
+
+    std::vector<double> x{2.0, 3.0};
+
+    // functions are loaded on their first use
+    std::vector<double> y = model->ForwardZero(x);
+    ASSERT_NEAR(y[0], 12.0, 1e-10);
+    ASSERT_NEAR(y[1], std::sin(2.0) + 3.0, 1e-10);
+
+    ASSERT_TRUE(model->isSparseJacobianAvailable());
+    std::vector<double> jac;
+    std::vector<size_t> row, col;
+    model->SparseJacobian(x, jac, row, col);
+    ASSERT_EQ(jac.size(), 4u);
+
+    ASSERT_FALSE(model->isJacobianAvailable());
+    ASSERT_FALSE(model->isForwardOneAvailable());
+
+    std::map<std::string, std::chrono::steady_clock::duration> durations = model->getLoadDurations();
+    ASSERT_GT(durations.count("validation"), 0u);
+    ASSERT_GT(durations.count("functions"), 0u);
+
+    // the same results must be obtained with a model loaded eagerly
+    lib->setLazyFunctionLoading(false);
+    std::unique_ptr<FunctorGenericModel<double>> eagerModel = lib->modelFunctor("lazy");
+    ASSERT_FALSE(eagerModel->isLazyFunctionLoading());
+
+    std::vector<double> jac2;
+    std::vector<size_t> row2, col2;
+    eagerModel->SparseJacobian(x, jac2, row2, col2);
+    ASSERT_EQ(row2, row);
+    ASSERT_EQ(col2, col);
+    for (size_t e = 0; e < jac.size(); ++e) {
+        ASSERT_NEAR(jac2[e], jac[e], 1e-10);
+    }
+}
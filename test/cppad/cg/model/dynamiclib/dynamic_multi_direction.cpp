@@ -0,0 +1,125 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 3;
+const size_t m = 2;
+
+template<class T>
+std::vector<AD<T>> modelFunction(const std::vector<AD<T>>& x) {
+    std::vector<AD<T>> y(m);
+    y[0] = x[0] * x[1] + sin(x[2]);
+    y[1] = exp(x[0]) * x[2] + x[1] * x[1];
+    return y;
+}
+
+std::unique_ptr<DynamicLib<double>> createLibrary(bool multiDirection,
+                                                  const std::string& name) {
+    using CGD = CG<double>;
+    using ADCG = AD<CGD>;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+    std::vector<ADCG> Z = modelFunction(u);
+    ADFun<CGD> fun(u, Z);
+
+    ModelCSourceGen<double> modelSourceGen(fun, name);
+    modelSourceGen.setCreateForwardOne(true);
+    modelSourceGen.setCreateReverseTwo(true);
+    modelSourceGen.setCreateMultiDirection(multiDirection);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_" + name);
+    return p.createDynamicLibrary(compiler);
+}
+
+/**
+ * Compares the evaluation of several directions at once with the
+ * results from CppAD for each direction
+ */
+void testMultiDirection(GenericModel<double>& model) {
+    const size_t nDir = 5;
+
+    std::vector<double> x = {0.5, 1.5, -0.3};
+    std::vector<double> w = {2.0, -0.7};
+
+    std::vector<double> tx1(n * nDir);
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t k = 0; k < nDir; ++k)
+            tx1[j * nDir + k] = (j + k) % 3 == 0 ? 0.0 : 0.3 * k - 0.2 * j + 0.1;
+    }
+
+    std::vector<double> ty1(m * nDir), px2(n * nDir);
+    model.ForwardOne(x, nDir, tx1, ty1);
+    model.ReverseTwo(x, nDir, tx1, px2, w);
+
+    std::vector<AD<double>> xa(n);
+    CppAD::Independent(xa);
+    std::vector<AD<double>> ya = modelFunction(xa);
+    ADFun<double> f(xa, ya);
+
+    std::vector<double> jac = f.Jacobian(x);
+    std::vector<double> hess = f.Hessian(x, w);
+
+    for (size_t k = 0; k < nDir; ++k) {
+        for (size_t i = 0; i < m; ++i) {
+            double dy = 0;
+            for (size_t j = 0; j < n; ++j)
+                dy += jac[i * n + j] * tx1[j * nDir + k];
+            ASSERT_NEAR(ty1[i * nDir + k], dy, 1e-10) << "ty1[" << i << "] direction " << k;
+        }
+
+        for (size_t j = 0; j < n; ++j) {
+            double dx = 0;
+            for (size_t l = 0; l < n; ++l)
+                dx += hess[l * n + j] * tx1[l * nDir + k];
+            ASSERT_NEAR(px2[j * nDir + k], dx, 1e-10) << "px2[" << j << "] direction " << k;
+        }
+    }
+}
+
+}
+
+TEST(CppADCGDynamicMultiDirectionTest, GeneratedKernels) {
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(true, "multi_dir");
+    std::unique_ptr<GenericModel<double>> model = lib->model("multi_dir");
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_TRUE(model->isSparseForwardOneMultiAvailable());
+    ASSERT_TRUE(model->isSparseReverseTwoMultiAvailable());
+
+    testMultiDirection(*model);
+}
+
+TEST(CppADCGDynamicMultiDirectionTest, OneDirectionAtATime) {
+    std::unique_ptr<DynamicLib<double>> lib = createLibrary(false, "single_dir");
+    std::unique_ptr<GenericModel<double>> model = lib->model("single_dir");
+    ASSERT_TRUE(model != nullptr);
+
+    ASSERT_FALSE(model->isSparseForwardOneMultiAvailable());
+    ASSERT_FALSE(model->isSparseReverseTwoMultiAvailable());
+
+    testMultiDirection(*model);
+}
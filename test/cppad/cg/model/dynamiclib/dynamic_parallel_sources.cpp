@@ -0,0 +1,222 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCG = AD<CGD>;
+
+/**
+ * Provides the sources of all the models in a library
+ */
+class SourceCollector : public ModelLibraryProcessor<double> {
+public:
+
+    explicit SourceCollector(ModelLibraryCSourceGen<double>& libSourceGen) :
+        ModelLibraryProcessor<double>(libSourceGen) {
+    }
+
+    std::map<std::string, std::string> collect() {
+        std::map<std::string, std::string> all;
+        for (const auto& p : this->modelLibraryHelper_->getModels()) {
+            const std::map<std::string, std::string>& sources = this->getSources(*p.second);
+            all.insert(sources.begin(), sources.end());
+        }
+        return all;
+    }
+};
+
+/**
+ * Saves the names of the models whose source generation started
+ */
+class ModelJobListener : public JobListener {
+public:
+    std::vector<std::string> models;
+
+    void jobStarted(const std::vector<Job>& jobs) override {
+        if (&jobs.back().getType() == &JobTimer::SOURCE_FOR_MODEL)
+            models.push_back(jobs.back().name());
+    }
+
+    void jobEndended(const std::vector<Job>& jobs,
+                     duration elapsed) override {
+    }
+};
+
+std::unique_ptr<ADFun<CGD>> createModel(size_t k) {
+    std::vector<ADCG> x(3);
+    x[0] = 1;
+    x[1] = 1;
+    x[2] = 1;
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = double(k + 1) * x[0] * x[1] + exp(x[2]);
+    y[1] = sin(x[0]) * double(k) + x[1] / x[2];
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+void atomicFunction(const std::vector<AD<double> >& x,
+                    std::vector<AD<double> >& y) {
+    y[0] = x[0] * x[0] + x[1];
+    y[1] = x[0] * sin(x[1]);
+}
+
+std::unique_ptr<ADFun<CGD>> createAtomicModel() {
+    std::vector<ADCG> x(2, 1.0);
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(2);
+    y[0] = x[0] * x[0] + x[1];
+    y[1] = x[0] * sin(x[1]);
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+std::unique_ptr<ADFun<CGD>> createModelWithAtomics(atomic_base<CGD>& atomic) {
+    std::vector<ADCG> x(6, 1.0);
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(4), ax(2), ay(2);
+    for (size_t i = 0; i < 2; ++i) {
+        ax[0] = x[2 * i];
+        ax[1] = x[2 * i + 1] * x[4];
+        atomic(ax, ay);
+        y[2 * i] = ay[0] * x[5];
+        y[2 * i + 1] = ay[1] + exp(x[2 * i]);
+    }
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+class ModelSet {
+public:
+    std::vector<std::unique_ptr<ADFun<CGD>>> funs;
+    std::vector<std::unique_ptr<ModelCSourceGen<double>>> models;
+    std::unique_ptr<ModelLibraryCSourceGen<double>> lib;
+
+    explicit ModelSet(size_t n) {
+        for (size_t k = 0; k < n; ++k) {
+            funs.push_back(createModel(k));
+            models.emplace_back(new ModelCSourceGen<double>(*funs.back(), "model" + std::to_string(k)));
+            models.back()->setCreateSparseJacobian(true);
+            models.back()->setCreateSparseHessian(true);
+            if (k == 0)
+                lib.reset(new ModelLibraryCSourceGen<double>(*models.back()));
+            else
+                lib->addModel(*models.back());
+        }
+    }
+};
+
+}
+
+TEST(CppADCGDynamicParallelSourcesTest, SameSources) {
+    const size_t n = 5;
+
+    ModelSet serial(n);
+    ModelJobListener serialListener;
+    serial.lib->addListener(serialListener);
+    std::map<std::string, std::string> serialSources = SourceCollector(*serial.lib).collect();
+
+    ModelSet parallel(n);
+    parallel.lib->setSourceGenerationThreadNumber(3);
+    ASSERT_EQ(parallel.lib->getSourceGenerationThreadNumber(), 3u);
+    ModelJobListener parallelListener;
+    parallel.lib->addListener(parallelListener);
+    std::map<std::string, std::string> parallelSources = SourceCollector(*parallel.lib).collect();
+
+    ASSERT_EQ(serialSources, parallelSources);
+
+    // the jobs are reported in the order of the models
+    ASSERT_EQ(serialListener.models.size(), n);
+    ASSERT_EQ(serialListener.models, parallelListener.models);
+    ASSERT_EQ(parallel.lib->getJobCount(), 0u);
+}
+
+TEST(CppADCGDynamicParallelSourcesTest, Library) {
+    ModelSet set(4);
+    set.lib->setSourceGenerationThreadNumber(0); // hardware threads
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(*set.lib, "cppad_cg_parallel_sources");
+    std::unique_ptr<DynamicLib<double>> lib = p.createDynamicLibrary(compiler);
+
+    std::vector<double> x{2.0, 3.0, 0.5};
+    for (size_t k = 0; k < 4; ++k) {
+        std::unique_ptr<GenericModel<double>> model = lib->model("model" + std::to_string(k));
+        std::vector<double> y = model->ForwardZero(x);
+        ASSERT_NEAR(y[0], double(k + 1) * 6.0 + std::exp(0.5), 1e-10);
+        ASSERT_NEAR(y[1], std::sin(2.0) * double(k) + 6.0, 1e-10);
+    }
+}
+
+TEST(CppADCGDynamicParallelSourcesTest, SameSourcesWithAtomics) {
+    std::vector<AD<double> > ax(2, 1.0), ay(2);
+    checkpoint<double> atomicfun("atomicFunc", atomicFunction, ax, ay);
+    CGAtomicFun<double> cgAtomicFun(atomicfun, ax, true);
+
+    std::map<std::string, std::string> sources[2];
+    for (size_t threads : {1, 3}) {
+        std::unique_ptr<ADFun<CGD>> fun = createModelWithAtomics(cgAtomicFun);
+
+        ModelCSourceGen<double> model(*fun, "modelAtomics");
+        model.setCreateForwardOne(true);
+        model.setCreateReverseOne(true);
+        model.setCreateReverseTwo(true);
+        model.setSourceGenerationThreadNumber(threads);
+        ASSERT_EQ(model.getSourceGenerationThreadNumber(), threads);
+
+        ModelLibraryCSourceGen<double> lib(model);
+        sources[threads == 1 ? 0 : 1] = SourceCollector(lib).collect();
+        ASSERT_EQ(lib.getJobCount(), 0u);
+        ASSERT_FALSE(thread_alloc::in_parallel());
+    }
+
+    ASSERT_EQ(sources[0], sources[1]);
+}
+
+TEST(CppADCGDynamicParallelSourcesTest, SameSourcesWithAtomicBridge) {
+    std::unique_ptr<ADFun<CGD>> inner = createAtomicModel();
+    CGAtomicFunBridge<double> atomicfun("atomicBridge", *inner, true);
+
+    std::map<std::string, std::string> sources[3];
+    size_t threads[3] = {1, 3, 3}; // the last one reuses the atomic function
+    for (size_t t = 0; t < 3; ++t) {
+        std::unique_ptr<ADFun<CGD>> fun = createModelWithAtomics(atomicfun);
+
+        ModelCSourceGen<double> model(*fun, "modelAtomicBridge");
+        model.setCreateForwardOne(true);
+        model.setCreateReverseOne(true);
+        model.setCreateReverseTwo(true);
+        model.setSourceGenerationThreadNumber(threads[t]);
+
+        ModelLibraryCSourceGen<double> lib(model);
+        sources[t] = SourceCollector(lib).collect();
+        ASSERT_EQ(lib.getJobCount(), 0u);
+        ASSERT_FALSE(thread_alloc::in_parallel());
+    }
+
+    ASSERT_EQ(sources[0], sources[1]);
+    ASSERT_EQ(sources[0], sources[2]);
+}
@@ -0,0 +1,135 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+using CGD = CG<double>;
+using ADCG = AD<CGD>;
+
+/**
+ * Provides the sources of a model either all at once or one file at a time
+ */
+class SourceCollector : public ModelLibraryProcessor<double> {
+public:
+
+    explicit SourceCollector(ModelLibraryCSourceGen<double>& libSourceGen) :
+        ModelLibraryProcessor<double>(libSourceGen) {
+    }
+
+    std::map<std::string, std::string> collect(ModelCSourceGen<double>& model) {
+        return this->getSources(model);
+    }
+
+    void stream(ModelCSourceGen<double>& model,
+                SourceSink& sink) {
+        this->streamSources(model, sink);
+    }
+};
+
+/**
+ * Saves the received files and the order in which they were received
+ */
+class RecordingSink : public SourceSink {
+public:
+    std::map<std::string, std::string> sources;
+    std::vector<std::string> order;
+
+    void addSource(const std::string& name,
+                   std::string source) override {
+        order.push_back(name);
+        sources[name] = std::move(source);
+    }
+};
+
+std::unique_ptr<ADFun<CGD>> createModel() {
+    std::vector<ADCG> x(4, 1.0);
+    CppAD::Independent(x);
+
+    std::vector<ADCG> y(3);
+    y[0] = x[0] * x[1] + exp(x[2]) * x[3];
+    y[1] = sin(x[0]) * x[3] + x[1] / x[2];
+    y[2] = x[0] * x[0] * x[1] - cos(x[3]) * x[2];
+
+    return std::unique_ptr<ADFun<CGD>>(new ADFun<CGD>(x, y));
+}
+
+void configure(ModelCSourceGen<double>& model) {
+    model.setCreateJacobian(true);
+    model.setCreateSparseJacobian(true);
+    model.setCreateSparseHessian(true);
+    model.setCreateForwardOne(true);
+    model.setCreateReverseOne(true);
+    model.setCreateReverseTwo(true);
+    model.setMaxAssignmentsPerFunc(2); // several files per function
+}
+
+}
+
+TEST(CppADCGDynamicStreamSourcesTest, SameSources) {
+    std::unique_ptr<ADFun<CGD>> fun1 = createModel();
+    ModelCSourceGen<double> model1(*fun1, "model");
+    configure(model1);
+    ModelLibraryCSourceGen<double> lib1(model1);
+    std::map<std::string, std::string> sources = SourceCollector(lib1).collect(model1);
+
+    std::unique_ptr<ADFun<CGD>> fun2 = createModel();
+    ModelCSourceGen<double> model2(*fun2, "model");
+    configure(model2);
+    ModelLibraryCSourceGen<double> lib2(model2);
+    lib2.setStreamModelSources(true);
+    ASSERT_TRUE(lib2.isStreamModelSources());
+
+    RecordingSink sink;
+    SourceCollector(lib2).stream(model2, sink);
+
+    ASSERT_EQ(sources, sink.sources);
+    ASSERT_EQ(sink.order.size(), sources.size()); // each file is provided once
+    ASSERT_EQ(lib2.getJobCount(), 0u);
+
+    // the sources are not kept by the model and can be generated again
+    RecordingSink sink2;
+    SourceCollector(lib2).stream(model2, sink2);
+    ASSERT_EQ(sources, sink2.sources);
+}
+
+TEST(CppADCGDynamicStreamSourcesTest, DynamicLibrary) {
+    std::unique_ptr<ADFun<CGD>> fun = createModel();
+    ModelCSourceGen<double> model(*fun, "model");
+    configure(model);
+    ModelLibraryCSourceGen<double> libSourceGen(model);
+    libSourceGen.setStreamModelSources(true);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_stream_sources");
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> genModel = dynamicLib->model("model");
+
+    std::vector<double> x{0.5, 2.0, 1.5, 3.0};
+    std::vector<double> y = genModel->ForwardZero(x);
+    ASSERT_NEAR(y[0], 0.5 * 2.0 + std::exp(1.5) * 3.0, 1e-10);
+    ASSERT_NEAR(y[1], std::sin(0.5) * 3.0 + 2.0 / 1.5, 1e-10);
+    ASSERT_NEAR(y[2], 0.5 * 0.5 * 2.0 - std::cos(3.0) * 1.5, 1e-10);
+
+    std::vector<double> jac = genModel->Jacobian(x);
+    ASSERT_NEAR(jac[0 * 4 + 0], 2.0, 1e-10);
+    ASSERT_NEAR(jac[1 * 4 + 3], std::sin(0.5), 1e-10);
+}
@@ -0,0 +1,209 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 3;
+const size_t m = 2;
+
+/**
+ * Compares the values from a model evaluation with the expected ones
+ */
+bool nearEqual(const std::vector<double>& values,
+               const std::vector<double>& expected) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (std::abs(values[i] - expected[i]) > 1e-10 * (1 + std::abs(expected[i])))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Evaluates the same model object many times and checks the results
+ *
+ * @return the number of evaluations with wrong results
+ */
+size_t evaluate(GenericModel<double>& model,
+                size_t threadId,
+                size_t repetitions) {
+    size_t errors = 0;
+
+    std::vector<double> x(n), w(m), y(m), jac(m * n), hess(n * n), ty1(m), px(n);
+    std::vector<double> yExp(m), jacExp(m * n), hessExp(n * n);
+
+    for (size_t r = 0; r < repetitions; ++r) {
+        x[0] = 0.1 * threadId + 0.001 * r;
+        x[1] = 1.0 - 0.01 * threadId;
+        x[2] = 0.5 + 0.002 * r;
+        w[0] = 1.0 + threadId;
+        w[1] = 0.5 * r;
+
+        double ex0 = std::exp(x[0]);
+        yExp = {x[0] * x[1] + std::sin(x[2]), ex0 * x[2]};
+        jacExp = {x[1], x[0], std::cos(x[2]),
+                  ex0 * x[2], 0, ex0};
+        hessExp = {w[1] * ex0 * x[2], w[0], w[1] * ex0,
+                   w[0], 0, 0,
+                   w[1] * ex0, 0, -w[0] * std::sin(x[2])};
+
+        model.ForwardZero(x, y);
+        if (!nearEqual(y, yExp))
+            errors++;
+
+        model.SparseJacobian(x, jac);
+        if (!nearEqual(jac, jacExp))
+            errors++;
+
+        model.SparseHessian(x, w, hess);
+        if (!nearEqual(hess, hessExp))
+            errors++;
+
+        // directional derivatives
+        size_t j = r % n;
+        double tx1 = 1.0;
+        model.ForwardOne(x, 1, &j, &tx1, ty1);
+        if (!nearEqual(ty1, {jacExp[j], jacExp[n + j]}))
+            errors++;
+
+        size_t i = r % m;
+        double py = 1.0;
+        model.ReverseOne(x, px, 1, &i, &py);
+        if (!nearEqual(px, {jacExp[i * n], jacExp[i * n + 1], jacExp[i * n + 2]}))
+            errors++;
+    }
+
+    return errors;
+}
+
+std::unique_ptr<ADFun<CG<double> > > createModel() {
+    using ADCG = AD<CG<double> >;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+
+    std::vector<ADCG> Z(m);
+    Z[0] = u[0] * u[1] + sin(u[2]);
+    Z[1] = exp(u[0]) * u[2];
+
+    return std::unique_ptr<ADFun<CG<double> > >(new ADFun<CG<double> >(u, Z));
+}
+
+void configure(ModelCSourceGen<double>& modelSourceGen,
+               bool inWorkspace) {
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setCreateSparseHessian(true);
+    modelSourceGen.setCreateForwardOne(true);
+    modelSourceGen.setCreateReverseOne(true);
+    modelSourceGen.setTemporariesInWorkspace(inWorkspace);
+}
+
+/**
+ * Generates the sources of a model without compiling them
+ */
+class SourceGenerator : public ModelLibraryProcessor<double> {
+public:
+
+    explicit SourceGenerator(ModelLibraryCSourceGen<double>& libSourceGen) :
+        ModelLibraryProcessor<double>(libSourceGen) {
+    }
+
+    void generate(ModelCSourceGen<double>& model) {
+        this->getSources(model);
+    }
+};
+
+/**
+ * Evaluates a single model object from several threads at the same time
+ *
+ * @param inWorkspace whether or not the temporary variables are placed in
+ *                    a per-thread workspace instead of the stack
+ */
+void testConcurrentEvaluation(const std::string& name,
+                              bool inWorkspace) {
+    std::unique_ptr<ADFun<CG<double> > > fun = createModel();
+
+    ModelCSourceGen<double> modelSourceGen(*fun, name);
+    configure(modelSourceGen, inWorkspace);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libSourceGen, "cppad_cg_" + name);
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(name);
+    ASSERT_TRUE(model != nullptr);
+
+    bool perThread;
+    ASSERT_EQ(model->getWorkspaceSize(perThread), modelSourceGen.getWorkspaceSize());
+    ASSERT_GT(modelSourceGen.getWorkspaceSize(), 0u);
+    ASSERT_EQ(perThread, inWorkspace);
+
+    const size_t nThreads = 8;
+    const size_t repetitions = 2000;
+
+    // a single model object shared by all threads
+    std::vector<size_t> errors(nThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            errors[t] = evaluate(*model, t, repetitions);
+        });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    for (size_t t = 0; t < nThreads; ++t) {
+        ASSERT_EQ(errors[t], 0u) << "thread " << t;
+    }
+}
+
+}
+
+TEST(CppADCGDynamicThreadSafetyTest, ConcurrentEvaluation) {
+    testConcurrentEvaluation("shared", false);
+}
+
+TEST(CppADCGDynamicThreadSafetyTest, ConcurrentEvaluationWorkspace) {
+    testConcurrentEvaluation("shared_workspace", true);
+}
+
+TEST(CppADCGDynamicThreadSafetyTest, WorkspaceSize) {
+    std::unique_ptr<ADFun<CG<double> > > fun = createModel();
+
+    size_t size[2];
+    for (bool inWorkspace : {false, true}) {
+        ModelCSourceGen<double> modelSourceGen(*fun, "workspace_size");
+        configure(modelSourceGen, inWorkspace);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        SourceGenerator(libSourceGen).generate(modelSourceGen);
+
+        size[inWorkspace ? 1 : 0] = modelSourceGen.getWorkspaceSize();
+    }
+
+    // the stack only holds the arrays of one function at a time
+    ASSERT_GT(size[0], 0u);
+    // each function has its own thread local arrays
+    ASSERT_GT(size[1], size[0]);
+}
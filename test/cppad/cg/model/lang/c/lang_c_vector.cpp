@@ -0,0 +1,164 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <dlfcn.h>
+
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+const size_t n = 3;
+const size_t m = 4;
+
+template<class T>
+std::vector<AD<T>> model(std::vector<AD<T>>& x) {
+    std::vector<AD<T>> y(m);
+    y[0] = sin(x[0]) * x[1] + exp(x[2]) / 2.0;
+    y[1] = CondExpLt(x[0], x[1], x[0] * x[2], x[1] - 3.0);
+    y[2] = CondExpGt(x[2], AD<T>(0.5), pow(x[0], x[1]), abs(x[2]));
+    y[3] = sign(x[0] - 1.0) * sqrt(x[1]);
+    return y;
+}
+
+/**
+ * Generates and compiles the vector source code and compares the value of
+ * each lane with the results from CppAD
+ */
+template<class Base>
+void testVectorModel(const std::string& typeName,
+                     size_t width) {
+    using CGB = CG<Base>;
+    using ADCG = AD<CGB>;
+
+    std::vector<ADCG> u(n, ADCG(1.0));
+    CppAD::Independent(u);
+    std::vector<ADCG> z = model(u);
+    ADFun<CGB> fun(u, z);
+
+    CodeHandler<Base> handler;
+    std::vector<CGB> indVars(n);
+    handler.makeVariables(indVars);
+    std::vector<CGB> dep = fun.Forward(0, indVars);
+
+    LanguageCVector<Base> langC(typeName, width);
+    langC.setGenerateFunction("vector_model");
+    LangCDefaultVariableNameGenerator<Base> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, dep, nameGen);
+
+    std::string library = "./cppadcg_vector_" + typeName + ".so";
+    GccCompiler<Base> compiler;
+    prepareTestCompilerFlags(compiler);
+    compiler.compileSources({{"vector_model.c", code.str()}}, true);
+    compiler.buildDynamic(library);
+    compiler.cleanup();
+
+    void* libHandle = dlopen(library.c_str(), RTLD_NOW);
+    ASSERT_TRUE(libHandle != nullptr);
+
+    void (*fn)(Base const* const*, Base* const*, LangCAtomicFun) = nullptr;
+    *(void**) (&fn) = dlsym(libHandle, "vector_model");
+    ASSERT_TRUE(fn != nullptr);
+
+    // variable j at lane k is x[j * width + k]
+    std::vector<Base> x(n * width), y(m * width);
+    for (size_t k = 0; k < width; ++k) {
+        x[k] = Base(0.3) * k + Base(0.1);
+        x[width + k] = Base(1.7) - Base(0.2) * k;
+        x[2 * width + k] = Base(0.25) * k;
+    }
+
+    const Base* in[] = {x.data()};
+    Base* out[] = {y.data()};
+    (*fn)(in, out, LangCAtomicFun{nullptr, nullptr, nullptr});
+
+    std::vector<AD<Base>> xa(n);
+    CppAD::Independent(xa);
+    std::vector<AD<Base>> ya = model(xa);
+    ADFun<Base> f(xa, ya);
+
+    std::vector<Base> xk(n);
+    for (size_t k = 0; k < width; ++k) {
+        for (size_t j = 0; j < n; ++j)
+            xk[j] = x[j * width + k];
+
+        std::vector<Base> yk = f.Forward(0, xk);
+        for (size_t i = 0; i < m; ++i)
+            ASSERT_NEAR(y[i * width + k], yk[i], 1e-5 * (1 + std::abs(yk[i]))) << "y[" << i << "] at lane " << k;
+    }
+
+    dlclose(libHandle);
+}
+
+/**
+ * Exposes the generation of branches
+ */
+class LanguageCVectorBranches : public LanguageCVector<double> {
+public:
+    using LanguageCVector<double>::LanguageCVector;
+
+    void push(OperationNode<double>& node) {
+        switch (node.getOperationType()) {
+            case CGOpCode::StartIf:
+                this->pushStartIf(node);
+                break;
+            case CGOpCode::ElseIf:
+                this->pushElseIf(node);
+                break;
+            case CGOpCode::Else:
+                this->pushElse(node);
+                break;
+            case CGOpCode::EndIf:
+                this->pushEndIf(node);
+                break;
+            case CGOpCode::CondResult:
+                this->pushCondResult(node);
+                break;
+            default:
+                this->pushIndexCondExprOp(node);
+        }
+    }
+};
+
+}
+
+TEST(CppADCGLangCVectorTest, Double) {
+    testVectorModel<double>("double", 4);
+}
+
+TEST(CppADCGLangCVectorTest, Float) {
+    testVectorModel<float>("float", 8);
+}
+
+TEST(CppADCGLangCVectorTest, TypeNames) {
+    LanguageCVector<double> langC("double", 4);
+    ASSERT_EQ(langC.getVectorTypeName(), "double_v4");
+    ASSERT_EQ(langC.getVectorWidth(), 4u);
+}
+
+TEST(CppADCGLangCVectorTest, Branches) {
+    CodeHandler<double> handler;
+    LanguageCVectorBranches langC("double", 4);
+
+    for (CGOpCode op : {CGOpCode::IndexCondExpr, CGOpCode::StartIf, CGOpCode::ElseIf,
+                        CGOpCode::Else, CGOpCode::EndIf, CGOpCode::CondResult}) {
+        OperationNode<double>* node = handler.makeNode(op);
+        ASSERT_THROW(langC.push(*node), CGException) << "operation " << op;
+    }
+}
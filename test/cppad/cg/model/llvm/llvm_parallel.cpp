@@ -0,0 +1,47 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "LlvmModelTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+class LlvmModelParallelTest : public LlvmModelTest {
+public:
+    std::unique_ptr<LlvmModelLibrary<Base> > compileLib(LlvmModelLibraryProcessor<double>& p) override {
+        p.setThreadNumber(3);
+        p.setModelOptimizationLevel("mySmallModel", 2);
+        return p.create();
+    }
+};
+
+TEST_F(LlvmModelParallelTest, ForwardZero) {
+    testForwardZeroResults(*model, *fun, nullptr, x);
+}
+
+TEST_F(LlvmModelParallelTest, DenseJacobian) {
+    testDenseJacResults(*model, *fun, x);
+}
+
+TEST_F(LlvmModelParallelTest, DenseHessian) {
+    testDenseHessianResults(*model, *fun, x);
+}
+
+TEST_F(LlvmModelParallelTest, Jacobian) {
+    testSparseJacobianResults(1, *model, *fun, nullptr, x, false);
+}
+
+TEST_F(LlvmModelParallelTest, Hessian) {
+    testSparseHessianResults(1, *model, *fun, nullptr, x, false);
+}
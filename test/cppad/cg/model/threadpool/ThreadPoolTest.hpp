@@ -60,6 +60,26 @@ public:
         return y;
     }
 
+    /**
+     * Checks that the sparse Jacobian and Hessian of a model with loops
+     * are evaluated by several tasks.
+     */
+    void testLoopTasks() {
+        for (const std::string& f : {ModelCSourceGen<double>::FUNCTION_SPARSE_JACOBIAN,
+                                     ModelCSourceGen<double>::FUNCTION_SPARSE_HESSIAN}) {
+            std::string function = _name + "dynamic_" + f;
+
+            auto it = _modelSources.find(function + ".c");
+            ASSERT_TRUE(it != _modelSources.end());
+            const std::string& source = it->second;
+
+            ASSERT_NE(source.find("_loop"), std::string::npos); // calls the loops
+            ASSERT_NE(source.find(function + "_task0"), std::string::npos);
+            ASSERT_NE(source.find(function + "_task1"), std::string::npos);
+            ASSERT_NE(source.find("calloc("), std::string::npos);
+        }
+    }
+
 };
 
 } // END cg namespace
@@ -158,3 +158,37 @@ TEST_F(CppADCGThreadPoolDynamicCustomTest, Jacobian) {
 TEST_F(CppADCGThreadPoolDynamicCustomTest, Hessian) {
     this->testHessian();
 }
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolOpenMPLoopsTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolOpenMPLoopsTest() :
+            ThreadPoolTest(MultiThreadingType::OPENMP) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+
+        // equations evaluated in loops
+        _relatedDepCandidates = {{0, 2, 4}, {1, 3, 5}};
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolOpenMPLoopsTest, LoopTasks) {
+    this->testLoopTasks();
+}
+
+TEST_F(CppADCGThreadPoolOpenMPLoopsTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolOpenMPLoopsTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolOpenMPLoopsTest, Hessian) {
+    this->testHessian();
+}
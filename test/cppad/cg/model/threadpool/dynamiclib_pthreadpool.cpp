@@ -127,6 +127,33 @@ TEST_F(CppADCGThreadPoolStaticTest, Hessian) {
 namespace CppAD {
 namespace cg {
 
+class CppADCGThreadPoolWorkStealingTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolWorkStealingTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::WORK_STEALING;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolWorkStealingTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolWorkStealingTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolWorkStealingTest, Hessian) {
+    this->testHessian();
+}
+
+namespace CppAD {
+namespace cg {
+
 class CppADCGThreadPoolDynamicCustomTest : public ThreadPoolTest {
 public:
     explicit CppADCGThreadPoolDynamicCustomTest() :
@@ -158,3 +185,37 @@ TEST_F(CppADCGThreadPoolDynamicCustomTest, Jacobian) {
 TEST_F(CppADCGThreadPoolDynamicCustomTest, Hessian) {
     this->testHessian();
 }
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolLoopsTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolLoopsTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+
+        // equations evaluated in loops
+        _relatedDepCandidates = {{0, 2, 4}, {1, 3, 5}};
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolLoopsTest, LoopTasks) {
+    this->testLoopTasks();
+}
+
+TEST_F(CppADCGThreadPoolLoopsTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolLoopsTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolLoopsTest, Hessian) {
+    this->testHessian();
+}
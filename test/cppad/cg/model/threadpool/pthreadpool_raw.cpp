@@ -131,41 +131,35 @@ void pooldynamic_sparse_jacobian(double const* const* in, double* const* out, st
     inLocal[0] = in[0];
     inLocal[1] = &inLocal1;
 
-    ExecArgStruct* args[6];
+    ExecArgStruct args[6];
+    void* job_args[6];
     static cppadcg_thpool_function_type execute_functions[6] = {exec_func, exec_func, exec_func, exec_func, exec_func, exec_func};
-    static float avgElapsed[6] = {0, 0, 0, 0, 0, 0};
-    float elapsed[6] = {0, 0, 0, 0, 0, 0};
-    static int order[6] = {0, 1, 2, 3, 4, 5};
-    static int job2Thread[6] = {-1, -1, -1, -1, -1, -1};
-    static int lastElapsedChanged = 1;
-    unsigned int nBench = cppadcg_thpool_get_n_time_meas();
-    static unsigned int meas = 0;
-    int do_benchmark = (meas < nBench && !cppadcg_thpool_is_disabled());
+    static float sched_ref_elapsed[6] = {0, 0, 0, 0, 0, 0};
+    static int sched_order[6] = {0, 1, 2, 3, 4, 5};
+    static int sched_job2Thread[6] = {-1, -1, -1, -1, -1, -1};
+    static cppadcg_thpool_schedule schedule = {6, sched_ref_elapsed, sched_order, sched_job2Thread, 0, 1};
+    float ref_elapsed[6];
+    float elapsed[6];
+    int order[6];
+    int job2Thread[6];
+    int lastElapsedChanged;
+    int do_benchmark = cppadcg_thpool_schedule_load(&schedule, ref_elapsed, order, job2Thread, &lastElapsedChanged);
     float* elapsed_p = do_benchmark ? elapsed : NULL;
 
     for (i = 0; i < 6; ++i) {
-        args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));
-        args[i]->func = p[i];
-        args[i]->in = inLocal;
-        args[i]->out[0] = &jac[offset[i]];
-        args[i]->atomicFun = atomicFun;
+        args[i].func = p[i];
+        args[i].in = inLocal;
+        args[i].out[0] = &jac[offset[i]];
+        args[i].atomicFun = atomicFun;
+        job_args[i] = &args[i];
+        elapsed[i] = 0;
     }
 
-    cppadcg_thpool_add_jobs(execute_functions, (void**) args, avgElapsed, elapsed_p, order, job2Thread, 6, lastElapsedChanged);
+    cppadcg_thpool_add_jobs(execute_functions, job_args, ref_elapsed, elapsed_p, order, job2Thread, 6, lastElapsedChanged);
 
     cppadcg_thpool_wait();
 
-    for (i = 0; i < 6; ++i) {
-        free(args[i]);
-    }
-
-    if (do_benchmark) {
-        cppadcg_thpool_update_order(avgElapsed, meas, elapsed, order, 6);
-        meas++;
-    } else {
-        lastElapsedChanged = 0;
-    }
-
+    cppadcg_thpool_schedule_store(&schedule, elapsed_p, job2Thread);
 }
 
 }
@@ -251,4 +245,42 @@ TEST_F(PThreadPoolTest, StaticJac) {
     pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // reuse previous work group schedule
 
     ASSERT_TRUE(compareValues(jac, out0));
-}
\ No newline at end of file
+}
+
+TEST_F(PThreadPoolTest, WorkStealingJac) {
+    cppadcg_thpool_set_scheduler_strategy(SCHED_WORK_STEALING);
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun);
+
+    pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun);
+
+    ASSERT_TRUE(compareValues(jac, out0));
+}
+
+TEST_F(PThreadPoolTest, ConcurrentCallers) {
+    cppadcg_thpool_set_verbose(0);
+
+    for (enum ScheduleStrategy s : {SCHED_DYNAMIC, SCHED_WORK_STEALING}) {
+        cppadcg_thpool_set_scheduler_strategy(s);
+
+        const size_t nThreads = 4;
+        std::vector<std::vector<double>> outs(nThreads, std::vector<double>(out0.size()));
+        std::vector<std::thread> threads;
+
+        for (size_t t = 0; t < nThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                double* outT[1] = {outs[t].data()};
+                for (size_t r = 0; r < 200; ++r) {
+                    pooldynamic_sparse_jacobian(in.data(), outT, atomicFun);
+                }
+            });
+        }
+
+        for (std::thread& t : threads)
+            t.join();
+
+        for (size_t t = 0; t < nThreads; ++t) {
+            ASSERT_TRUE(compareValues(jac, outs[t]));
+        }
+    }
+}
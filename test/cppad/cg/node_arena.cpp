@@ -0,0 +1,103 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST(CppADCGNodeArenaTest, MixedNodes) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+    ASSERT_TRUE(handler.isUseNodeArena());
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+    ASSERT_GT(handler.getNodeArenaCapacity(), 0u);
+
+    size_t nodes = handler.getManagedNodesCount();
+
+    CGD y1 = sin(x[0]) * x[1];
+
+    handler.setUseNodeArena(false);
+    ASSERT_FALSE(handler.isUseNodeArena());
+    CGD y2 = cos(x[1]) + x[0];
+
+    handler.setUseNodeArena(true);
+    CGD y3 = exp(x[0]) - x[1];
+
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 6);
+
+    // nodes in the arena and in the heap
+    handler.deleteManagedNodes(nodes + 1, nodes + 5);
+    ASSERT_EQ(handler.getManagedNodesCount(), nodes + 2);
+}
+
+TEST(CppADCGNodeArenaTest, NodeArguments) {
+    using CGD = CG<double>;
+
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    CGD y1 = x[0] * x[1];
+    ASSERT_TRUE(y1.getOperationNode() != nullptr);
+    const auto& args1 = y1.getOperationNode()->getArguments();
+    ASSERT_EQ(args1.size(), 2u);
+    ASSERT_EQ(args1.capacity(), 2u);
+    ASSERT_TRUE(args1.get_allocator().getArena() != nullptr);
+
+    handler.setUseNodeArena(false);
+    CGD y2 = x[0] + x[1];
+    ASSERT_TRUE(y2.getOperationNode() != nullptr);
+    ASSERT_TRUE(y2.getOperationNode()->getArguments().get_allocator().getArena() == nullptr);
+}
+
+TEST(CppADCGNodeArenaTest, GeneratedCode) {
+    using CGD = CG<double>;
+    using ADCGD = AD<CGD>;
+
+    std::vector<ADCGD> u(2);
+    u[0] = 1;
+    u[1] = 2;
+    Independent(u);
+
+    std::vector<ADCGD> Z(2);
+    Z[0] = sin(u[0]) * u[1] + CondExpLt(u[0], u[1], u[0], u[1]);
+    Z[1] = u[1] * pow(u[0], 2) + cos(u[1]);
+
+    ADFun<CGD> f(u, Z);
+
+    auto generate = [&](bool useArena) {
+        CodeHandler<double> handler;
+        handler.setUseNodeArena(useArena);
+
+        std::vector<CGD> indVars(2);
+        handler.makeVariables(indVars);
+
+        std::vector<CGD> dep = f.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, dep, nameGen);
+
+        return code.str();
+    };
+
+    ASSERT_EQ(generate(true), generate(false));
+}
@@ -579,4 +579,52 @@ TEST_F(CppADCGPatternTest, modelWrongEqs) {
     setModel(modelWrongEqs);
     testPatternDetection(m, n, repeat, loops);
     testLibCreation("modelWrongEqs", m, n, repeat);
-}
\ No newline at end of file
+}
+
+/**
+ * @test dependents which are aliases of independents, temporaries shared by
+ *       several equations of the same iteration and an iteration with a
+ *       different equation
+ */
+std::vector<ADCGD> modelAliasSharedTmp(const std::vector<ADCGD>& x, size_t repeat) {
+    size_t m = 3;
+    size_t n = 3;
+    size_t m2 = repeat * m;
+
+    // dependent variable vector
+    std::vector<ADCGD> y(m2);
+
+    ADCGD tmp1 = cos(x[0] + 1);
+    for (size_t i = 0; i < repeat; i++) {
+        ADCGD shared = x[i * n] * x[i * n + 1];
+
+        y[i * m] = x[i * n]; // alias
+        y[i * m + 1] = sin(shared) + tmp1;
+        if (i == 3) {
+            y[i * m + 2] = exp(x[i * n + 2]);
+        } else {
+            y[i * m + 2] = x[i * n + 2] / shared;
+        }
+    }
+
+    return y;
+}
+
+TEST_F(CppADCGPatternTest, AliasSharedTmp) {
+    size_t m = 3;
+    size_t n = 3;
+    size_t repeat = 8;
+
+    std::vector<std::vector<std::set<size_t> > > loops(1);
+    loops[0].resize(3);
+    for (size_t i = 0; i < repeat; i++) {
+        loops[0][0].insert(i * m);
+        loops[0][1].insert(i * m + 1);
+        if (i != 3)
+            loops[0][2].insert(i * m + 2);
+    }
+
+    setModel(modelAliasSharedTmp);
+    testPatternDetection(m, n, repeat, loops);
+    testLibCreation("modelAliasSharedTmp", m, n, repeat);
+}
@@ -30,13 +30,15 @@ public:
 
     void testModel(ADFun<CGD>& f,
                    size_t expectedTmp,
-                   size_t expectedArraySize) {
+                   size_t expectedArraySize,
+                   bool minimizeLiveVariables = false) {
         using CppAD::vector;
 
         size_t n = f.Domain();
         //size_t m = f.Range();
 
         CodeHandler<double> handler(10 + n * n);
+        handler.setMinimizeLiveVariables(minimizeLiveVariables);
 
         vector<CGD> indVars(n);
         handler.makeVariables(indVars);
@@ -50,6 +52,7 @@ public:
 
         ASSERT_EQ(handler.getTemporaryVariableCount(), expectedTmp);
         ASSERT_EQ(handler.getTemporaryArraySize(), expectedArraySize);
+        ASSERT_EQ(handler.getMaxLiveTemporaryVariables(), expectedTmp);
     }
 };
 
@@ -148,3 +151,25 @@ TEST_F(CppADCGTempTest, Temporary3) {
     ADFun<CGD> f(ind, dep);
     testModel(f, 1, 0);
 }
+
+TEST_F(CppADCGTempTest, MinimizeLiveVariables) {
+    size_t n = 3;
+    size_t m = 2;
+
+    std::vector<ADCGD> u(n); // independent variable vector
+    Independent(u);
+
+    std::vector<ADCGD> Z(m); // dependent variable vector
+
+    // model
+    ADCGD a = sin(u[0]); // evaluated first by default while it is only needed later
+    ADCGD b1 = cos(u[1]);
+    ADCGD b2 = exp(u[2]);
+    ADCGD b = b1 * b1 + b2 * b2; // requires 2 temporary variables
+    Z[0] = a * a + b;
+    Z[1] = b * 2.0;
+
+    ADFun<CGD> f(u, Z);
+    testModel(f, 3, 0);
+    testModel(f, 2, 0, true);
+}